@@ -26,6 +26,8 @@
 #include "gui_controller.h"
 #include "pascha/pascha_calculator_model.h"
 
+#include <iostream>
+
 wxIMPLEMENT_APP(pascha::App);
 
 namespace pascha
@@ -33,8 +35,14 @@ namespace pascha
 
 bool App::OnInit()
 {
+  m_cache = openResultCache();
   m_model = std::make_unique<PaschaCalculatorModel>();
-  m_controller = std::make_unique<GuiController>(*m_model);
+  // Calculations run in the background; deliver their results to the views on
+  // the UI thread.
+  m_model->setDispatcher([](std::function<void()> function) {
+    if (wxTheApp) { wxTheApp->CallAfter(std::move(function)); }
+  });
+  m_controller = std::make_unique<GuiController>(*m_model, m_cache.get());
   m_view = makeView();
   m_view->createView();
 
@@ -66,4 +74,18 @@ wxGuiView* App::makeView()
                        date_separator};
 } // App::makeView()
 
+std::unique_ptr<ResultCache> App::openResultCache()
+{
+  wxFileName cache_file{cacheFile()};
+  if (!cache_file.IsOk()) { return nullptr; }
+
+  try {
+    return std::make_unique<ResultCache>(
+        std::filesystem::path{cache_file.GetFullPath().ToStdWstring()});
+  } catch (const std::exception& e) {
+    std::cerr << "Error opening result cache: " << e.what();
+    return nullptr;
+  }
+} // App::openResultCache()
+
 } // namespace pascha
@@ -25,6 +25,8 @@
 
 #include "wxGuiView.h"
 
+#include "pascha/result_cache.h"
+
 #include "wx/wx.h"
 
 #include <memory>
@@ -39,11 +41,13 @@ class App : public wxApp
   virtual bool OnInit();
 
  private:
+  std::unique_ptr<ResultCache> m_cache{};
   wxGuiView* m_view{};
   std::unique_ptr<ICalculatorModel> m_model{};
   std::unique_ptr<IController> m_controller{};
 
   wxGuiView* makeView();
+  std::unique_ptr<ResultCache> openResultCache();
 }; // class App
 
 } // namespace pascha
@@ -41,6 +41,28 @@ void processLine(Configuration& config, wxString line)
   }
 } // processLine()
 
+// Resolve the user config directory, creating it if necessary. Returns an
+// empty string on failure.
+wxString configDirectory()
+{
+  wxString config_file_path{wxStandardPaths::Get().GetUserConfigDir()};
+  config_file_path += wxFileName::GetPathSeparator();
+
+  // If path starts with /home/username, then it is a Linux path
+  if (config_file_path.StartsWith("/home/")) { config_file_path += ".config/"; }
+
+  if (!wxFileName::DirExists(config_file_path)) {
+    try {
+      wxFileName::Mkdir(config_file_path, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    } catch (...) {
+      std::cerr << "Error creating config directory: " + config_file_path;
+      return wxString{};
+    }
+  }
+
+  return config_file_path;
+} // configDirectory()
+
 } // anonymous namespace
 
 namespace pascha
@@ -48,23 +70,14 @@ namespace pascha
 
 wxFileName configFile()
 {
-  wxString config_file_path{wxStandardPaths::Get().GetUserConfigDir()};
-  config_file_path += wxFileName::GetPathSeparator();
-
-  // If path starts with /home/username, then it is a Linux path
-  if (config_file_path.StartsWith("/home/")) { config_file_path += ".config/"; }
+  wxString config_file_path{configDirectory()};
+  if (config_file_path.empty()) { return wxFileName{}; }
 
   wxString config_full_path{config_file_path + config_file_name};
 
   wxTextFile file{config_full_path};
 
   if (!file.Exists()) {
-    try {
-      wxFileName::Mkdir(config_file_path, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
-    } catch (...) {
-      std::cerr << "Error creating config directory: " + config_full_path;
-      return wxFileName{};
-    }
     if (!file.Create()) {
       std::cerr << "Error creating config file: " + config_full_path;
       return wxFileName{};
@@ -76,6 +89,15 @@ wxFileName configFile()
   return wxFileName{config_full_path};
 } // configFile()
 
+wxFileName cacheFile()
+{
+  wxString cache_file_path{configDirectory()};
+  if (cache_file_path.empty()) { return wxFileName{}; }
+
+  // The cache itself is created on first use.
+  return wxFileName{cache_file_path + cache_file_name};
+} // cacheFile()
+
 Configuration readConfigFile()
 {
   Configuration config{};
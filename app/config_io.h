@@ -35,8 +35,11 @@ struct Configuration
 }; // struct Configuration
 
 const wxString config_file_name{"pascha-gui.conf"};
+const wxString cache_file_name{"pascha-gui.cache"};
 
 wxFileName configFile();
+// The result cache lives beside the config file.
+wxFileName cacheFile();
 Configuration readConfigFile();
 
 } // namespace pascha
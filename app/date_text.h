@@ -0,0 +1,93 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_DATE_TEXT_H
+#define PASCHA_DATE_TEXT_H
+
+#include "pascha/date.h"
+#include "pascha/date_format.h"
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+
+namespace pascha
+{
+
+// A date rendered into a buffer of its own, so that displaying a date does not
+// allocate. The format string is compiled, and only the order of the fields is
+// chosen at run time. Text beyond the capacity (only possible with a very long
+// separator) is truncated.
+class DateText
+{
+ public:
+  static constexpr std::size_t kCapacity{64};
+
+  DateText(const Date& date, DateFormat format, std::string_view separator);
+
+  const char* data() const { return m_buffer; }
+  std::size_t size() const { return m_size; }
+  std::string_view view() const { return {m_buffer, m_size}; }
+
+ private:
+  char m_buffer[kCapacity];
+  std::size_t m_size{};
+}; // class DateText
+
+inline DateText::DateText(const Date& date, DateFormat format,
+                          std::string_view separator)
+{
+  // The widest each field can be, including its sign.
+  constexpr std::size_t max_fields{
+      std::numeric_limits<Year>::digits10 + 2 +
+      2 * (std::numeric_limits<Month>::digits10 + 2)};
+
+  const auto render{[&](const auto& first, const auto& second,
+                        const auto& third) {
+    constexpr auto spec{FMT_COMPILE("{}{}{}{}{}")};
+    if (max_fields + 2 * separator.size() <= kCapacity) {
+      // Writing straight to the buffer is much faster than format_to_n.
+      char* end{fmt::format_to(m_buffer, spec, first, separator, second,
+                               separator, third)};
+      m_size = static_cast<std::size_t>(end - m_buffer);
+    } else {
+      auto result{fmt::format_to_n(m_buffer, kCapacity, spec, first,
+                                   separator, second, separator, third)};
+      m_size = std::min(result.size, kCapacity);
+    }
+  }};
+
+  switch (format) {
+    case DateFormat::MDY: render(date.month, date.day, date.year); break;
+    case DateFormat::DMY: render(date.day, date.month, date.year); break;
+    case DateFormat::YMD:
+    default: render(date.year, date.month, date.day); break;
+  }
+} // DateText::DateText
+
+} // namespace pascha
+
+#endif // !PASCHA_DATE_TEXT_H
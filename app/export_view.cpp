@@ -0,0 +1,192 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "export_view.h"
+
+#include "pascha/export.h"
+#include "pascha/feasts.h"
+
+#include <fmt/core.h>
+#include <wx/wrapsizer.h>
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace pascha
+{
+
+wxExportView::wxExportView(wxWindow* parent, const CalculationOptions& options,
+                           DateFormat date_format,
+                           std::string_view date_separator)
+    : wxFrame{parent, wxID_ANY, "Export", wxDefaultPosition, wxSize(450, 450)},
+      m_options{options},
+      m_date_format{date_format},
+      m_date_separator{date_separator}
+{
+  wxBoxSizer* main_sizer = new wxBoxSizer(wxVERTICAL);
+
+  wxWrapSizer* range_sizer = new wxWrapSizer(wxHORIZONTAL);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "From:"), 0, wxALL, 5);
+  m_first_year_text = new wxTextCtrl(this, wxID_ANY, "1");
+  range_sizer->Add(m_first_year_text, 0, wxALL, 5);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "To:"), 0, wxALL, 5);
+  m_last_year_text = new wxTextCtrl(this, wxID_ANY, "3000");
+  range_sizer->Add(m_last_year_text, 0, wxALL, 5);
+  main_sizer->Add(range_sizer, 0, wxALL | wxEXPAND, 5);
+
+  wxArrayString formats{};
+  formats.Add("CSV");
+  formats.Add("JSON Lines");
+  m_format_box = new wxRadioBox(this, wxID_ANY, "Format", wxDefaultPosition,
+                                wxDefaultSize, formats);
+  main_sizer->Add(m_format_box, 0, wxALL | wxEXPAND, 5);
+
+  wxArrayString feast_names{};
+  for (const Feast& feast : kFeasts) {
+    feast_names.Add(std::string{feast.name});
+  }
+  m_feasts_list = new wxCheckListBox(this, wxID_ANY, wxDefaultPosition,
+                                     wxDefaultSize, feast_names);
+  m_feasts_list->Check(0);
+  main_sizer->Add(m_feasts_list, 1, wxALL | wxEXPAND, 5);
+
+  m_progress_gauge = new wxGauge(this, wxID_ANY, 1000);
+  main_sizer->Add(m_progress_gauge, 0, wxALL | wxEXPAND, 5);
+  m_status_text = new wxStaticText(this, wxID_ANY, "");
+  main_sizer->Add(m_status_text, 0, wxALL | wxEXPAND, 5);
+
+  wxBoxSizer* button_sizer = new wxBoxSizer(wxHORIZONTAL);
+  m_export_button = new wxButton(this, id_export_button, "Export...");
+  button_sizer->Add(m_export_button, 0, wxALL, 5);
+  m_cancel_button = new wxButton(this, id_cancel_button, "Cancel");
+  m_cancel_button->Disable();
+  button_sizer->Add(m_cancel_button, 0, wxALL, 5);
+  main_sizer->Add(button_sizer, 0, wxALL, 5);
+
+  this->SetSizer(main_sizer);
+  main_sizer->Layout();
+} // wxExportView::wxExportView()
+
+wxExportView::~wxExportView()
+{
+  m_cancellation.cancel();
+} // wxExportView::~wxExportView()
+
+void wxExportView::onExportClicked(wxCommandEvent& evt)
+{
+  evt.Skip();
+  Year first{};
+  Year last{};
+  try {
+    first = std::stoll(std::string(m_first_year_text->GetValue()));
+    last = std::stoll(std::string(m_last_year_text->GetValue()));
+  } catch (std::exception& e) {
+    wxMessageDialog dialog(this, "Invalid year", "Error", wxOK | wxICON_ERROR);
+    dialog.ShowModal();
+    return;
+  }
+
+  ExportOptions options{};
+  options.calculation = m_options;
+  options.calculation.target_outputs.clear();
+  for (unsigned int i = 0; i < kFeasts.size(); ++i) {
+    if (m_feasts_list->IsChecked(i)) {
+      options.calculation.target_outputs.push_back(kFeasts[i].target);
+    }
+  }
+  options.format = m_format_box->GetSelection() == 1 ? ExportFormat::jsonLines
+                                                     : ExportFormat::csv;
+  options.date_format = m_date_format;
+  options.date_separator = m_date_separator;
+
+  const bool json{options.format == ExportFormat::jsonLines};
+  wxFileDialog file_dialog{this,
+                           "Export",
+                           "",
+                           json ? "pascha.jsonl" : "pascha.csv",
+                           json ? "JSON Lines (*.jsonl)|*.jsonl"
+                                : "CSV (*.csv)|*.csv",
+                           wxFD_SAVE | wxFD_OVERWRITE_PROMPT};
+  if (file_dialog.ShowModal() != wxID_OK) { return; }
+  std::string path{file_dialog.GetPath().ToStdString()};
+
+  m_cancellation = CancellationToken{};
+  RangeControl control{};
+  control.cancellation = &m_cancellation;
+  control.progress = [this](const Progress& progress) {
+    CallAfter([this, progress] { showProgress(progress); });
+  };
+
+  m_export_button->Disable();
+  m_cancel_button->Enable();
+  m_progress_gauge->SetValue(0);
+  m_status_text->SetLabel("Exporting...");
+  m_executor.submit([this, options, first, last, path, control] {
+    std::string message{};
+    try {
+      std::ofstream file{path, std::ios::binary};
+      if (!file) { throw std::runtime_error{"Cannot open " + path}; }
+      exportRange(options, first, last, file, control);
+      // The number of years may not fit in a Year.
+      const std::uint64_t years{static_cast<std::uint64_t>(last) -
+                                static_cast<std::uint64_t>(first) + 1};
+      message = fmt::format("Exported {} years to {}", years, path);
+    } catch (const OperationCancelled&) {
+      message = "Export cancelled";
+    } catch (const std::exception& e) {
+      message = e.what();
+    }
+    CallAfter([this, message] { finished(message); });
+  });
+} // wxExportView::onExportClicked(wxCommandEvent&)
+
+void wxExportView::onCancelClicked(wxCommandEvent& evt)
+{
+  m_cancellation.cancel();
+  evt.Skip();
+} // wxExportView::onCancelClicked(wxCommandEvent&)
+
+void wxExportView::showProgress(const Progress& progress)
+{
+  m_progress_gauge->SetValue(static_cast<int>(progress.fraction() * 1000));
+  m_status_text->SetLabel(
+      fmt::format("{} of {} years ({:.0f} s remaining)", progress.years_done,
+                  progress.years_total, progress.eta.count()));
+} // wxExportView::showProgress
+
+void wxExportView::finished(const std::string& message)
+{
+  m_export_button->Enable();
+  m_cancel_button->Disable();
+  m_status_text->SetLabel(message);
+  GetSizer()->Layout();
+} // wxExportView::finished
+
+} // namespace pascha
+
+wxBEGIN_EVENT_TABLE(pascha::wxExportView, wxFrame)
+  EVT_BUTTON(id_export_button, pascha::wxExportView::onExportClicked)
+  EVT_BUTTON(id_cancel_button, pascha::wxExportView::onCancelClicked)
+wxEND_EVENT_TABLE()
@@ -0,0 +1,89 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_EXPORT_VIEW_H
+#define PASCHA_EXPORT_VIEW_H
+
+#include "pascha/calculation_options.h"
+#include "pascha/cancellation.h"
+#include "pascha/date_format.h"
+#include "pascha/executor.h"
+#include "pascha/progress.h"
+
+#include <wx/gauge.h>
+#include <wx/wx.h>
+
+#include <string>
+#include <string_view>
+
+namespace pascha
+{
+
+// A window exporting the dates of Pascha and the chosen feasts over a range of
+// years to a CSV or JSON Lines file, using the calculation options and date
+// settings of the main view. The export runs in the background.
+class wxExportView : public wxFrame
+{
+ public:
+  wxExportView(wxWindow* parent, const CalculationOptions& options,
+               DateFormat date_format, std::string_view date_separator);
+  // Cancels any running export, so that closing the window does not wait
+  // for it to finish.
+  ~wxExportView();
+
+  // GUI Components
+  wxTextCtrl* m_first_year_text{};
+  wxTextCtrl* m_last_year_text{};
+  wxRadioBox* m_format_box{};
+  wxCheckListBox* m_feasts_list{};
+  wxGauge* m_progress_gauge{};
+  wxStaticText* m_status_text{};
+  wxButton* m_export_button{};
+  wxButton* m_cancel_button{};
+
+  // GUI callbacks
+  void onExportClicked(wxCommandEvent& evt);
+  void onCancelClicked(wxCommandEvent& evt);
+
+  wxDECLARE_EVENT_TABLE();
+
+  enum
+  {
+    id_export_button = wxID_HIGHEST + 1,
+    id_cancel_button,
+  };
+
+ private:
+  CalculationOptions m_options{};
+  DateFormat m_date_format{};
+  std::string m_date_separator{};
+  CancellationToken m_cancellation{};
+  // Declared last, so that it is destroyed, finishing the running export,
+  // before anything the export uses.
+  SerialExecutor m_executor{};
+
+  void showProgress(const Progress& progress);
+  void finished(const std::string& message);
+}; // class wxExportView
+
+} // namespace pascha
+#endif // !PASCHA_EXPORT_VIEW_H
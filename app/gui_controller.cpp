@@ -20,140 +20,182 @@
 
 #include "gui_controller.h"
 
+#include "pascha/cached_calculation_method.h"
 #include "pascha/calculation_methods.h"
-#include "pascha/output_calendars.h"
-#include "pascha/output_options.h"
-#include "pascha/target_dates.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/method_factory.h"
+
+namespace
+{
+
+using namespace pascha;
+
+// Pascha in the Gregorian calendar, from which the days until and weeks
+// between targets are counted.
+CalculationOptions paschaOptions(ECalculationMethod calculation_method)
+{
+  return CalculationOptions{calculation_method,
+                            {e_target_output::daysUntil},
+                            e_output_calendar::gregorian,
+                            {},
+                            0};
+} // paschaOptions
+
+} // anonymous namespace
 
 namespace pascha
 {
 
-GuiController::GuiController(ICalculatorModel& model)
-    : m_model{&model} {} // GuiController::GuiController
+GuiController::GuiController(ICalculatorModel& model, ResultCache* cache)
+    : m_model{&model}, m_cache{cache} {} // GuiController::GuiController
 
 void GuiController::calculate(const CalculationOptions& options) const
 {
   using namespace std::literals; // for sv
 
+  Clock::time_point requested{Clock::now()};
+
   // Ensure the year is valid before continuing.
   if (!validateYear(options.year)) {
     m_model->notify("Invalid year"sv);
     return;
   }
 
-  // Check if we are calculating weeks between two methods, before creating the
-  // method object.
-  // If so, perform the calculation and return.
+  // Keep the neighbouring years ready, for scrubbing through them.
+  speculate(options);
+
+  // Serve the result from the precomputed dates if possible, superseding
+  // anything still being calculated.
+  if (notifyPrecomputed(options)) {
+    m_pending.reset();
+    m_job.cancel();
+    m_latency.record(Clock::now() - requested);
+    return;
+  }
+
+  // A new request supersedes both the running job and any earlier request
+  // still waiting for it.
+  if (m_running) {
+    m_job.cancel();
+    m_pending = options;
+    m_pending_since = requested;
+    return;
+  }
+
+  run(options, requested);
+} // GuiController::calculate
+
+void GuiController::run(const CalculationOptions& options,
+                        Clock::time_point requested) const
+{
+  Completion completion{[this, requested] { finished(requested); }};
+  m_running = true;
+
+  // Weeks between compares two methods, rather than calculating a date.
   if (options.target_outputs.front() == e_target_output::weeksBetween) {
     std::unique_ptr<ICalculationMethod> julian_method{
         new JulianCalculationMethod{}};
     std::unique_ptr<ICalculationMethod> gregorian_method{
         new GregorianCalculationMethod{}};
-    m_model->weeksBetween(options.year, std::move(julian_method),
-                          std::move(gregorian_method));
+    m_job = m_model->weeksBetweenAsync(options.year, std::move(julian_method),
+                                       std::move(gregorian_method),
+                                       std::move(completion));
     return;
   }
 
-  std::unique_ptr<ICalculationMethod> method{nullptr};
+  std::unique_ptr<ICalculationMethod> method{makeCalculationMethod(options)};
+  if (options.target_outputs.front() == e_target_output::daysUntil) {
+    m_model->setCalculationMethod(std::move(method));
+    m_job = m_model->daysUntilAsync(options.year, std::move(completion));
+    return;
+  }
 
-  // 1. get the calculation method from the options.
-  // Default to Julian.
-  switch (options.calculation_method) {
-    case e_calculation_method::gregorian: {
-      method =
-          std::unique_ptr<ICalculationMethod>{new GregorianCalculationMethod{}};
-      break;
-    }
-    default: {
-      method =
-          std::unique_ptr<ICalculationMethod>{new JulianCalculationMethod{}};
-      break;
-    }
+  // Serve the fully decorated method from the cache, if there is one.
+  if (m_cache) {
+    method = std::unique_ptr<ICalculationMethod>{new CachedCalculationMethod{
+        std::move(method), *m_cache, packOptions(options)}};
   }
 
-  // 2. Get the target date from the options.
-  // Default to Pascha.
+  m_model->setCalculationMethod(std::move(method));
+  m_job = m_model->calculateAsync(options.year, std::move(completion));
+} // GuiController::run
+
+bool GuiController::notifyPrecomputed(const CalculationOptions& options) const
+{
   switch (options.target_outputs.front()) {
-    case e_target_output::daysUntil: {
-      m_model->setCalculationMethod(std::move(method));
-      m_model->daysUntil(options.year);
-      return;
-    }
-    case e_target_output::meatfare: {
-      method =
-          std::unique_ptr<ICalculationMethod>{new Meatfare{std::move(method)}};
-      break;
-    }
-    case e_target_output::cheesefare: {
-      method = std::unique_ptr<ICalculationMethod>{
-          new Cheesefare{std::move(method)}};
-      break;
+    case e_target_output::weeksBetween: {
+      auto julian{m_precomputed.find(
+          packOptions(paschaOptions(e_calculation_method::julian)),
+          options.year)};
+      auto gregorian{m_precomputed.find(
+          packOptions(paschaOptions(e_calculation_method::gregorian)),
+          options.year)};
+      if (!julian || !gregorian) { return false; }
+      m_model->notify(
+          Weeks{(gregorianToJdn(*julian) - gregorianToJdn(*gregorian)) / 7});
+      return true;
     }
-    case e_target_output::ashWednesday: {
-      method = std::unique_ptr<ICalculationMethod>{
-          new AshWednesday{std::move(method)}};
-      break;
-    }
-    case e_target_output::midfeastPentecost: {
-      method = std::unique_ptr<ICalculationMethod>{
-          new MidfeastPentecost{std::move(method)}};
-      break;
-    }
-    case e_target_output::leavetakingPascha: {
-      method = std::unique_ptr<ICalculationMethod>{
-          new LeavetakingPascha{std::move(method)}};
-      break;
-    }
-    case e_target_output::ascension: {
-      method =
-          std::unique_ptr<ICalculationMethod>{new Ascension{std::move(method)}};
-      break;
-    }
-    case e_target_output::pentecost: {
-      method =
-          std::unique_ptr<ICalculationMethod>{new Pentecost{std::move(method)}};
-      break;
+    case e_target_output::daysUntil: {
+      auto pascha{m_precomputed.find(
+          packOptions(paschaOptions(options.calculation_method)),
+          options.year)};
+      if (!pascha) { return false; }
+      m_model->notify(Days{gregorianToJdn(*pascha) - m_model->clock().todayJdn()});
+      return true;
     }
     default: {
-      // Pascha is calculated by default already.
-      break;
+      auto date{m_precomputed.find(packOptions(options), options.year)};
+      if (!date) { return false; }
+      m_model->notify(*date);
+      return true;
     }
   }
+} // GuiController::notifyPrecomputed
 
-  // 3. Set the output calendar.
-  // Default to Julian.
-  switch (options.output_calendar) {
-    case e_output_calendar::gregorian: {
-      // Gregorian is used by default for calculations.
-      break;
-    }
-    case e_output_calendar::rev_julian: {
-      method = std::unique_ptr<ICalculationMethod>{
-          new RevisedJulianOutputCalendar{std::move(method)}};
-      break;
+void GuiController::speculate(const CalculationOptions& options) const
+{
+  // Every date target in every output calendar, with the current method and
+  // options, plus Pascha for both methods for weeks between and days until.
+  std::vector<CalculationOptions> variants{};
+  for (ETargetOutput target = 0; target < e_target_output::last; ++target) {
+    if (target == e_target_output::daysUntil ||
+        target == e_target_output::weeksBetween) {
+      continue;
     }
-    default: { // Julian
-      method = std::unique_ptr<ICalculationMethod>{
-          new JulianOutputCalendar{std::move(method)}};
-      break;
+    for (EOutputCalendar calendar = 0; calendar < e_output_calendar::last;
+         ++calendar) {
+      variants.push_back(CalculationOptions{options.calculation_method,
+                                            {target},
+                                            calendar,
+                                            options.options,
+                                            options.year});
     }
   }
+  variants.push_back(paschaOptions(e_calculation_method::julian));
+  variants.push_back(paschaOptions(e_calculation_method::gregorian));
 
-  // 4. Apply the options.
-  for (auto option : options.options) {
-    switch (option) {
-      case (e_output_option::byzantine): {
-        method = std::unique_ptr<ICalculationMethod>{
-            new ByzantineDate{std::move(method)}};
-        break;
-      }
-    }
+  m_precomputed.recentre(variants, options.year);
+} // GuiController::speculate
+
+void GuiController::finished(Clock::time_point requested) const
+{
+  m_running = false;
+  if (!m_job.cancelled()) { m_latency.record(Clock::now() - requested); }
+
+  if (m_pending) {
+    CalculationOptions options{std::move(*m_pending)};
+    m_pending.reset();
+    run(options, m_pending_since);
   }
+} // GuiController::finished
 
-  // 5. Set the calculation method and calculate.
-  m_model->setCalculationMethod(std::move(method));
-  m_model->calculate(options.year);
-} // GuiController::calculate
+bool GuiController::cancel()
+{
+  const bool running{m_running && !m_job.cancelled()};
+  m_pending.reset();
+  m_job.cancel();
+  return running;
+} // GuiController::cancel
 
 void GuiController::addView(IView& view)
 {
@@ -170,6 +212,11 @@ void GuiController::start()
   for (auto* view : m_views) { view->createView(); }
 } // GuiController::start
 
+const LatencyHistogram& GuiController::latency() const
+{
+  return m_latency;
+} // GuiController::latency
+
 bool GuiController::validateYear(const Year& year) const
 {
   // TODO: add year validation
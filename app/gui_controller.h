@@ -22,27 +22,66 @@
 #define PASCHA_GUI_CONTROLLER_H
 
 #include "pascha/i_controller.h"
+#include "pascha/latency_histogram.h"
+#include "pascha/precompute_cache.h"
+#include "pascha/result_cache.h"
+
+#include <chrono>
+#include <optional>
+
 namespace pascha
 {
 
+// Runs one calculation at a time. Requests made while one is running are
+// coalesced: the running calculation is cancelled and only the latest request
+// is started once it has finished, so bursts of UI events never queue up stale
+// work. Completions must be delivered on the thread which calls calculate(),
+// i.e. the model needs a dispatcher to the UI thread.
+//
+// The dates around each requested year are also precomputed in the
+// background, for every target and output calendar, so that stepping to a
+// neighbouring year is answered immediately without calculating.
 class GuiController : public IController
 {
  public:
-  GuiController(ICalculatorModel& model);
+  using Clock = std::chrono::steady_clock;
+
+  // Calculated dates are served from and added to the cache, if given.
+  GuiController(ICalculatorModel& model, ResultCache* cache = nullptr);
   GuiController(const GuiController&) = delete;
   GuiController(GuiController&&) = delete;
   GuiController& operator=(const GuiController&) = delete;
   GuiController& operator=(GuiController&&) = delete;
   virtual ~GuiController() = default;
   virtual void calculate(const CalculationOptions& options) const override;
+  virtual bool cancel() override;
   virtual void addView(IView&) override;
   virtual void removeView(IView&) override;
   virtual void start() override;
+  virtual const LatencyHistogram& latency() const override;
 
  private:
   ICalculatorModel* m_model{};
+  ResultCache* m_cache{};
   std::vector<IView*> m_views{};
+  // The running job, if any.
+  mutable JobHandle m_job{};
+  mutable bool m_running{false};
+  // The latest request made while a job was running, and when it was made.
+  mutable std::optional<CalculationOptions> m_pending{};
+  mutable Clock::time_point m_pending_since{};
+  // Time from request to the result being shown, for completed requests.
+  mutable LatencyHistogram m_latency{};
+  mutable PrecomputeCache m_precomputed{};
+
   bool validateYear(const Year& year) const;
+  // Build the calculation method for the options and submit the job.
+  void run(const CalculationOptions& options,
+           Clock::time_point requested) const;
+  void finished(Clock::time_point requested) const;
+  // Notify the result from the precomputed dates, if they have it.
+  bool notifyPrecomputed(const CalculationOptions& options) const;
+  void speculate(const CalculationOptions& options) const;
 }; // class GuiController
 
 } // namespace pascha
@@ -0,0 +1,204 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "statistics_view.h"
+
+#include <fmt/core.h>
+#include <wx/dcbuffer.h>
+#include <wx/wrapsizer.h>
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+
+const char* const kMonthNames[12]{"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+HistogramPanel::HistogramPanel(wxWindow* parent)
+    : wxPanel{parent, wxID_ANY, wxDefaultPosition, wxSize(600, 250)}
+{
+  SetBackgroundStyle(wxBG_STYLE_PAINT);
+  Bind(wxEVT_PAINT, &HistogramPanel::onPaint, this);
+} // HistogramPanel::HistogramPanel
+
+void HistogramPanel::setStatistics(
+    std::shared_ptr<const PaschaStatistics> statistics)
+{
+  m_statistics = std::move(statistics);
+  Refresh();
+} // HistogramPanel::setStatistics
+
+void HistogramPanel::onPaint(wxPaintEvent&)
+{
+  wxAutoBufferedPaintDC dc{this};
+  dc.SetBackground(*wxWHITE_BRUSH);
+  dc.Clear();
+  if (!m_statistics || m_statistics->years == 0) { return; }
+
+  // Only the days from the first to the last with any dates are drawn.
+  int first{-1};
+  int last{-1};
+  std::uint64_t highest{0};
+  for (int index = 0; index < 12 * 31; ++index) {
+    std::uint64_t count{m_statistics->by_day[index / 31][index % 31]};
+    if (count == 0) { continue; }
+    if (first < 0) { first = index; }
+    last = index;
+    highest = std::max(highest, count);
+  }
+  if (first < 0) { return; }
+
+  wxSize size{GetClientSize()};
+  constexpr int kMargin{20};
+  int days{last - first + 1};
+  double bar_width{static_cast<double>(size.x - 2 * kMargin) / days};
+  int chart_height{size.y - 2 * kMargin};
+
+  dc.SetBrush(*wxBLUE_BRUSH);
+  dc.SetPen(*wxTRANSPARENT_PEN);
+  for (int index = first; index <= last; ++index) {
+    std::uint64_t count{m_statistics->by_day[index / 31][index % 31]};
+    int height{static_cast<int>(static_cast<double>(count) /
+                                static_cast<double>(highest) * chart_height)};
+    int x{kMargin + static_cast<int>((index - first) * bar_width)};
+    dc.DrawRectangle(x, kMargin + chart_height - height,
+                     std::max(1, static_cast<int>(bar_width) - 1), height);
+  }
+
+  // Label the first of each month, and the first day drawn.
+  dc.SetTextForeground(*wxBLACK);
+  for (int index = first; index <= last; ++index) {
+    if (index != first && index % 31 != 0) { continue; }
+    int x{kMargin + static_cast<int>((index - first) * bar_width)};
+    dc.DrawText(fmt::format("{} {}", kMonthNames[index / 31], index % 31 + 1),
+                x, size.y - kMargin);
+  }
+} // HistogramPanel::onPaint
+
+wxStatisticsView::wxStatisticsView(
+    wxWindow* parent, const CalculationOptions& options,
+    std::shared_ptr<StatisticsCalculator> calculator,
+    std::string_view pascha_name)
+    : wxFrame{parent, wxID_ANY, std::string{pascha_name} + " Statistics",
+              wxDefaultPosition, wxSize(700, 450)},
+      m_options{options},
+      m_pascha_name{pascha_name},
+      m_calculator{std::move(calculator)}
+{
+  wxBoxSizer* main_sizer = new wxBoxSizer(wxVERTICAL);
+
+  wxWrapSizer* range_sizer = new wxWrapSizer(wxHORIZONTAL);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "From:"), 0, wxALL, 5);
+  m_first_year_text = new wxTextCtrl(this, wxID_ANY, "1");
+  range_sizer->Add(m_first_year_text, 0, wxALL, 5);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "To:"), 0, wxALL, 5);
+  m_last_year_text = new wxTextCtrl(this, wxID_ANY, "1000000");
+  range_sizer->Add(m_last_year_text, 0, wxALL, 5);
+  m_calculate_button = new wxButton(this, id_calculate_button, "Calculate");
+  range_sizer->Add(m_calculate_button, 0, wxALL, 5);
+  main_sizer->Add(range_sizer, 0, wxALL | wxEXPAND, 5);
+
+  m_summary_text = new wxStaticText(this, wxID_ANY, "");
+  main_sizer->Add(m_summary_text, 0, wxALL | wxEXPAND, 5);
+  m_histogram = new HistogramPanel(this);
+  main_sizer->Add(m_histogram, 1, wxALL | wxEXPAND, 5);
+
+  this->SetSizer(main_sizer);
+  main_sizer->Layout();
+} // wxStatisticsView::wxStatisticsView()
+
+wxStatisticsView::~wxStatisticsView()
+{
+  m_cancellation.cancel();
+} // wxStatisticsView::~wxStatisticsView()
+
+void wxStatisticsView::onCalculateClicked(wxCommandEvent& evt)
+{
+  Year first{};
+  Year last{};
+  try {
+    first = std::stoll(std::string(m_first_year_text->GetValue()));
+    last = std::stoll(std::string(m_last_year_text->GetValue()));
+  } catch (std::exception& e) {
+    wxMessageDialog dialog(this, "Invalid year", "Error", wxOK | wxICON_ERROR);
+    dialog.ShowModal();
+    evt.Skip();
+    return;
+  }
+
+  m_cancellation = CancellationToken{};
+  RangeControl control{};
+  control.cancellation = &m_cancellation;
+
+  m_calculate_button->Disable();
+  m_summary_text->SetLabel("Calculating...");
+  m_executor.submit([this, first, last, control] {
+    try {
+      auto statistics{
+          m_calculator->calculate(m_options, first, last, control)};
+      CallAfter([this, statistics] { showStatistics(statistics); });
+    } catch (const std::exception& e) {
+      CallAfter([this, message = std::string{e.what()}] {
+        m_calculate_button->Enable();
+        m_summary_text->SetLabel(message);
+      });
+    }
+  });
+  evt.Skip();
+} // wxStatisticsView::onCalculateClicked(wxCommandEvent&)
+
+void wxStatisticsView::showStatistics(
+    std::shared_ptr<const PaschaStatistics> statistics)
+{
+  m_calculate_button->Enable();
+
+  std::string months{};
+  for (std::size_t month = 0; month < 12; ++month) {
+    if (statistics->by_month[month] == 0) { continue; }
+    months += fmt::format("{}: {:.2f}%  ", kMonthNames[month],
+                          100.0 * static_cast<double>(
+                                      statistics->by_month[month]) /
+                              static_cast<double>(statistics->years));
+  }
+  m_summary_text->SetLabel(fmt::format(
+      "Years: {} ({} skipped)\n{}\n"
+      "Julian and Gregorian {} coincide in {:.2f}% of years; "
+      "mean weeks between: {:.2f}",
+      statistics->years, statistics->skipped, months, m_pascha_name,
+      100.0 * statistics->coincidenceRate(),
+      statistics->meanWeeksBetween()));
+  m_histogram->setStatistics(std::move(statistics));
+  GetSizer()->Layout();
+} // wxStatisticsView::showStatistics
+
+} // namespace pascha
+
+wxBEGIN_EVENT_TABLE(pascha::wxStatisticsView, wxFrame)
+  EVT_BUTTON(id_calculate_button, pascha::wxStatisticsView::onCalculateClicked)
+wxEND_EVENT_TABLE()
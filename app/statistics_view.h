@@ -0,0 +1,97 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_STATISTICS_VIEW_H
+#define PASCHA_STATISTICS_VIEW_H
+
+#include "pascha/calculation_options.h"
+#include "pascha/cancellation.h"
+#include "pascha/executor.h"
+#include "pascha/statistics.h"
+
+#include <wx/wx.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace pascha
+{
+
+// Draws the number of dates falling on each calendar day as a bar chart.
+class HistogramPanel : public wxPanel
+{
+ public:
+  explicit HistogramPanel(wxWindow* parent);
+
+  void setStatistics(std::shared_ptr<const PaschaStatistics> statistics);
+
+ private:
+  std::shared_ptr<const PaschaStatistics> m_statistics{};
+
+  void onPaint(wxPaintEvent& evt);
+}; // class HistogramPanel
+
+// A window showing the distribution of dates over a range of years, using the
+// options of the main view, and how the Julian and Gregorian dates of Pascha
+// compare over it. Statistics are calculated in the background.
+class wxStatisticsView : public wxFrame
+{
+ public:
+  wxStatisticsView(wxWindow* parent, const CalculationOptions& options,
+                   std::shared_ptr<StatisticsCalculator> calculator,
+                   std::string_view pascha_name);
+  // Cancels any running calculation, so that closing the window does not
+  // wait for it to finish.
+  ~wxStatisticsView();
+
+  // GUI Components
+  wxTextCtrl* m_first_year_text{};
+  wxTextCtrl* m_last_year_text{};
+  wxButton* m_calculate_button{};
+  wxStaticText* m_summary_text{};
+  HistogramPanel* m_histogram{};
+
+  // GUI callbacks
+  void onCalculateClicked(wxCommandEvent& evt);
+
+  wxDECLARE_EVENT_TABLE();
+
+  enum
+  {
+    id_calculate_button = wxID_HIGHEST + 1,
+  };
+
+ private:
+  CalculationOptions m_options{};
+  std::string m_pascha_name{};
+  std::shared_ptr<StatisticsCalculator> m_calculator{};
+  CancellationToken m_cancellation{};
+  // Declared last, so that it is destroyed, finishing the running job,
+  // before anything the job uses.
+  SerialExecutor m_executor{};
+
+  void showStatistics(std::shared_ptr<const PaschaStatistics> statistics);
+}; // class wxStatisticsView
+
+} // namespace pascha
+#endif // !PASCHA_STATISTICS_VIEW_H
@@ -0,0 +1,168 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "table_view.h"
+
+#include "pascha/feasts.h"
+
+#include <wx/wrapsizer.h>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+using namespace pascha;
+
+// The moveable feasts which can be listed after Pascha, in the order of the
+// choices in the feasts list.
+static_assert(kFeasts.front().target == e_target_output::pascha);
+constexpr std::span<const Feast> kListedFeasts{std::span{kFeasts}.subspan(1)};
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+PaschalionListCtrl::PaschalionListCtrl(wxWindow* parent,
+                                       DateFormatter formatter)
+    : wxListCtrl{parent, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+                 wxLC_REPORT | wxLC_VIRTUAL | wxLC_HRULES},
+      m_formatter{std::move(formatter)}
+{
+  Bind(wxEVT_LIST_CACHE_HINT, &PaschalionListCtrl::onCacheHint, this);
+} // PaschalionListCtrl::PaschalionListCtrl
+
+void PaschalionListCtrl::setTable(std::unique_ptr<PaschalionTable> table,
+                                  const std::vector<wxString>& headings)
+{
+  m_table = std::move(table);
+  ClearAll();
+  AppendColumn("Year");
+  for (const wxString& heading : headings) { AppendColumn(heading); }
+  // The item count is a long, which may be narrower than the row count.
+  auto rows{std::min<std::uint64_t>(
+      m_table->rowCount(),
+      static_cast<std::uint64_t>(std::numeric_limits<long>::max()))};
+  SetItemCount(static_cast<long>(rows));
+  Refresh();
+} // PaschalionListCtrl::setTable
+
+wxString PaschalionListCtrl::OnGetItemText(long item, long column) const
+{
+  if (!m_table || item < 0 || column < 0) { return ""; }
+  auto row{static_cast<std::uint64_t>(item)};
+  if (column == 0) { return std::to_string(m_table->year(row)); }
+  auto date{m_table->date(row, static_cast<std::size_t>(column - 1))};
+  return date ? wxString{m_formatter(*date)} : wxString{"Out of range"};
+} // PaschalionListCtrl::OnGetItemText
+
+void PaschalionListCtrl::onCacheHint(wxListEvent& evt)
+{
+  if (m_table && evt.GetCacheFrom() >= 0) {
+    m_table->prefetch(static_cast<std::uint64_t>(evt.GetCacheFrom()),
+                      static_cast<std::uint64_t>(evt.GetCacheTo()));
+  }
+} // PaschalionListCtrl::onCacheHint
+
+wxTableView::wxTableView(wxWindow* parent, const CalculationOptions& options,
+                         DateFormatter formatter, std::string_view pascha_name)
+    : wxFrame{parent, wxID_ANY, "Paschalion", wxDefaultPosition,
+              wxSize(800, 600)},
+      m_options{options},
+      m_pascha_name{pascha_name}
+{
+  wxBoxSizer* main_sizer = new wxBoxSizer(wxVERTICAL);
+
+  wxWrapSizer* range_sizer = new wxWrapSizer(wxHORIZONTAL);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "From:"), 0, wxALL, 5);
+  m_first_year_text = new wxTextCtrl(this, wxID_ANY, "1");
+  range_sizer->Add(m_first_year_text, 0, wxALL, 5);
+  range_sizer->Add(new wxStaticText(this, wxID_ANY, "To:"), 0, wxALL, 5);
+  m_last_year_text = new wxTextCtrl(this, wxID_ANY, "10000");
+  range_sizer->Add(m_last_year_text, 0, wxALL, 5);
+  m_show_button = new wxButton(this, id_show_button, "Show");
+  range_sizer->Add(m_show_button, 0, wxALL, 5);
+  main_sizer->Add(range_sizer, 0, wxALL | wxEXPAND, 5);
+
+  wxBoxSizer* content_sizer = new wxBoxSizer(wxHORIZONTAL);
+  wxArrayString feast_names{};
+  for (const Feast& feast : kListedFeasts) {
+    feast_names.Add(std::string{feast.name});
+  }
+  m_feasts_list = new wxCheckListBox(this, wxID_ANY, wxDefaultPosition,
+                                     wxDefaultSize, feast_names);
+  content_sizer->Add(m_feasts_list, 0, wxALL | wxEXPAND, 5);
+  m_table_list = new PaschalionListCtrl(this, std::move(formatter));
+  content_sizer->Add(m_table_list, 1, wxALL | wxEXPAND, 5);
+  main_sizer->Add(content_sizer, 1, wxALL | wxEXPAND, 5);
+
+  this->SetSizer(main_sizer);
+  main_sizer->Layout();
+} // wxTableView::wxTableView()
+
+void wxTableView::onShowClicked(wxCommandEvent& evt)
+{
+  Year first{};
+  Year last{};
+  try {
+    first = std::stoll(std::string(m_first_year_text->GetValue()));
+    last = std::stoll(std::string(m_last_year_text->GetValue()));
+  } catch (std::exception& e) {
+    wxMessageDialog dialog(this, "Invalid year", "Error", wxOK | wxICON_ERROR);
+    dialog.ShowModal();
+    evt.Skip();
+    return;
+  }
+
+  std::vector<CalculationOptions> columns{};
+  std::vector<wxString> headings{};
+  CalculationOptions column{m_options};
+  column.target_outputs = {e_target_output::pascha};
+  columns.push_back(column);
+  headings.push_back(m_pascha_name);
+  for (unsigned int i = 0; i < kListedFeasts.size(); ++i) {
+    if (!m_feasts_list->IsChecked(i)) { continue; }
+    column.target_outputs = {kListedFeasts[i].target};
+    columns.push_back(column);
+    headings.push_back(std::string{kListedFeasts[i].name});
+  }
+
+  try {
+    m_table_list->setTable(
+        std::make_unique<PaschalionTable>(columns, first, last), headings);
+  } catch (const std::invalid_argument& e) {
+    wxMessageDialog dialog(this, e.what(), "Error", wxOK | wxICON_ERROR);
+    dialog.ShowModal();
+  }
+  evt.Skip();
+} // wxTableView::onShowClicked(wxCommandEvent&)
+
+} // namespace pascha
+
+wxBEGIN_EVENT_TABLE(pascha::wxTableView, wxFrame)
+  EVT_BUTTON(id_show_button, pascha::wxTableView::onShowClicked)
+wxEND_EVENT_TABLE()
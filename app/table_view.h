@@ -0,0 +1,97 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-gui: A GUI Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_TABLE_VIEW_H
+#define PASCHA_TABLE_VIEW_H
+
+#include "pascha/calculation_options.h"
+#include "pascha/date.h"
+#include "pascha/paschalion_table.h"
+
+#include <wx/listctrl.h>
+#include <wx/wx.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pascha
+{
+
+using DateFormatter = std::function<std::string(const Date&)>;
+
+// A virtual list of the rows of a PaschalionTable. Only the rows being shown
+// are asked for, so any number of years can be listed.
+class PaschalionListCtrl : public wxListCtrl
+{
+ public:
+  PaschalionListCtrl(wxWindow* parent, DateFormatter formatter);
+
+  // Show the table, with the given headings for its columns.
+  void setTable(std::unique_ptr<PaschalionTable> table,
+                const std::vector<wxString>& headings);
+
+ protected:
+  wxString OnGetItemText(long item, long column) const override;
+
+ private:
+  std::unique_ptr<PaschalionTable> m_table{};
+  DateFormatter m_formatter{};
+
+  void onCacheHint(wxListEvent& evt);
+}; // class PaschalionListCtrl
+
+// A window listing Pascha and the chosen moveable feasts for a range of
+// years, using the calculation method, output calendar and options of the
+// main view.
+class wxTableView : public wxFrame
+{
+ public:
+  wxTableView(wxWindow* parent, const CalculationOptions& options,
+              DateFormatter formatter, std::string_view pascha_name);
+
+  // GUI Components
+  wxTextCtrl* m_first_year_text{};
+  wxTextCtrl* m_last_year_text{};
+  wxCheckListBox* m_feasts_list{};
+  wxButton* m_show_button{};
+  PaschalionListCtrl* m_table_list{};
+
+  // GUI callbacks
+  void onShowClicked(wxCommandEvent& evt);
+
+  wxDECLARE_EVENT_TABLE();
+
+  enum
+  {
+    id_show_button = wxID_HIGHEST + 1,
+  };
+
+ private:
+  CalculationOptions m_options{};
+  std::string m_pascha_name{};
+}; // class wxTableView
+
+} // namespace pascha
+#endif // !PASCHA_TABLE_VIEW_H
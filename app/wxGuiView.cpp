@@ -21,18 +21,63 @@
 #include "wxGuiView.h"
 
 #include "config_io.h"
+#include "date_text.h"
+#include "export_view.h"
+#include "statistics_view.h"
+#include "table_view.h"
 #include "pascha/calculation_options.h"
 
-#include <fmt/core.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
 #include <wx/stdpaths.h>
 #include <wx/textfile.h>
 #include <wx/wrapsizer.h>
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <ctime>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <string_view>
 
+// Lets wx strings be formatted directly. Each is still converted to a
+// temporary UTF-8 buffer, which allocates, as wx strings are not stored as
+// UTF-8 on every platform.
+template <>
+struct fmt::formatter<wxString> : fmt::formatter<fmt::string_view>
+{
+  template <typename FormatContext>
+  auto format(const wxString& text, FormatContext& ctx) const
+  {
+    const wxScopedCharBuffer utf8{text.utf8_str()};
+    return fmt::formatter<fmt::string_view>::format(
+        fmt::string_view{utf8.data(), utf8.length()}, ctx);
+  }
+}; // struct fmt::formatter<wxString>
+
+namespace
+{
+
+// Format into a stack buffer, converting to a wx string only once.
+template <typename Format, typename... Args>
+wxString formatLabel(const Format& format, const Args&... args)
+{
+  fmt::memory_buffer buffer{};
+  fmt::format_to(std::back_inserter(buffer), format, args...);
+  return wxString::FromUTF8(buffer.data(), buffer.size());
+} // formatLabel
+
+template <typename Integer>
+wxString formatInteger(Integer value)
+{
+  const fmt::format_int text{value};
+  return wxString::FromUTF8(text.data(), text.size());
+} // formatInteger
+
+} // anonymous namespace
+
 namespace pascha
 {
 wxGuiView::wxGuiView(IController& controller, ICalculatorModel& model,
@@ -68,6 +113,23 @@ wxGuiView::wxGuiView(IController& controller, ICalculatorModel& model,
 
   m_menu_bar->Append(settings_menu, "Settings");
 
+  wxMenu* export_menu = new wxMenu;
+  export_menu->Append(id_export_menu_item, "Export...\tCtrl+E");
+
+  m_menu_bar->Append(export_menu, "Export");
+
+  wxMenu* calculation_menu = new wxMenu;
+  calculation_menu->Append(id_table_menu_item, "Paschalion Table...");
+  calculation_menu->Append(id_statistics_menu_item, "Statistics...");
+  calculation_menu->Append(id_cancel_menu_item, "Cancel\tEsc");
+  calculation_menu->Append(id_latency_menu_item, "Latency Statistics");
+  calculation_menu->AppendCheckItem(id_measure_typing_menu_item,
+                                    "Measure Typing Latency");
+
+  m_menu_bar->Append(calculation_menu, "Calculation");
+
+  m_status_bar = this->CreateStatusBar();
+
   m_main_sizer = new wxBoxSizer(wxVERTICAL);
 
   wxScrolledWindow* sw = new wxScrolledWindow(this, wxID_ANY, wxDefaultPosition,
@@ -133,8 +195,18 @@ wxGuiView::wxGuiView(IController& controller, ICalculatorModel& model,
   auto nowTime{std::chrono::system_clock::to_time_t(now)};
   auto currYear{std::localtime(&nowTime)->tm_year + 1900};
   wxString currYearStr{std::to_string(currYear)};
-  m_input_year_text = new wxTextCtrl(sw, wxID_ANY, currYearStr);
+  m_input_year_text = new wxTextCtrl(sw, id_input_year_text, currYearStr);
   input_year_sizer->Add(m_input_year_text, 0, wxALL, 5);
+  m_input_year_spin =
+      new wxSpinButton(sw, id_input_year_spin, wxDefaultPosition,
+                       wxDefaultSize, wxSP_VERTICAL | wxSP_ARROW_KEYS);
+  // The spin button only reports steps; the year is kept in the text.
+  m_input_year_spin->SetRange(-1, 1);
+  m_input_year_spin->SetValue(0);
+  input_year_sizer->Add(m_input_year_spin, 0, wxALL | wxEXPAND, 5);
+  // Scrub through the years with the mouse wheel or arrow keys.
+  m_input_year_text->Bind(wxEVT_MOUSEWHEEL, &wxGuiView::onYearWheel, this);
+  m_input_year_text->Bind(wxEVT_KEY_DOWN, &wxGuiView::onYearKeyDown, this);
   sw_sizer->Add(input_year_sizer, 0, wxALL | wxEXPAND, 5);
 
   m_calculate_button = new wxButton(sw, id_calculate_button, "Calculate");
@@ -165,34 +237,68 @@ void wxGuiView::createView() { this->Show(); } // wxGuiView::createView()
 void wxGuiView::update(const Date& date)
 {
   m_output_label->SetLabel(
-      fmt::format(fmt::runtime("{} {}:"),
-                  std::string(m_target_output_combobox->GetStringSelection()),
-                  std::string(m_input_year_text->GetValue())));
-  m_output_text->SetLabel(formatDate(date));
+      formatLabel(FMT_COMPILE("{} {}:"),
+                  m_target_output_combobox->GetStringSelection(),
+                  m_input_year_text->GetValue()));
+  m_shown_date = date;
+  const DateText text{date, m_date_format, m_date_separator};
+  m_output_text->SetLabel(wxString::FromUTF8(text.data(), text.size()));
+  m_main_sizer->Layout();
+  recordTypingLatency();
 } // wxGuiView::update(const Date&)
 
 void wxGuiView::update(Weeks weeks)
 {
   m_output_label->SetLabel(
-      fmt::format(fmt::runtime("Weeks between Julian and Gregorian {} {}:"),
-                  m_pascha_name, std::string(m_input_year_text->GetValue())));
-  m_output_text->SetLabel(std::to_string(weeks.value));
+      formatLabel(FMT_COMPILE("Weeks between Julian and Gregorian {} {}:"),
+                  m_pascha_name, m_input_year_text->GetValue()));
+  m_shown_date.reset();
+  m_output_text->SetLabel(formatInteger(weeks.value));
+  m_main_sizer->Layout();
+  recordTypingLatency();
 } // wxGuiView::update(Weeks)
 
 void wxGuiView::update(Days days)
 {
   m_output_label->SetLabel(
-      fmt::format(fmt::runtime("Days until {} {}:"), m_pascha_name,
-                  std::string(m_input_year_text->GetValue())));
-  m_output_text->SetLabel(std::to_string(days.value));
+      formatLabel(FMT_COMPILE("Days until {} {}:"), m_pascha_name,
+                  m_input_year_text->GetValue()));
+  m_shown_date.reset();
+  m_output_text->SetLabel(formatInteger(days.value));
+  m_main_sizer->Layout();
+  recordTypingLatency();
 } // wxGuiView::update(Days)
 
 void wxGuiView::update(std::string_view message)
 {
-  wxMessageDialog dialog(this, message.data(), "Error", wxOK | wxICON_ERROR);
-  dialog.ShowModal();
+  if (m_live) {
+    m_status_bar->SetStatusText(
+        wxString::FromUTF8(message.data(), message.size()));
+    return;
+  }
+  showError(message);
 } // wxGuiView::update(std::string_view)
 
+void wxGuiView::showError(std::string_view message)
+{
+  wxMessageDialog dialog(this, wxString::FromUTF8(message.data(),
+                                                  message.size()),
+                         "Error", wxOK | wxICON_ERROR);
+  dialog.ShowModal();
+} // wxGuiView::showError(std::string_view)
+
+void wxGuiView::update(const Progress& progress)
+{
+  if (progress.years_done == progress.years_total) {
+    m_status_bar->SetStatusText("");
+    return;
+  }
+  m_status_bar->SetStatusText(formatLabel(
+      FMT_COMPILE("{} of {} years ({:.0f} years/s, {:.0f} s remaining)"),
+      progress.years_done, progress.years_total, progress.years_per_second,
+      progress.eta.count()));
+} // wxGuiView::update(const Progress&)
+
 void wxGuiView::onPaschaNameClicked(wxCommandEvent& evt)
 {
   wxSingleChoiceDialog dialog(this, "Pascha Name", "Pascha Name",
@@ -220,11 +326,8 @@ void wxGuiView::onDateFormatClicked(wxCommandEvent& evt)
     return;
   }
   setDateFormat(dialog.GetStringSelection());
-  if (m_output_label->GetLabel() != "") {
-    onCalculateClicked(evt);
-  } else {
-    evt.Skip();
-  }
+  refreshShownDate();
+  evt.Skip();
 } // wxGuiView::onSettingsClick(wxCommandEvent&)
 
 void wxGuiView::onSeparatorClicked(wxCommandEvent& evt)
@@ -237,11 +340,8 @@ void wxGuiView::onSeparatorClicked(wxCommandEvent& evt)
     return;
   }
   setDateSeparator(dialog.GetValue());
-  if (m_output_label->GetLabel() != "") {
-    onCalculateClicked(evt);
-  } else {
-    evt.Skip();
-  }
+  refreshShownDate();
+  evt.Skip();
 } // wxGuiView::onSeparatorClicked(wxCommandEvent&)
 
 void wxGuiView::onSavePreferencesClicked(wxCommandEvent& evt)
@@ -253,7 +353,7 @@ void wxGuiView::onSavePreferencesClicked(wxCommandEvent& evt)
   evt.Skip();
 }
 
-void wxGuiView::onCalculateClicked(wxCommandEvent& evt)
+CalculationOptions wxGuiView::selectedOptions() const
 {
   CalculationOptions options{};
 
@@ -302,24 +402,215 @@ void wxGuiView::onCalculateClicked(wxCommandEvent& evt)
     options.options.push_back(e_output_option::byzantine);
   }
 
+  return options;
+} // wxGuiView::selectedOptions() const
+
+void wxGuiView::onCalculateClicked(wxCommandEvent& evt)
+{
+  CalculationOptions options{selectedOptions()};
+
   // Get the input year
   try {
     options.year = std::stoll(std::string(m_input_year_text->GetValue()));
   } catch (std::invalid_argument& e) {
-    update("Invalid year");
+    showError("Invalid year");
     evt.Skip();
     return;
   } catch (std::out_of_range& e) {
-    update("Year out of range");
+    showError("Year out of range");
     evt.Skip();
     return;
   }
 
+  // The result arrives asynchronously, through update().
+  m_live = false;
   m_controller->calculate(options);
-  m_main_sizer->Layout();
   evt.Skip();
 } // wxGuiView::onCalculate(wxCommandEvent&)
 
+void wxGuiView::onYearTextChanged(wxCommandEvent& evt)
+{
+  if (m_measure_typing && !m_keystroke) {
+    m_keystroke = std::chrono::steady_clock::now();
+  }
+
+  // Evaluate once the pending events have been handled, so that a burst of
+  // keystrokes (or a paste) is evaluated once, with no added delay.
+  if (!m_live_pending) {
+    m_live_pending = true;
+    CallAfter([this] {
+      m_live_pending = false;
+      evaluateTypedYear();
+    });
+  }
+  evt.Skip();
+} // wxGuiView::onYearTextChanged(wxCommandEvent&)
+
+void wxGuiView::onYearSpinUp(wxSpinEvent& evt)
+{
+  stepYear(1);
+  m_input_year_spin->SetValue(0);
+  evt.Veto();
+} // wxGuiView::onYearSpinUp(wxSpinEvent&)
+
+void wxGuiView::onYearSpinDown(wxSpinEvent& evt)
+{
+  stepYear(-1);
+  m_input_year_spin->SetValue(0);
+  evt.Veto();
+} // wxGuiView::onYearSpinDown(wxSpinEvent&)
+
+void wxGuiView::onYearWheel(wxMouseEvent& evt)
+{
+  int steps{evt.GetWheelRotation() / std::max(evt.GetWheelDelta(), 1)};
+  if (steps != 0) { stepYear(steps); }
+} // wxGuiView::onYearWheel(wxMouseEvent&)
+
+void wxGuiView::onYearKeyDown(wxKeyEvent& evt)
+{
+  switch (evt.GetKeyCode()) {
+    case WXK_UP: stepYear(1); break;
+    case WXK_DOWN: stepYear(-1); break;
+    case WXK_PAGEUP: stepYear(10); break;
+    case WXK_PAGEDOWN: stepYear(-10); break;
+    default: evt.Skip(); break;
+  }
+} // wxGuiView::onYearKeyDown(wxKeyEvent&)
+
+void wxGuiView::stepYear(Year step)
+{
+  std::optional<Year> year{typedYear()};
+  if (!year) { return; }
+  // Stop at the ends of Year rather than overflowing past them.
+  if (step >= 0) {
+    *year = *year <= std::numeric_limits<Year>::max() - step
+                ? *year + step
+                : std::numeric_limits<Year>::max();
+  } else {
+    *year = *year >= std::numeric_limits<Year>::min() - step
+                ? *year + step
+                : std::numeric_limits<Year>::min();
+  }
+  // Generates a text event, like typing.
+  m_input_year_text->SetValue(std::to_string(*year));
+  m_input_year_text->SetInsertionPointEnd();
+} // wxGuiView::stepYear(Year)
+
+void wxGuiView::evaluateTypedYear()
+{
+  // Partly typed years are expected, as are years beyond the range of Year
+  // while typing, so they are ignored rather than reported.
+  std::optional<Year> year{typedYear()};
+  if (!year) {
+    m_keystroke.reset();
+    return;
+  }
+
+  CalculationOptions options{selectedOptions()};
+  options.year = *year;
+  // Clear any error shown for the previous year.
+  m_status_bar->SetStatusText("");
+  m_live = true;
+  m_controller->calculate(options);
+} // wxGuiView::evaluateTypedYear()
+
+std::optional<Year> wxGuiView::typedYear() const
+{
+  std::string text{m_input_year_text->GetValue().ToStdString()};
+  Year year{};
+  auto [end, error] = std::from_chars(text.data(), text.data() + text.size(),
+                                      year);
+  if (error != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return year;
+} // wxGuiView::typedYear() const
+
+void wxGuiView::recordTypingLatency()
+{
+  if (!m_keystroke) { return; }
+  // Paint now, rather than on the next idle event, so that the time includes
+  // it.
+  this->Update();
+  m_typing_latency.record(std::chrono::steady_clock::now() - *m_keystroke);
+  m_keystroke.reset();
+} // wxGuiView::recordTypingLatency()
+
+void wxGuiView::onMeasureTypingClicked(wxCommandEvent& evt)
+{
+  m_measure_typing = evt.IsChecked();
+  m_keystroke.reset();
+  if (m_measure_typing) { m_typing_latency.reset(); }
+  evt.Skip();
+} // wxGuiView::onMeasureTypingClicked(wxCommandEvent&)
+
+void wxGuiView::onExportClicked(wxCommandEvent& evt)
+{
+  auto* export_view = new wxExportView(this, selectedOptions(), m_date_format,
+                                       m_date_separator);
+  export_view->Show();
+  evt.Skip();
+} // wxGuiView::onExportClicked(wxCommandEvent&)
+
+void wxGuiView::onTableClicked(wxCommandEvent& evt)
+{
+  // The table is a child window, so it does not outlive this view.
+  auto* table = new wxTableView(
+      this, selectedOptions(),
+      [this](const Date& date) { return formatDate(date); }, m_pascha_name);
+  table->Show();
+  evt.Skip();
+} // wxGuiView::onTableClicked(wxCommandEvent&)
+
+void wxGuiView::onStatisticsClicked(wxCommandEvent& evt)
+{
+  if (!m_statistics) {
+    m_statistics = std::make_shared<StatisticsCalculator>();
+  }
+  auto* statistics = new wxStatisticsView(this, selectedOptions(),
+                                          m_statistics, m_pascha_name);
+  statistics->Show();
+  evt.Skip();
+} // wxGuiView::onStatisticsClicked(wxCommandEvent&)
+
+void wxGuiView::onCancelClicked(wxCommandEvent& evt)
+{
+  if (m_controller->cancel()) { m_status_bar->SetStatusText("Cancelled"); }
+  evt.Skip();
+} // wxGuiView::onCancelClicked(wxCommandEvent&)
+
+void wxGuiView::onLatencyClicked(wxCommandEvent& evt)
+{
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  const LatencyHistogram& latency{m_controller->latency()};
+  std::string typing{};
+  if (m_typing_latency.count() > 0) {
+    typing = fmt::format(
+        "\n\nKeystrokes timed: {}\n"
+        "Keystroke to paint, median: {:.3f} ms\n"
+        "Keystroke to paint, 99th percentile: {:.3f} ms",
+        m_typing_latency.count(),
+        Milliseconds{m_typing_latency.percentile(0.5)}.count(),
+        Milliseconds{m_typing_latency.percentile(0.99)}.count());
+  }
+  wxMessageDialog dialog{
+      this,
+      fmt::format("Dates calculated: {}\n"
+                  "Calculations shown: {}\n"
+                  "Median: {:.2f} ms\n"
+                  "90th percentile: {:.2f} ms\n"
+                  "99th percentile: {:.2f} ms\n"
+                  "Slowest: {:.2f} ms{}",
+                  m_model->calculationCount(), latency.count(),
+                  Milliseconds{latency.percentile(0.5)}.count(),
+                  Milliseconds{latency.percentile(0.9)}.count(),
+                  Milliseconds{latency.percentile(0.99)}.count(),
+                  Milliseconds{latency.max()}.count(), typing),
+      "Latency Statistics", wxOK | wxICON_INFORMATION};
+  dialog.ShowModal();
+  evt.Skip();
+} // wxGuiView::onLatencyClicked(wxCommandEvent&)
+
 void wxGuiView::setTargetOutputChoices(wxComboBox* combobox)
 {
   combobox->Clear();
@@ -394,17 +685,18 @@ const wxString wxGuiView::getDateFormat() const
 
 std::string wxGuiView::formatDate(const Date& date) const
 {
-  std::string format_string{};
-  switch (m_date_format) {
-    case DateFormat::YMD: format_string = "{0}{3}{1}{3}{2}"; break;
-    case DateFormat::MDY: format_string = "{1}{3}{2}{3}{0}"; break;
-    case DateFormat::DMY: format_string = "{2}{3}{1}{3}{0}"; break;
-    default: format_string = "{0}{3}{1}{3}{2}"; break;
-  }
-  return fmt::format(fmt::runtime(format_string), date.year, date.month,
-                     date.day, m_date_separator);
+  return std::string{DateText{date, m_date_format, m_date_separator}.view()};
 } // wxGuiView::formatDate(const Date&)
 
+void wxGuiView::refreshShownDate()
+{
+  // Only the presentation has changed, so there is nothing to calculate.
+  if (!m_shown_date) { return; }
+  const DateText text{*m_shown_date, m_date_format, m_date_separator};
+  m_output_text->SetLabel(wxString::FromUTF8(text.data(), text.size()));
+  m_main_sizer->Layout();
+} // wxGuiView::refreshShownDate()
+
 void wxGuiView::setDateSeparator(const wxString& separator)
 {
   m_date_separator = separator;
@@ -415,14 +707,14 @@ void wxGuiView::writeConfigFile()
   wxFileName config_file{configFile()};
 
   if (!config_file.FileExists()) {
-    update("Failed to write config file!");
+    showError("Failed to write config file!");
     return;
   }
 
   wxTextFile file{};
   file.Open(config_file.GetFullPath());
   if (!file.IsOpened()) {
-    update("Failed to write config file!");
+    showError("Failed to write config file!");
     return;
   }
   // try writing to the config file
@@ -434,7 +726,7 @@ void wxGuiView::writeConfigFile()
     file.Write();
     file.Close();
   } catch (...) {
-    update("Failed to write config file!");
+    showError("Failed to write config file!");
     file.Close();
     return;
   }
@@ -454,6 +746,16 @@ wxBEGIN_EVENT_TABLE(pascha::wxGuiView, wxFrame)
     pascha::wxGuiView::onSeparatorClicked)
   EVT_MENU(id_save_preferences_menu_item,
     pascha::wxGuiView::onSavePreferencesClicked)
+  EVT_MENU(id_export_menu_item, pascha::wxGuiView::onExportClicked)
+  EVT_MENU(id_table_menu_item, pascha::wxGuiView::onTableClicked)
+  EVT_MENU(id_statistics_menu_item, pascha::wxGuiView::onStatisticsClicked)
+  EVT_MENU(id_cancel_menu_item, pascha::wxGuiView::onCancelClicked)
+  EVT_MENU(id_latency_menu_item, pascha::wxGuiView::onLatencyClicked)
+  EVT_MENU(id_measure_typing_menu_item,
+    pascha::wxGuiView::onMeasureTypingClicked)
+  EVT_TEXT(id_input_year_text, pascha::wxGuiView::onYearTextChanged)
+  EVT_SPIN_UP(id_input_year_spin, pascha::wxGuiView::onYearSpinUp)
+  EVT_SPIN_DOWN(id_input_year_spin, pascha::wxGuiView::onYearSpinDown)
   EVT_BUTTON(id_calculate_button,
     pascha::wxGuiView::onCalculateClicked)
 wxEND_EVENT_TABLE()
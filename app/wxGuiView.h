@@ -21,14 +21,19 @@
 #ifndef PASCHA_WXGUIVIEW_H
 #define PASCHA_WXGUIVIEW_H
 
-#include "date_format.h"
-
+#include "pascha/date_format.h"
 #include "pascha/i_calculator_model.h"
 #include "pascha/i_controller.h"
 #include "pascha/i_view.h"
+#include "pascha/latency_histogram.h"
+#include "pascha/statistics.h"
 
+#include <wx/spinbutt.h>
 #include <wx/wx.h>
 
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
 
 namespace pascha
@@ -51,6 +56,7 @@ class wxGuiView : public IView, public wxFrame
   void update(Weeks weeks) override;
   void update(Days days) override;
   void update(std::string_view message) override;
+  void update(const Progress& progress) override;
 
   // GUI Components
   wxBoxSizer* m_main_sizer{};
@@ -69,9 +75,11 @@ class wxGuiView : public IView, public wxFrame
   wxCheckBox* m_byzantine_year_checkbox{};
   wxStaticText* m_input_year_label{};
   wxTextCtrl* m_input_year_text{};
+  wxSpinButton* m_input_year_spin{};
   wxButton* m_calculate_button{};
   wxStaticText* m_output_label{};
   wxStaticText* m_output_text{};
+  wxStatusBar* m_status_bar{};
 
   // GUI callbacks
   void onDateFormatClicked(wxCommandEvent& evt);
@@ -79,6 +87,17 @@ class wxGuiView : public IView, public wxFrame
   void onSeparatorClicked(wxCommandEvent& evt);
   void onSavePreferencesClicked(wxCommandEvent& evt);
   void onCalculateClicked(wxCommandEvent& evt);
+  void onCancelClicked(wxCommandEvent& evt);
+  void onLatencyClicked(wxCommandEvent& evt);
+  void onExportClicked(wxCommandEvent& evt);
+  void onTableClicked(wxCommandEvent& evt);
+  void onStatisticsClicked(wxCommandEvent& evt);
+  void onYearTextChanged(wxCommandEvent& evt);
+  void onYearSpinUp(wxSpinEvent& evt);
+  void onYearSpinDown(wxSpinEvent& evt);
+  void onYearWheel(wxMouseEvent& evt);
+  void onYearKeyDown(wxKeyEvent& evt);
+  void onMeasureTypingClicked(wxCommandEvent& evt);
 
   wxDECLARE_EVENT_TABLE();
 
@@ -88,6 +107,14 @@ class wxGuiView : public IView, public wxFrame
     id_date_format_menu_item,
     id_date_separator_menu_item,
     id_save_preferences_menu_item,
+    id_export_menu_item,
+    id_cancel_menu_item,
+    id_latency_menu_item,
+    id_measure_typing_menu_item,
+    id_table_menu_item,
+    id_statistics_menu_item,
+    id_input_year_text,
+    id_input_year_spin,
     id_calculate_button,
   };
 
@@ -99,13 +126,40 @@ class wxGuiView : public IView, public wxFrame
   std::string m_date_separator{};
   wxArrayString m_pascha_name_choices{};
   wxArrayString m_date_format_choices{};
-
+  // The date shown, if any, kept so that it can be re-formatted when the date
+  // settings change without calculating it again.
+  std::optional<Date> m_shown_date{};
+  // Whether a live evaluation of the typed year has been posted.
+  bool m_live_pending{false};
+  // Whether the latest calculation is a live evaluation, whose errors are
+  // shown in the status bar rather than interrupting typing with a dialog.
+  bool m_live{false};
+  // When measuring, the time of the first keystroke whose result has not yet
+  // been shown, and the keystroke-to-paint latencies.
+  bool m_measure_typing{false};
+  std::optional<std::chrono::steady_clock::time_point> m_keystroke{};
+  LatencyHistogram m_typing_latency{};
+  // Shared with the statistics windows, and created by the first of them.
+  std::shared_ptr<StatisticsCalculator> m_statistics{};
+
+  // Report an error with a dialog, whatever the latest calculation was.
+  void showError(std::string_view message);
   void setTargetOutputChoices(wxComboBox* box);
   void setPaschaName(const wxString& pascha_name);
   void refreshPaschaName();
   void setDateFormat(const wxString& format);
   const wxString getDateFormat() const;
   std::string formatDate(const Date& date) const;
+  void refreshShownDate();
+  // The options selected in the view, without the year.
+  CalculationOptions selectedOptions() const;
+  void evaluateTypedYear();
+  // The year in the text box, if it is a whole number.
+  std::optional<Year> typedYear() const;
+  // Step the typed year, which evaluates it as if it had been typed.
+  void stepYear(Year step);
+  // Paint the output and record the latency, if a keystroke is being timed.
+  void recordTypingLatency();
   void setDateSeparator(const wxString& separator);
   void writeConfigFile();
 }; // class wxGuiView
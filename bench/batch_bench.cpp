@@ -0,0 +1,125 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Evaluates a batch file of queries with mixed options, in the text and
+// binary formats, and compares the rate with building a decorated method for
+// each query.
+//
+// Usage: batch_bench [queries]
+
+#include "pascha/batch.h"
+#include "pascha/feasts.h"
+#include "pascha/method_factory.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+// Discards what is written to it.
+class NullBuffer : public std::streambuf
+{
+ protected:
+  std::streamsize xsputn(const char*, std::streamsize count) override
+  {
+    return count;
+  }
+  int overflow(int c) override { return c; }
+}; // class NullBuffer
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+  using Clock = std::chrono::steady_clock;
+
+  long long queries{argc > 1 ? std::atoll(argv[1]) : 4'000'000};
+  if (queries < 1) { queries = 1; }
+
+  // Queries cycle through the feasts and calendars, a year at a time, as a
+  // job asking for several dates of each year would.
+  std::string text{};
+  std::string binary{kBatchMagic.data(), kBatchMagic.size()};
+  binary += std::string{"\x01\0\0\0\x10\0\0\0", 8};
+  const char* calendars[]{"julian", "gregorian", "revised-julian"};
+  std::vector<CalculationOptions> options{};
+  for (long long i = 0; i < queries; ++i) {
+    const Feast& feast{kFeasts[static_cast<std::size_t>(i) % kFeasts.size()]};
+    const int calendar{static_cast<int>(i / kFeasts.size() % 3)};
+    const Year year{1900 + i / 24 % 300};
+    text += std::to_string(year) + ",julian," + feastSlug(feast) + ',' +
+            calendars[calendar] + ",0\n";
+    auto bits{static_cast<std::uint64_t>(year)};
+    for (int b = 0; b < 8; ++b, bits >>= 8) {
+      binary += static_cast<char>(bits & 0xff);
+    }
+    binary += '\0';
+    binary += static_cast<char>(feast.target);
+    binary += static_cast<char>(calendar);
+    binary.append(5, '\0');
+    if (i < 24) {
+      options.push_back(
+          {e_calculation_method::julian, {feast.target}, calendar, {}, year});
+    }
+  }
+
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "pascha_batch_bench.txt"};
+  NullBuffer null{};
+  std::ostream out{&null};
+  std::printf("%-10s %12s %14s\n", "", "seconds", "queries/s");
+  for (auto [name, input] : {std::pair{"text", &text}, {"binary", &binary}}) {
+    {
+      std::ofstream file{path, std::ios::binary};
+      file << *input;
+    }
+    auto start{Clock::now()};
+    evaluateBatchFile(path, out);
+    std::chrono::duration<double> seconds{Clock::now() - start};
+    std::printf("%-10s %12.4f %14.0f\n", name, seconds.count(),
+                static_cast<double>(queries) / seconds.count());
+  }
+
+  // A method built for each query, as answering them one at a time would.
+  BulkDateFormatter formatter{DateFormat::YMD, "-"};
+  std::string line{};
+  auto start{Clock::now()};
+  for (long long i = 0; i < queries; ++i) {
+    const CalculationOptions& query{options[static_cast<std::size_t>(i % 24)]};
+    line = formatter.format(makeCalculationMethod(query)->calculate(
+               query.year + i / 24 % 300)) +
+           '\n';
+    out << line;
+  }
+  std::chrono::duration<double> seconds{Clock::now() - start};
+  std::printf("%-10s %12.4f %14.0f\n", "per query", seconds.count(),
+              static_cast<double>(queries) / seconds.count());
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Compares writing dates for an export with fmt, one field at a time, against
+// BulkDateFormatter writing whole batches.
+//
+// Usage: bulk_format_bench [dates]
+
+#include "pascha/bulk_date_formatter.h"
+#include "pascha/calculation_methods.h"
+#include "pascha/date_format.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+  using Clock = std::chrono::steady_clock;
+
+  long long count{argc > 1 ? std::atoll(argv[1]) : 10'000'000};
+  if (count < 1) { count = 1; }
+
+  GregorianCalculationMethod method{};
+  std::vector<Date> dates{};
+  dates.reserve(static_cast<std::size_t>(count));
+  for (Year year = 1; year <= count; ++year) {
+    dates.push_back(method.calculate(year));
+  }
+  const std::string separator{"-"};
+
+  auto start{Clock::now()};
+  std::string per_field{};
+  auto out{std::back_inserter(per_field)};
+  for (const Date& date : dates) {
+    out = fmt::format_to(out, "{}", date.year);
+    out = fmt::format_to(out, "{}", separator);
+    out = fmt::format_to(out, "{}", date.month);
+    out = fmt::format_to(out, "{}", separator);
+    out = fmt::format_to(out, "{}\n", date.day);
+  }
+  std::chrono::duration<double> fmt_seconds{Clock::now() - start};
+
+  start = Clock::now();
+  BulkDateFormatter formatter{DateFormat::YMD, separator};
+  std::string bulk{};
+  constexpr std::size_t batch{4096};
+  for (std::size_t first = 0; first < dates.size(); first += batch) {
+    formatter.append(std::span{dates}.subspan(first).first(
+                         std::min(batch, dates.size() - first)),
+                     bulk);
+  }
+  std::chrono::duration<double> bulk_seconds{Clock::now() - start};
+
+  std::printf("%-10s %12s %14s\n", "", "seconds", "dates/s");
+  std::printf("%-10s %12.4f %14.0f\n", "fmt", fmt_seconds.count(),
+              static_cast<double>(count) / fmt_seconds.count());
+  std::printf("%-10s %12.4f %14.0f\n", "bulk", bulk_seconds.count(),
+              static_cast<double>(count) / bulk_seconds.count());
+  std::printf("speedup %.1fx (%s)\n",
+              fmt_seconds.count() / bulk_seconds.count(),
+              per_field == bulk ? "same text" : "TEXT DIFFERS");
+
+  return per_field == bulk ? 0 : 1;
+}
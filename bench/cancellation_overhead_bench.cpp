@@ -0,0 +1,97 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Measures the cost of checking a cancellation token and reporting progress
+// during calculateRange, against the same range calculated without them.
+//
+// Usage: cancellation_overhead_bench [years] [repetitions]
+
+#include "pascha/calculation_methods.h"
+#include "pascha/cancellation.h"
+#include "pascha/range_calculation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+// Best of the given number of runs, in seconds.
+template <typename Run>
+double bestOf(int repetitions, Run run)
+{
+  double best{0};
+  for (int i = 0; i < repetitions; ++i) {
+    auto start{std::chrono::steady_clock::now()};
+    run();
+    std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                          start};
+    best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+
+  Year years{argc > 1 ? std::atoll(argv[1]) : 20'000'000};
+  int repetitions{argc > 2 ? std::atoi(argv[2]) : 5};
+  if (years < 1) { years = 1; }
+  if (repetitions < 1) { repetitions = 1; }
+
+  JulianCalculationMethod method{};
+  WorkStealingPool pool{};
+
+  // Consume the dates so the calculation cannot be optimised away.
+  std::int64_t checksum{0};
+  RangeConsumer consumer{[&checksum](Year, std::span<const Date> dates) {
+    for (const Date& date : dates) { checksum += date.day; }
+  }};
+
+  double plain{bestOf(repetitions, [&] {
+    calculateRange(method, 1, years, pool, consumer);
+  })};
+
+  CancellationToken cancellation{};
+  std::uint64_t reports{0};
+  RangeControl control{&cancellation,
+                       [&reports](const Progress&) { ++reports; }};
+  double controlled{bestOf(repetitions, [&] {
+    calculateRange(method, 1, years, pool, consumer, control);
+  })};
+
+  std::printf("%-24s %12s %14s\n", "", "seconds", "years/s");
+  std::printf("%-24s %12.4f %14.0f\n", "plain", plain,
+              static_cast<double>(years) / plain);
+  std::printf("%-24s %12.4f %14.0f\n", "cancellation+progress", controlled,
+              static_cast<double>(years) / controlled);
+  std::printf("overhead %.2f%% (%llu progress reports, checksum %lld)\n",
+              100 * (controlled - plain) / plain,
+              static_cast<unsigned long long>(reports),
+              static_cast<long long>(checksum));
+
+  return 0;
+}
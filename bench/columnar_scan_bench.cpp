@@ -0,0 +1,95 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Scans every date of a columnar file through its mapping, counting the dates
+// in April, and compares the rate with copying the same bytes.
+//
+// Usage: columnar_scan_bench [years]
+
+#include "pascha/columnar_file.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+  using Clock = std::chrono::steady_clock;
+
+  Year years{argc > 1 ? std::atoll(argv[1]) : 20'000'000};
+  if (years < 1) { years = 1; }
+
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "pascha_columnar_bench.bin"};
+  std::vector<CalculationOptions> columns{};
+  for (ETargetOutput target :
+       {e_target_output::pascha, e_target_output::pentecost}) {
+    for (EOutputCalendar calendar :
+         {e_output_calendar::julian, e_output_calendar::gregorian}) {
+      columns.push_back(CalculationOptions{
+          e_calculation_method::julian, {target}, calendar, {}, 0});
+    }
+  }
+  auto start{Clock::now()};
+  exportColumnar(path, columns, 1, years);
+  std::chrono::duration<double> write_seconds{Clock::now() - start};
+
+  ColumnarReader reader{path};
+  std::uint64_t bytes{0};
+  std::uint64_t april{0};
+  start = Clock::now();
+  for (std::size_t index = 0; index < reader.blockCount(); ++index) {
+    ColumnarBlock block{reader.block(index)};
+    for (std::size_t column = 0; column < columns.size(); ++column) {
+      for (std::uint32_t packed : block.packedDates(column)) {
+        april += ((packed >> 5) & 0xf) == 4;
+      }
+      bytes += block.rows() * sizeof(std::uint32_t);
+    }
+  }
+  std::chrono::duration<double> scan_seconds{Clock::now() - start};
+
+  // The same number of bytes copied, as a measure of memory bandwidth.
+  std::vector<char> from(bytes, 1);
+  std::vector<char> to(bytes);
+  start = Clock::now();
+  std::memcpy(to.data(), from.data(), bytes);
+  std::chrono::duration<double> copy_seconds{Clock::now() - start};
+
+  const double gigabytes{static_cast<double>(bytes) / 1e9};
+  std::printf("wrote %lld years x %zu columns in %.3f s\n",
+              static_cast<long long>(years), columns.size(),
+              write_seconds.count());
+  std::printf("%-8s %12s %10s\n", "", "seconds", "GB/s");
+  std::printf("%-8s %12.4f %10.2f\n", "scan", scan_seconds.count(),
+              gigabytes / scan_seconds.count());
+  std::printf("%-8s %12.4f %10.2f\n", "memcpy", copy_seconds.count(),
+              gigabytes / copy_seconds.count());
+  std::printf("dates in April: %llu (copied %d)\n",
+              static_cast<unsigned long long>(april), to[bytes - 1]);
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Compares rendering the result of one update in the main window the way it
+// was done before, with a run-time format string and temporary strings,
+// against the compiled format specs writing into stack buffers. Both read the
+// typed year from its wx text through a temporary UTF-8 buffer, which the
+// "after" side models with a heap copy; the conversions of the results to wx
+// strings are left out, as they are the same either way.
+//
+// Usage: date_render_bench [updates]
+
+#include "date_text.h"
+#include "pascha/calculation_methods.h"
+#include "pascha/date_format.h"
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+std::string formatDateRuntime(const Date& date, DateFormat format,
+                              const std::string& separator)
+{
+  std::string format_string{};
+  switch (format) {
+    case DateFormat::YMD: format_string = "{0}{3}{1}{3}{2}"; break;
+    case DateFormat::MDY: format_string = "{1}{3}{2}{3}{0}"; break;
+    case DateFormat::DMY: format_string = "{2}{3}{1}{3}{0}"; break;
+    default: format_string = "{0}{3}{1}{3}{2}"; break;
+  }
+  return fmt::format(fmt::runtime(format_string), date.year, date.month,
+                     date.day, separator);
+} // formatDateRuntime
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  using Clock = std::chrono::steady_clock;
+
+  long long updates{argc > 1 ? std::atoll(argv[1]) : 5'000'000};
+  if (updates < 1) { updates = 1; }
+
+  // Scrubbing through consecutive years.
+  GregorianCalculationMethod method{};
+  std::vector<Date> dates{};
+  for (Year year = 1900; year < 2900; ++year) {
+    dates.push_back(method.calculate(year));
+  }
+  const std::string target{"Pascha"};
+  const std::string year_text{"2024"};
+  const std::string separator{"-"};
+  const DateFormat format{DateFormat::DMY};
+
+  auto start{Clock::now()};
+  std::size_t before_bytes{0};
+  for (long long i = 0; i < updates; ++i) {
+    const Date& date{dates[static_cast<std::size_t>(i) % dates.size()]};
+    std::string label{fmt::format(fmt::runtime("{} {}:"), std::string(target),
+                                  std::string(year_text))};
+    std::string text{formatDateRuntime(date, format, separator)};
+    before_bytes += label.size() + text.size();
+  }
+  std::chrono::duration<double> before{Clock::now() - start};
+
+  start = Clock::now();
+  std::size_t after_bytes{0};
+  for (long long i = 0; i < updates; ++i) {
+    const Date& date{dates[static_cast<std::size_t>(i) % dates.size()]};
+    // As wxString::utf8_str() does for the typed year, however short.
+    const std::unique_ptr<char[]> year_utf8{new char[year_text.size() + 1]};
+    std::memcpy(year_utf8.get(), year_text.c_str(), year_text.size() + 1);
+    fmt::memory_buffer label{};
+    fmt::format_to(std::back_inserter(label), FMT_COMPILE("{} {}:"),
+                   std::string_view{target},
+                   std::string_view{year_utf8.get(), year_text.size()});
+    const DateText text{date, format, separator};
+    after_bytes += label.size() + text.size();
+  }
+  std::chrono::duration<double> after{Clock::now() - start};
+
+  std::printf("%-10s %12s %14s\n", "", "seconds", "ns/update");
+  std::printf("%-10s %12.4f %14.1f\n", "runtime", before.count(),
+              before.count() * 1e9 / static_cast<double>(updates));
+  std::printf("%-10s %12.4f %14.1f\n", "compiled", after.count(),
+              after.count() * 1e9 / static_cast<double>(updates));
+  std::printf("speedup %.1fx (bytes %zu, %zu)\n",
+              before.count() / after.count(), before_bytes, after_bytes);
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Compares the fused divergence analysis against calculating both dates of
+// Pascha through the calculation methods for each year, as weeksBetween does.
+//
+// Usage: divergence_bench [years]
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/divergence.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+  using Clock = std::chrono::steady_clock;
+
+  Year years{argc > 1 ? std::atoll(argv[1]) : 10'000'000};
+  if (years < 1) { years = 1; }
+
+  std::unique_ptr<ICalculationMethod> julian{new JulianCalculationMethod{}};
+  std::unique_ptr<ICalculationMethod> gregorian{
+      new GregorianCalculationMethod{}};
+
+  auto start{Clock::now()};
+  std::int64_t total{0};
+  for (Year year = 1; year <= years; ++year) {
+    total += (gregorianToJdn(julian->calculate(year)) -
+              gregorianToJdn(gregorian->calculate(year))) /
+             7;
+  }
+  std::chrono::duration<double> per_year{Clock::now() - start};
+
+  start = Clock::now();
+  DivergenceSummary summary{analyseDivergence(1, years)};
+  std::chrono::duration<double> fused{Clock::now() - start};
+
+  std::printf("%-10s %12s %14s\n", "", "seconds", "years/s");
+  std::printf("%-10s %12.4f %14.0f\n", "per year", per_year.count(),
+              static_cast<double>(years) / per_year.count());
+  std::printf("%-10s %12.4f %14.0f\n", "fused", fused.count(),
+              static_cast<double>(years) / fused.count());
+  std::printf("speedup %.1fx (totals %lld, %lld)\n",
+              per_year.count() / fused.count(), static_cast<long long>(total),
+              static_cast<long long>(summary.total_weeks));
+
+  return 0;
+}
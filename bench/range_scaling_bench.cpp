@@ -0,0 +1,78 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Measures how calculateRange scales from one worker thread up to one per
+// hardware thread.
+//
+// Usage: range_scaling_bench [years] [max threads]
+
+#include "pascha/calculation_methods.h"
+#include "pascha/range_calculation.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+
+  Year years{argc > 1 ? std::atoll(argv[1]) : 20'000'000};
+  std::size_t max_threads{argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                   : std::thread::hardware_concurrency()};
+  if (years < 1) { years = 1; }
+  if (max_threads == 0) { max_threads = 1; }
+
+  JulianCalculationMethod method{};
+
+  std::printf("%8s %12s %14s %8s %12s\n", "threads", "seconds", "years/s",
+              "speedup", "utilization");
+
+  double baseline{0};
+  for (std::size_t threads = 1; threads <= max_threads; ++threads) {
+    WorkStealingPool pool{threads};
+
+    // Consume the dates so the calculation cannot be optimised away.
+    std::int64_t checksum{0};
+    auto start{std::chrono::steady_clock::now()};
+    calculateRange(method, 1, years, pool,
+                   [&checksum](Year, std::span<const Date> dates) {
+                     for (const Date& date : dates) { checksum += date.day; }
+                   });
+    std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                          start};
+
+    double utilization{0};
+    for (const WorkerStats& stats : pool.stats()) {
+      utilization += stats.utilization();
+    }
+    utilization /= static_cast<double>(threads);
+
+    double rate{static_cast<double>(years) / elapsed.count()};
+    if (threads == 1) { baseline = rate; }
+    std::printf("%8zu %12.4f %14.0f %8.2f %11.1f%% (checksum %lld)\n", threads,
+                elapsed.count(), rate, rate / baseline, 100 * utilization,
+                static_cast<long long>(checksum));
+  }
+
+  return 0;
+}
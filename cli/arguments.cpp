@@ -0,0 +1,113 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "arguments.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace pascha
+{
+
+Arguments::Arguments(int argc, const char* const argv[])
+{
+  if (argc > 1) { m_command = argv[1]; }
+  for (int i = 2; i < argc; ++i) {
+    std::string_view argument{argv[i]};
+    if (!argument.starts_with("--") || argument.size() == 2) {
+      throw UsageError{"Unexpected argument: " + std::string{argument}};
+    }
+    std::string name{argument.substr(2)};
+    std::optional<std::string> value{};
+    if (i + 1 < argc && !std::string_view{argv[i + 1]}.starts_with("--")) {
+      value = argv[++i];
+    }
+    if (!m_options.emplace(std::move(name), std::move(value)).second) {
+      throw UsageError{"Repeated option: " + std::string{argument}};
+    }
+  }
+} // Arguments::Arguments
+
+bool Arguments::flag(std::string_view name) const
+{
+  auto option{m_options.find(name)};
+  if (option == m_options.end()) { return false; }
+  if (option->second) {
+    throw UsageError{"--" + option->first + " does not take a value"};
+  }
+  return true;
+} // Arguments::flag
+
+std::optional<std::string_view> Arguments::value(std::string_view name) const
+{
+  auto option{m_options.find(name)};
+  if (option == m_options.end()) { return std::nullopt; }
+  if (!option->second) {
+    throw UsageError{"--" + option->first + " needs a value"};
+  }
+  return *option->second;
+} // Arguments::value(std::string_view)
+
+std::string_view Arguments::value(std::string_view name,
+                                  std::string_view default_value) const
+{
+  return value(name).value_or(default_value);
+} // Arguments::value(std::string_view, std::string_view)
+
+std::optional<std::int64_t> Arguments::integer(std::string_view name) const
+{
+  std::optional<std::string_view> text{value(name)};
+  if (!text) { return std::nullopt; }
+
+  std::int64_t number{};
+  auto [end, error]{
+      std::from_chars(text->data(), text->data() + text->size(), number)};
+  if (error != std::errc{} || end != text->data() + text->size()) {
+    throw UsageError{"--" + std::string{name} +
+                     " is not a number: " + std::string{*text}};
+  }
+  return number;
+} // Arguments::integer
+
+Year Arguments::year(std::string_view name) const
+{
+  std::optional<Year> year{integer(name)};
+  if (!year) { throw UsageError{"--" + std::string{name} + " is required"}; }
+  return *year;
+} // Arguments::year
+
+void Arguments::erase(std::string_view name)
+{
+  auto option{m_options.find(name)};
+  if (option != m_options.end()) { m_options.erase(option); }
+} // Arguments::erase
+
+void Arguments::allowOnly(std::initializer_list<std::string_view> names) const
+{
+  for (const auto& [name, value] : m_options) {
+    if (std::ranges::find(names, std::string_view{name}) == names.end()) {
+      throw UsageError{"Unknown option for " + m_command + ": --" + name};
+    }
+  }
+} // Arguments::allowOnly
+
+} // namespace pascha
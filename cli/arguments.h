@@ -0,0 +1,78 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CLI_ARGUMENTS_H
+#define PASCHA_CLI_ARGUMENTS_H
+
+#include "pascha/typedefs.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace pascha
+{
+
+// Thrown for command lines which cannot be understood, so that the usage can
+// be shown.
+class UsageError : public std::runtime_error
+{
+ public:
+  using std::runtime_error::runtime_error;
+}; // class UsageError
+
+// A command followed by options, each either "--name value" or a "--name"
+// flag. A value may start with a single dash, e.g. a negative year.
+class Arguments
+{
+ public:
+  Arguments(int argc, const char* const argv[]);
+
+  const std::string& command() const { return m_command; }
+
+  bool flag(std::string_view name) const;
+  std::optional<std::string_view> value(std::string_view name) const;
+  std::string_view value(std::string_view name,
+                         std::string_view default_value) const;
+  // Throws UsageError if the option is not a number.
+  std::optional<std::int64_t> integer(std::string_view name) const;
+  // Throws UsageError if the option is missing or not a year.
+  Year year(std::string_view name) const;
+
+  void erase(std::string_view name);
+
+  // Throws UsageError naming the first option not in the list.
+  void allowOnly(std::initializer_list<std::string_view> names) const;
+
+ private:
+  std::string m_command{};
+  // Flags map to an empty value.
+  std::map<std::string, std::optional<std::string>, std::less<>> m_options{};
+}; // class Arguments
+
+} // namespace pascha
+
+#endif // !PASCHA_CLI_ARGUMENTS_H
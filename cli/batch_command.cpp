@@ -0,0 +1,64 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "commands.h"
+#include "options.h"
+
+#include "pascha/batch.h"
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace pascha
+{
+
+int batchCommand(const Arguments& arguments)
+{
+  arguments.allowOnly({"input", "output", "date-format", "separator"});
+
+  std::optional<std::string_view> input{arguments.value("input")};
+  if (!input) { throw UsageError{"Missing --input"}; }
+  BatchOptions options{};
+  options.date_format = dateFormat(arguments);
+  options.date_separator = arguments.value("separator", "-");
+  if (options.date_separator.find('\n') != std::string::npos) {
+    throw UsageError{"The separator cannot contain a newline"};
+  }
+
+  std::optional<std::string_view> output{arguments.value("output")};
+  if (!output || *output == "-") {
+    evaluateBatchFile(std::string{*input}, std::cout, options);
+    return 0;
+  }
+
+  std::ofstream file{std::string{*output}, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error{"Cannot open " + std::string{*output}};
+  }
+  evaluateBatchFile(std::string{*input}, file, options);
+  return 0;
+} // batchCommand
+
+} // namespace pascha
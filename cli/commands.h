@@ -0,0 +1,41 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CLI_COMMANDS_H
+#define PASCHA_CLI_COMMANDS_H
+
+#include "arguments.h"
+
+namespace pascha
+{
+
+// Each command returns the exit status, throwing UsageError for options it
+// cannot use and other exceptions for failures.
+
+int batchCommand(const Arguments& arguments);
+int exportCommand(const Arguments& arguments);
+int icsCommand(const Arguments& arguments);
+int pipeCommand(const Arguments& arguments);
+
+} // namespace pascha
+
+#endif // !PASCHA_CLI_COMMANDS_H
@@ -0,0 +1,92 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "commands.h"
+#include "options.h"
+
+#include "pascha/columnar_file.h"
+#include "pascha/export.h"
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace pascha
+{
+
+int exportCommand(const Arguments& arguments)
+{
+  arguments.allowOnly({"first", "last", "method", "calendar", "feasts",
+                       "byzantine", "format", "date-format", "separator",
+                       "flush-bytes", "output"});
+
+  std::optional<std::string_view> output{arguments.value("output")};
+  // Without a format, go by the extension of the output file.
+  std::string_view format{arguments.value(
+      "format", output && output->ends_with(".jsonl") ? "jsonl" : "csv")};
+  const Year first{arguments.year("first")};
+  const Year last{arguments.year("last")};
+
+  if (format == "columnar") {
+    if (!output || *output == "-") {
+      throw UsageError{"The columnar format needs an --output file"};
+    }
+    exportColumnar(std::string{*output}, columnOptions(arguments), first,
+                   last);
+    return 0;
+  }
+
+  ExportOptions options{};
+  options.calculation = calculationOptions(arguments);
+  options.date_format = dateFormat(arguments);
+  options.date_separator = arguments.value("separator", "-");
+  if (format == "csv") {
+    options.format = ExportFormat::csv;
+  } else if (format == "jsonl") {
+    options.format = ExportFormat::jsonLines;
+  } else {
+    throw UsageError{"Unknown export format: " + std::string{format}};
+  }
+
+  if (auto flush_bytes{arguments.integer("flush-bytes")}) {
+    if (*flush_bytes < 1) {
+      throw UsageError{"--flush-bytes must be positive"};
+    }
+    options.flush_bytes = static_cast<std::size_t>(*flush_bytes);
+  }
+
+  if (!output || *output == "-") {
+    exportRange(options, first, last, std::cout);
+    return 0;
+  }
+
+  std::ofstream file{std::string{*output}, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error{"Cannot open " + std::string{*output}};
+  }
+  exportRange(options, first, last, file);
+  return 0;
+} // exportCommand
+
+} // namespace pascha
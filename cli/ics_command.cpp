@@ -0,0 +1,65 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "commands.h"
+#include "options.h"
+
+#include "pascha/icalendar.h"
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace pascha
+{
+
+int icsCommand(const Arguments& arguments)
+{
+  arguments.allowOnly({"first", "last", "method", "calendar", "feasts",
+                       "byzantine", "date-format", "timestamp", "output"});
+
+  ICalendarOptions options{};
+  options.calculation = calculationOptions(arguments);
+  // A calendar of every feast unless some are chosen.
+  if (!arguments.value("feasts")) { options.calculation.target_outputs = {}; }
+  options.date_format = dateFormat(arguments);
+  options.timestamp = arguments.value("timestamp", "");
+  const Year first{arguments.year("first")};
+  const Year last{arguments.year("last")};
+
+  std::optional<std::string_view> output{arguments.value("output")};
+  if (!output || *output == "-") {
+    writeICalendar(options, first, last, std::cout);
+    return 0;
+  }
+
+  std::ofstream file{std::string{*output}, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error{"Cannot open " + std::string{*output}};
+  }
+  writeICalendar(options, first, last, file);
+  return 0;
+} // icsCommand
+
+} // namespace pascha
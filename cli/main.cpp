@@ -0,0 +1,109 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "arguments.h"
+#include "commands.h"
+#include "options.h"
+
+#include "pascha/feasts.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+void printUsage(std::ostream& out)
+{
+  out << "Usage: pascha-cli COMMAND [OPTIONS]\n"
+         "       pascha-cli --pipe [OPTIONS]\n"
+         "\n"
+         "Commands:\n"
+         "  batch   Write the date for each query in a text or binary\n"
+         "          batch file, a line each\n"
+         "          --input FILE [--output FILE]\n"
+         "  export  Write the dates of feasts for a range of years as CSV,\n"
+         "          JSON Lines or a columnar binary file, which takes a\n"
+         "          column per feast in each of a list of calendars\n"
+         "          --first YEAR --last YEAR [--output FILE]\n"
+         "          [--format csv|jsonl|columnar] [--flush-bytes N]\n"
+         "  ics     Write the feasts for a range of years as an iCalendar\n"
+         "          file, with every feast unless --feasts is given\n"
+         "          --first YEAR --last YEAR [--output FILE]\n"
+         "          [--timestamp YYYYMMDDTHHMMSSZ]\n"
+         "  pipe    Answer queries from standard input, a line each as in\n"
+         "          batch files, on standard output, as --pipe does.\n"
+         "          --splice writes pipes without copying, for readers\n"
+         "          which read them rather than splice them on\n"
+         "          [--splice]\n"
+         "  help    Show this message\n"
+         "\n"
+         "Calculation options:\n"
+         "  --method julian|gregorian             (default julian)\n"
+         "  --calendar julian|gregorian|revised-julian\n"
+         "                                        (default gregorian)\n"
+         "  --feasts FEAST[,FEAST...]             (default pascha)\n"
+         "  --byzantine                           Byzantine years\n"
+         "  --date-format ymd|mdy|dmy             (default ymd)\n"
+         "  --separator TEXT                      (default -)\n"
+         "\n"
+         "Feasts:";
+  for (const pascha::Feast& feast : pascha::kFeasts) {
+    out << ' ' << pascha::feastSlug(feast);
+  }
+  out << '\n';
+} // printUsage
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+
+  // Output is written in large blocks, so C stdio need not be kept in step.
+  std::ios::sync_with_stdio(false);
+
+  try {
+    Arguments arguments{argc, argv};
+    if (arguments.command() == "batch") { return batchCommand(arguments); }
+    if (arguments.command() == "export") { return exportCommand(arguments); }
+    if (arguments.command() == "ics") { return icsCommand(arguments); }
+    if (arguments.command() == "pipe" || arguments.command() == "--pipe") {
+      return pipeCommand(arguments);
+    }
+    if (arguments.command() == "help" || arguments.command() == "--help") {
+      printUsage(std::cout);
+      return 0;
+    }
+    throw UsageError{arguments.command().empty()
+                         ? "No command given"
+                         : "Unknown command: " + arguments.command()};
+  } catch (const UsageError& e) {
+    std::cerr << "pascha-cli: " << e.what() << "\n\n";
+    printUsage(std::cerr);
+    return 2;
+  } catch (const std::exception& e) {
+    std::cerr << "pascha-cli: " << e.what() << '\n';
+    return 1;
+  }
+} // main
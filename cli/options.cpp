@@ -0,0 +1,114 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "options.h"
+
+#include <algorithm>
+
+namespace
+{
+
+pascha::EOutputCalendar parseCalendar(std::string_view calendar)
+{
+  using namespace pascha;
+  if (calendar == "julian") { return e_output_calendar::julian; }
+  if (calendar == "gregorian") { return e_output_calendar::gregorian; }
+  if (calendar == "revised-julian") { return e_output_calendar::rev_julian; }
+  throw UsageError{"Unknown output calendar: " + std::string{calendar}};
+} // parseCalendar
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+CalculationOptions calculationOptions(const Arguments& arguments)
+{
+  CalculationOptions options{e_calculation_method::julian,
+                             {},
+                             e_output_calendar::gregorian,
+                             {},
+                             0};
+
+  std::string_view method{arguments.value("method", "julian")};
+  if (method == "julian") {
+    options.calculation_method = e_calculation_method::julian;
+  } else if (method == "gregorian") {
+    options.calculation_method = e_calculation_method::gregorian;
+  } else {
+    throw UsageError{"Unknown calculation method: " + std::string{method}};
+  }
+
+  options.output_calendar =
+      parseCalendar(arguments.value("calendar", "gregorian"));
+
+  std::string_view feasts{arguments.value("feasts", "pascha")};
+  while (!feasts.empty()) {
+    std::string_view name{feasts.substr(0, feasts.find(','))};
+    feasts.remove_prefix(std::min(feasts.size(), name.size() + 1));
+    auto feast{std::ranges::find_if(kFeasts, [name](const Feast& feast) {
+      return feastSlug(feast) == name;
+    })};
+    if (feast == kFeasts.end()) {
+      throw UsageError{"Unknown feast: " + std::string{name}};
+    }
+    options.target_outputs.push_back(feast->target);
+  }
+
+  if (arguments.flag("byzantine")) {
+    options.options.push_back(e_output_option::byzantine);
+  }
+  return options;
+} // calculationOptions
+
+std::vector<CalculationOptions> columnOptions(const Arguments& arguments)
+{
+  // Everything but the calendars is as for a single calculation.
+  Arguments single{arguments};
+  single.erase("calendar");
+  const CalculationOptions options{calculationOptions(single)};
+
+  std::vector<CalculationOptions> columns{};
+  std::string_view calendars{arguments.value("calendar", "gregorian")};
+  while (!calendars.empty()) {
+    std::string_view name{calendars.substr(0, calendars.find(','))};
+    calendars.remove_prefix(std::min(calendars.size(), name.size() + 1));
+    CalculationOptions column{options};
+    column.output_calendar = parseCalendar(name);
+    for (ETargetOutput target : options.target_outputs) {
+      column.target_outputs = {target};
+      columns.push_back(column);
+    }
+  }
+  return columns;
+} // columnOptions
+
+DateFormat dateFormat(const Arguments& arguments)
+{
+  std::string_view format{arguments.value("date-format", "ymd")};
+  if (format == "ymd") { return DateFormat::YMD; }
+  if (format == "mdy") { return DateFormat::MDY; }
+  if (format == "dmy") { return DateFormat::DMY; }
+  throw UsageError{"Unknown date format: " + std::string{format}};
+} // dateFormat
+
+} // namespace pascha
@@ -0,0 +1,56 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CLI_OPTIONS_H
+#define PASCHA_CLI_OPTIONS_H
+
+#include "arguments.h"
+
+#include "pascha/calculation_options.h"
+#include "pascha/date_format.h"
+#include "pascha/feasts.h"
+
+#include <string>
+#include <vector>
+
+namespace pascha
+{
+
+// The options shared by the commands which calculate dates. Each throws
+// UsageError for values it does not know.
+
+// --method julian|gregorian (default julian)
+// --calendar julian|gregorian|revised-julian (default gregorian)
+// --feasts a comma separated list of feasts (default pascha)
+// --byzantine for Byzantine years
+CalculationOptions calculationOptions(const Arguments& arguments);
+
+// As above, but with a column for each feast in each of a comma separated
+// list of calendars.
+std::vector<CalculationOptions> columnOptions(const Arguments& arguments);
+
+// --date-format ymd|mdy|dmy (default ymd)
+DateFormat dateFormat(const Arguments& arguments);
+
+} // namespace pascha
+
+#endif // !PASCHA_CLI_OPTIONS_H
@@ -0,0 +1,102 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-cli: A command line Pascha (Easter) date calculator.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "commands.h"
+#include "options.h"
+
+#include "pascha/batch.h"
+#include "pascha/pipe_io.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Bytes of input read at a time. A query must fit within it.
+constexpr std::size_t kPipeInputBytes{std::size_t{1} << 20};
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+int pipeCommand(const Arguments& arguments)
+{
+  arguments.allowOnly({"date-format", "separator", "splice"});
+
+  const std::string separator{arguments.value("separator", "-")};
+  if (separator.find('\n') != std::string::npos) {
+    throw UsageError{"The separator cannot contain a newline"};
+  }
+  BatchEvaluator evaluator{dateFormat(arguments), separator};
+  TextQueryParser parser{};
+  PipeWriter writer{kStandardOutput, PipeWriter::kDefaultBufferBytes,
+                    arguments.flag("splice")};
+  const std::size_t max_queries{writer.capacity() /
+                                evaluator.maxResultSize()};
+
+  std::vector<char> input(kPipeInputBytes);
+  std::size_t begin{0};
+  std::size_t end{0};
+  BatchQueries queries{};
+  for (bool at_end = false; !at_end;) {
+    // Keep the unfinished line, and read more after it.
+    std::memmove(input.data(), input.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    if (end == input.size()) {
+      throw std::runtime_error{"Line " + std::to_string(parser.lines() + 1) +
+                               " is too long"};
+    }
+    const std::size_t count{
+        readSome(kStandardInput, input.data() + end, input.size() - end)};
+    at_end = count == 0;
+    end += count;
+
+    // Answer every complete query read so far, so that a query is answered
+    // without waiting for more input.
+    auto answer{[&] {
+      char* results{writer.buffer()};
+      writer.write(static_cast<std::size_t>(
+          evaluator.write(queries, results) - results));
+    }};
+    do {
+      queries.clear();
+      try {
+        begin += parser.parse({input.data() + begin, end - begin}, queries,
+                              max_queries, at_end);
+      } catch (const std::runtime_error&) {
+        // Answer the queries before the one which failed.
+        if (!queries.empty()) { answer(); }
+        throw;
+      }
+      if (queries.empty()) { break; }
+      answer();
+    } while (queries.size() == max_queries);
+  }
+  return 0;
+} // pipeCommand
+
+} // namespace pascha
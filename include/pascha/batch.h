@@ -0,0 +1,221 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_BATCH_H
+#define PASCHA_BATCH_H
+
+#include "bulk_date_formatter.h"
+#include "calculation_options.h"
+#include "date.h"
+#include "date_format.h"
+#include "date_pipeline.h"
+#include "typedefs.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pascha
+{
+
+// Batches of queries, each a year and a set of calculation options, are read
+// in one of two formats.
+//
+// Text has a query per line, as five comma separated fields:
+//
+//   YEAR,METHOD,TARGET,CALENDAR,BYZANTINE
+//   2024,julian,pentecost,revised-julian,0
+//
+// where METHOD is julian or gregorian, TARGET the name of a feast as given by
+// feastSlug, CALENDAR julian, gregorian or revised-julian and BYZANTINE 0 or
+// 1. Lines may end in CR LF. Empty lines and lines starting with # are
+// skipped.
+//
+// Binary is a 16 byte header, of kBatchMagic, then kBatchFormatVersion and
+// kBatchRecordSize as little-endian 32-bit integers, followed by records of
+// kBatchRecordSize bytes, each the year as a little-endian 64-bit integer,
+// then a byte each for the ECalculationMethod, the ETargetOutput (which must
+// be a feast), the EOutputCalendar and 0 or 1 for Byzantine years, then four
+// zero bytes.
+//
+// Results of binary queries, where they are written as binary, are records of
+// kBatchResultSize bytes, each the year of the date as a little-endian 64-bit
+// integer, a byte each for its month and day, then a BatchResultStatus byte
+// and five zero bytes. Only a kBatchResultDate result holds a date.
+
+constexpr std::array<char, 8> kBatchMagic{'P', 'A', 'S', 'C', 'H', 'B', 'A',
+                                          'T'};
+constexpr std::uint32_t kBatchFormatVersion{1};
+constexpr std::size_t kBatchHeaderSize{16};
+constexpr std::size_t kBatchRecordSize{16};
+constexpr std::size_t kBatchResultSize{16};
+// Queries parsed and evaluated together.
+constexpr std::size_t kBatchChunkQueries{std::size_t{1} << 16};
+
+enum BatchResultStatus : std::uint8_t
+{
+  kBatchResultDate = 0,
+  // The date cannot be represented.
+  kBatchResultOverflow = 1,
+  // The query could not be parsed.
+  kBatchResultInvalid = 2
+}; // enum BatchResultStatus
+
+// Parsed queries, as parallel arrays.
+struct BatchQueries
+{
+  std::vector<Year> years{};
+  std::vector<OptionKey> keys{};
+
+  std::size_t size() const { return years.size(); }
+  bool empty() const { return years.empty(); }
+  void clear()
+  {
+    years.clear();
+    keys.clear();
+  }
+}; // struct BatchQueries
+
+// Parses queries in the text format, straight from the text given.
+class TextQueryParser
+{
+ public:
+  TextQueryParser();
+
+  // Append the queries on the complete lines at the start of text to
+  // queries, stopping once it holds max queries, and return the number of
+  // characters used. A last line without a newline is only parsed when
+  // at_end is set. Throws std::runtime_error, naming the line, for a query
+  // which cannot be parsed.
+  std::size_t parse(std::string_view text, BatchQueries& queries,
+                    std::size_t max, bool at_end);
+  // The number of lines parsed so far.
+  std::uint64_t lines() const { return m_lines; }
+  // Count a line which the caller handled itself, so that later lines are
+  // still numbered from the start of the text.
+  void skipLine() { ++m_lines; }
+
+ private:
+  std::vector<std::string> m_targets{};
+  std::uint64_t m_lines{0};
+
+  void parseLine(std::string_view line, BatchQueries& queries) const;
+}; // class TextQueryParser
+
+// Append the queries in the whole binary records at the start of records,
+// which follow the header, to queries, stopping once it holds max queries,
+// and return the number of bytes used. Throws std::runtime_error for a record
+// which cannot be parsed.
+std::size_t parseBinaryQueries(std::span<const std::byte> records,
+                               BatchQueries& queries, std::size_t max);
+
+// The dates of every set of options a query can hold, calculated up front
+// for a window of years, e.g. the years most queries are about. Read-only once
+// built, so one cache can be shared by any number of evaluators and threads.
+class QueryCache
+{
+ public:
+  // Throws std::invalid_argument if last < first, and std::overflow_error if
+  // a date in the window cannot be represented.
+  QueryCache(Year first, Year last);
+
+  Year first() const { return m_first; }
+  Year last() const { return m_last; }
+  // The dates of the years in the window under the options packed in the
+  // key, or nullptr if a query cannot hold them.
+  const Date* dates(OptionKey key) const;
+
+ private:
+  Year m_first;
+  Year m_last;
+  std::unordered_map<OptionKey, std::vector<Date>> m_dates{};
+}; // class QueryCache
+
+// Calculates the dates of batches of queries and writes them as text or
+// binary results.
+//
+// The queries are grouped by their options, so that each group is calculated
+// by one DatePipeline, and the dates are then written out in the order of the
+// queries. The pipelines for every set of options a query can hold are built
+// once and shared by all evaluators. Years within the window of a cache, if
+// one is given, are looked up rather than calculated.
+class BatchEvaluator
+{
+ public:
+  // The cache, if any, must outlive the evaluator.
+  explicit BatchEvaluator(DateFormat date_format = DateFormat::YMD,
+                          std::string_view date_separator = "-",
+                          const QueryCache* cache = nullptr);
+
+  // The most characters written for one query.
+  std::size_t maxResultSize() const;
+  // Write a line for each query to out, which must have room for
+  // maxResultSize() characters per query, and return the end of the text.
+  // The line holds the date or, if it cannot be represented, "error".
+  char* write(const BatchQueries& queries, char* out);
+  // Write a binary result for each query to out, which must have room for
+  // kBatchResultSize bytes per query, and return the end of the results.
+  std::byte* writeResults(const BatchQueries& queries, std::byte* out);
+
+ private:
+  BulkDateFormatter m_formatter;
+  const QueryCache* m_cache;
+  // Pipelines for keys which no parsed query holds.
+  std::unordered_map<OptionKey, DatePipeline> m_pipelines{};
+  // Scratch space, kept between batches.
+  std::unordered_map<OptionKey, std::uint32_t> m_group_of{};
+  std::vector<OptionKey> m_group_keys{};
+  std::vector<std::uint32_t> m_group_starts{};
+  std::vector<std::uint32_t> m_groups{};
+  std::vector<std::uint32_t> m_order{};
+  std::vector<Date> m_dates{};
+  std::vector<bool> m_failed{};
+
+  const DatePipeline& pipeline(OptionKey key);
+  void group(const BatchQueries& queries);
+  void evaluate(const BatchQueries& queries);
+}; // class BatchEvaluator
+
+struct BatchOptions
+{
+  DateFormat date_format{DateFormat::YMD};
+  std::string date_separator{"-"};
+}; // struct BatchOptions
+
+// Write the date of every query in the file at path to out, a line each in
+// the order of the queries. The file is mapped rather than read, and is
+// binary if it starts with kBatchMagic and text otherwise. The next chunk of
+// queries is parsed on another thread while the last is evaluated.
+//
+// Throws std::runtime_error if the file cannot be read or parsed or out
+// cannot be written; results already written are left in out.
+void evaluateBatchFile(const std::filesystem::path& path, std::ostream& out,
+                       const BatchOptions& options = {});
+
+} // namespace pascha
+
+#endif // !PASCHA_BATCH_H
@@ -0,0 +1,78 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_BULK_DATE_FORMATTER_H
+#define PASCHA_BULK_DATE_FORMATTER_H
+
+#include "date.h"
+#include "date_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace pascha
+{
+
+// Writes dates as text, in the given field order with the separator between
+// the fields and without padding, as the main window shows them. It is meant
+// for exporting many dates: digits are written two at a time from a lookup
+// table, with a fixed-width path for four-digit years, and whole batches are
+// written into one buffer. Any year, including negative years and the
+// extremes of Year, is written in full.
+class BulkDateFormatter
+{
+ public:
+  // Digits in the largest magnitude of a 64-bit integer, and a sign.
+  static constexpr std::size_t kMaxYearSize{
+      std::numeric_limits<std::uint64_t>::digits10 + 2};
+
+  BulkDateFormatter(DateFormat format, std::string_view separator);
+
+  // The most characters write() can produce for one date.
+  std::size_t maxSize() const { return m_max_size; }
+
+  // Write the date at out, which must have room for maxSize() characters.
+  // Returns the end of the text written.
+  char* write(const Date& date, char* out) const;
+
+  // Append each date to text, each followed by the terminator.
+  void append(std::span<const Date> dates, std::string& text,
+              char terminator = '\n') const;
+
+  std::string format(const Date& date) const;
+
+  // Write a year alone, which needs room for kMaxYearSize characters.
+  static char* writeYear(Year year, char* out);
+
+ private:
+  DateFormat m_format{};
+  std::string m_separator{};
+  std::size_t m_max_size{};
+
+  char* writeSeparator(char* out) const;
+}; // class BulkDateFormatter
+
+} // namespace pascha
+
+#endif // !PASCHA_BULK_DATE_FORMATTER_H
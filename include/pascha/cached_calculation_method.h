@@ -0,0 +1,59 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CACHED_CALCULATION_METHOD_H
+#define PASCHA_CACHED_CALCULATION_METHOD_H
+
+#include "calculation_method_decorator.h"
+#include "calculation_options.h"
+#include "result_cache.h"
+
+#include <memory>
+
+namespace pascha
+{
+
+// Serves dates from a ResultCache, falling back to the decorated method on a
+// miss. A miss calculates and stores the whole aligned block of years around
+// the requested one, so that neighbouring years are hits afterwards.
+//
+// The key must describe the decorated method, i.e. be the packed options from
+// which it was built.
+class CachedCalculationMethod : public CalculationMethodDecorator
+{
+ public:
+  static constexpr Year kBlockYears{256};
+
+  CachedCalculationMethod(
+      std::shared_ptr<ICalculationMethod> calculation_method,
+      ResultCache& cache, OptionKey key)
+    : CalculationMethodDecorator{calculation_method}, m_cache{&cache},
+      m_key{key} {}
+  ~CachedCalculationMethod() = default;
+  Date calculate(Year) const override;
+
+ private:
+  ResultCache* m_cache{};
+  OptionKey m_key{};
+}; // class CachedCalculationMethod
+
+} // namespace pascha
+
+#endif // !PASCHA_CACHED_CALCULATION_METHOD_H
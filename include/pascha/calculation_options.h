@@ -23,6 +23,7 @@
 
 #include "typedefs.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace pascha
@@ -98,6 +99,13 @@ enum
 
 } // namespace e_output_option
 
+// Packed form of everything in CalculationOptions except the year, used to key
+// cached and batched results. Only the first target output is packed.
+using OptionKey = std::uint32_t;
+
+OptionKey packOptions(const CalculationOptions& options);
+CalculationOptions unpackOptions(OptionKey key, Year year);
+
 } // namespace pascha
 
 #endif // !PASCHA_CALCULATION_OPTIONS_H
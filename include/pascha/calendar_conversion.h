@@ -31,6 +31,8 @@ Date gregorianToJulian(const Date& date);
 Date julianToGregorian(const Date& date);
 Date gregorianToRevJulian(const Date& date);
 Date revJulianToGregorian(const Date& date);
+// Shift a Gregorian date by the given number of days.
+Date addDays(const Date& date, CalcInt days);
 
 } // namespace pascha
 
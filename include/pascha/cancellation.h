@@ -0,0 +1,59 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CANCELLATION_H
+#define PASCHA_CANCELLATION_H
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace pascha
+{
+
+// A flag shared between the requester of a job and the job itself, which
+// checks it at convenient points and stops early once it is set. Copies share
+// the same flag.
+class CancellationToken
+{
+ public:
+  CancellationToken() : m_cancelled{std::make_shared<std::atomic<bool>>(false)}
+  {}
+
+  void cancel() const { m_cancelled->store(true, std::memory_order_relaxed); }
+  bool cancelled() const
+  {
+    return m_cancelled->load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> m_cancelled{};
+}; // class CancellationToken
+
+// Thrown by jobs which stop because they were cancelled.
+class OperationCancelled : public std::runtime_error
+{
+ public:
+  OperationCancelled() : std::runtime_error{"Calculation cancelled"} {}
+}; // class OperationCancelled
+
+} // namespace pascha
+
+#endif // !PASCHA_CANCELLATION_H
@@ -0,0 +1,101 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CLOCK_H
+#define PASCHA_CLOCK_H
+
+#include "date.h"
+#include "typedefs.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace pascha
+{
+
+// Today's date in the Gregorian calendar and its Julian Day Number.
+struct Today
+{
+  Date date;
+  CalcInt jdn;
+}; // struct Today
+
+// Source of the current date, so that calculations relative to today can be
+// tested with a fixed one.
+class IClock
+{
+ public:
+  virtual ~IClock() = default;
+  // Today's date in the Gregorian calendar, in the local time zone.
+  virtual Date today() const = 0;
+  // The Julian Day Number of today's date.
+  virtual CalcInt todayJdn() const = 0;
+  // Today's date and its Julian Day Number from one reading of the clock, so
+  // that they agree even at midnight.
+  virtual Today snapshot() const = 0;
+}; // class IClock
+
+// Reads the system clock. Today's date is worked out once and cached until
+// the next local midnight, so most calls only read the time. Safe to use from
+// several threads.
+class SystemClock : public IClock
+{
+ public:
+  SystemClock() = default;
+  SystemClock(const SystemClock&) = delete;
+  SystemClock& operator=(const SystemClock&) = delete;
+
+  Date today() const override { return current()->today.date; }
+  CalcInt todayJdn() const override { return current()->today.jdn; }
+  Today snapshot() const override { return current()->today; }
+
+ private:
+  struct CachedToday
+  {
+    Today today;
+    std::chrono::system_clock::time_point next_midnight;
+  }; // struct CachedToday
+
+  // Guarded by a mutex held only to copy or replace the pointer, as
+  // std::atomic<std::shared_ptr> is not available everywhere (e.g. libc++).
+  mutable std::shared_ptr<const CachedToday> m_today{};
+  mutable std::mutex m_mutex{};
+
+  std::shared_ptr<const CachedToday> current() const;
+}; // class SystemClock
+
+// Always gives the same date.
+class FixedClock : public IClock
+{
+ public:
+  explicit FixedClock(const Date& today);
+
+  Date today() const override { return m_today.date; }
+  CalcInt todayJdn() const override { return m_today.jdn; }
+  Today snapshot() const override { return m_today; }
+
+ private:
+  Today m_today;
+}; // class FixedClock
+
+} // namespace pascha
+
+#endif // !PASCHA_CLOCK_H
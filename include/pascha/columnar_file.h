@@ -0,0 +1,183 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_COLUMNAR_FILE_H
+#define PASCHA_COLUMNAR_FILE_H
+
+#include "calculation_options.h"
+#include "date.h"
+#include "mapped_file.h"
+#include "range_calculation.h"
+#include "typedefs.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pascha
+{
+
+// Version of the columnar file layout.
+constexpr std::uint32_t kColumnarFormatVersion{1};
+// Rows per block unless given otherwise.
+constexpr std::uint32_t kColumnarBlockRows{std::uint32_t{1} << 16};
+
+// A columnar file of Paschalion data, for analysis rather than reading.
+//
+// The file describes itself: its header is followed by the packed
+// CalculationOptions (OptionKey) of each date column. Rows, each a year and
+// one date per column, are stored in blocks. A block holds its first year,
+// the year column as the gaps between consecutive years (LEB128, minus one,
+// so that consecutive years take one zero byte) and then each date column in
+// turn, one packed date per row. An index of the blocks' years and offsets
+// ends the file, so that any block can be found and decoded without reading
+// the others. Numbers are in the byte order of the writer, which is recorded
+// in the header; files from the other byte order are rejected.
+
+// Dates are packed into 32 bits relative to the year of their row: the day in
+// the low 5 bits, the month in the next 4 and the difference between the
+// date's year and the row's year (e.g. 5508 or 5509 for Byzantine years) in
+// the remaining 23, signed. Throws std::overflow_error if the difference does
+// not fit.
+std::uint32_t packDate(Year row_year, const Date& date);
+Date unpackDate(Year row_year, std::uint32_t packed);
+
+// An entry of the block index, as laid out in the file.
+struct ColumnarIndexEntry
+{
+  std::int64_t first_year;
+  std::int64_t last_year;
+  std::uint64_t offset;
+  std::uint64_t rows;
+}; // struct ColumnarIndexEntry
+
+// Writes a columnar file. The file is only valid once finish() has been
+// called, so an interrupted write leaves a file which readers reject.
+class ColumnarWriter
+{
+ public:
+  // Throws std::runtime_error if the file cannot be created.
+  ColumnarWriter(const std::filesystem::path& path,
+                 std::vector<OptionKey> columns,
+                 std::uint32_t block_rows = kColumnarBlockRows);
+  ColumnarWriter(const ColumnarWriter&) = delete;
+  ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+  ~ColumnarWriter() = default;
+
+  // Add a row, with one date per column. Years must be strictly ascending.
+  // Throws std::invalid_argument otherwise, and std::runtime_error if writing
+  // fails.
+  void append(Year year, std::span<const Date> dates);
+  // Write the remaining rows and the index. Throws std::runtime_error if
+  // writing fails.
+  void finish();
+
+ private:
+  std::filesystem::path m_path{};
+  std::ofstream m_file{};
+  std::vector<OptionKey> m_columns{};
+  std::uint32_t m_block_rows{};
+  // The block being gathered: the year gaps, and each column in turn.
+  std::vector<std::uint8_t> m_year_gaps{};
+  std::vector<std::uint32_t> m_dates{};
+  std::uint32_t m_rows{0};
+  Year m_block_first{};
+  std::optional<Year> m_last_year{};
+  std::uint64_t m_offset{0};
+  std::uint64_t m_total_rows{0};
+  std::vector<ColumnarIndexEntry> m_index{};
+
+  void write(const void* data, std::size_t size);
+  void writeBlock();
+  void writeHeader(std::uint64_t index_offset);
+}; // class ColumnarWriter
+
+// A decoded block. The year column is only decoded if the years are not
+// consecutive; the dates are read from the mapping of the file, which must
+// outlive the block.
+class ColumnarBlock
+{
+ public:
+  // Years of consecutive blocks are left empty.
+  ColumnarBlock(Year first_year, std::size_t rows, std::vector<Year> years,
+                const std::uint32_t* dates, std::size_t columns);
+
+  std::size_t rows() const { return m_rows; }
+  Year year(std::size_t row) const;
+  // The row of the year, if there is one.
+  std::optional<std::size_t> findRow(Year year) const;
+  // The packed dates of one column, one per row.
+  std::span<const std::uint32_t> packedDates(std::size_t column) const;
+  Date date(std::size_t row, std::size_t column) const;
+
+ private:
+  Year m_first_year{};
+  std::size_t m_rows{};
+  std::vector<Year> m_years{};
+  const std::uint32_t* m_dates{nullptr};
+  std::size_t m_columns{};
+}; // class ColumnarBlock
+
+// Reads a columnar file through a read-only mapping. Only the header, column
+// list and index are read on opening.
+class ColumnarReader
+{
+ public:
+  // Throws std::runtime_error if the file cannot be mapped or is not a valid
+  // columnar file of this version and byte order.
+  explicit ColumnarReader(const std::filesystem::path& path);
+
+  std::span<const OptionKey> columns() const { return m_columns; }
+  std::size_t blockCount() const { return m_index.size(); }
+  std::uint64_t rowCount() const { return m_rows; }
+  // The years of the first and last rows; zero for an empty file.
+  Year firstYear() const;
+  Year lastYear() const;
+
+  // Throws std::out_of_range for a block which does not exist.
+  ColumnarBlock block(std::size_t index) const;
+  // The block whose years span the given year, if any.
+  std::optional<std::size_t> findBlock(Year year) const;
+  // The date in the given column for the row of the year, if there is one.
+  // Throws std::out_of_range for a column which does not exist.
+  std::optional<Date> find(Year year, std::size_t column) const;
+
+ private:
+  MappedFile m_file{};
+  std::vector<OptionKey> m_columns{};
+  std::vector<ColumnarIndexEntry> m_index{};
+  std::uint64_t m_rows{0};
+  std::uint64_t m_index_offset{0};
+}; // class ColumnarReader
+
+// Write the dates of each column of options for every year in [first, last]
+// to a columnar file. Each column's first target output must be a date, not
+// daysUntil or weeksBetween. Throws as the calculation methods and
+// ColumnarWriter do, and OperationCancelled if cancelled.
+void exportColumnar(const std::filesystem::path& path,
+                    std::span<const CalculationOptions> columns, Year first,
+                    Year last, const RangeControl& control = {});
+
+} // namespace pascha
+
+#endif // !PASCHA_COLUMNAR_FILE_H
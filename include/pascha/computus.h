@@ -0,0 +1,101 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_COMPUTUS_H
+#define PASCHA_COMPUTUS_H
+
+#include "calculation_options.h"
+#include "calendar_conversion.h"
+#include "date.h"
+#include "typedefs.h"
+
+namespace pascha
+{
+
+// The computus of each calculation method as plain functions, so that they can
+// be inlined into bulk calculations. Both return the date of Pascha in the
+// Gregorian calendar, as the corresponding ICalculationMethod does.
+
+inline Date julianPascha(Year year)
+{
+  CalcInt a = year % 4;
+  CalcInt b = year % 7;
+  CalcInt c = year % 19;
+  CalcInt d = (19 * c + 15) % 30;
+  CalcInt e = (2 * a + 4 * b - d + 34) % 7;
+  CalcInt month = (d + e + 114) / 31;
+  CalcInt day = (d + e + 114) % 31 + 1;
+  return julianToGregorian(
+      Date{year, static_cast<Month>(month), static_cast<Day>(day)});
+} // julianPascha
+
+inline Date gregorianPascha(Year year)
+{
+  CalcInt a = year % 19;
+  CalcInt b = year / 100;
+  CalcInt c = year % 100;
+  CalcInt d = b / 4;
+  CalcInt e = b % 4;
+  CalcInt f = (b + 8) / 25;
+  CalcInt g = (b - f + 1) / 3;
+  CalcInt h = (19 * a + b - d - g + 15) % 30;
+  CalcInt i = c / 4;
+  CalcInt k = c % 4;
+  CalcInt l = (32 + 2 * e + 2 * i - h - k) % 7;
+  CalcInt m = (a + 11 * h + 22 * l) / 451;
+  CalcInt month = (h + l - 7 * m + 114) / 31;
+  CalcInt day = ((h + l - 7 * m + 114) % 31) + 1;
+  return Date{year, static_cast<Month>(month), static_cast<Day>(day)};
+} // gregorianPascha
+
+// Renumber the year of a date to the Byzantine era, whose year begins on
+// September 1st.
+inline Date toByzantine(Date date)
+{
+  date.year += 5508;
+  if (date.month > 8) { ++date.year; }
+  return date;
+} // toByzantine
+
+using Computus = Date (*)(Year);
+using OutputCalendarConversion = Date (*)(const Date&);
+
+inline Computus computusFor(ECalculationMethod method)
+{
+  // Default to Julian, as the calculation methods do.
+  if (method == e_calculation_method::gregorian) { return &gregorianPascha; }
+  return &julianPascha;
+} // computusFor
+
+inline Date sameDate(const Date& date) { return date; }
+
+// Converts a Gregorian date into the given output calendar.
+inline OutputCalendarConversion outputCalendarFor(EOutputCalendar calendar)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return &sameDate;
+    case e_output_calendar::rev_julian: return &gregorianToRevJulian;
+    default: return &gregorianToJulian;
+  }
+} // outputCalendarFor
+
+} // namespace pascha
+
+#endif // !PASCHA_COMPUTUS_H
@@ -0,0 +1,78 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_COUNTDOWN_H
+#define PASCHA_COUNTDOWN_H
+
+#include "clock.h"
+#include "date.h"
+#include "feasts.h"
+#include "generator.h"
+#include "i_calculation_method.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace pascha
+{
+
+struct Countdown
+{
+  Year year;
+  Date date;
+  Days days;
+}; // struct Countdown
+
+struct FeastCountdown
+{
+  const Feast* feast;
+  Year year;
+  Date date;
+  Days days;
+}; // struct FeastCountdown
+
+// The days until each of the next count dates given by the method, starting
+// with this year's unless it has passed (today's counts as zero days). The
+// method must give dates in the Gregorian calendar, as the undecorated
+// calculation methods do. Throws std::overflow_error if a date overflows.
+std::vector<Countdown> daysUntilNext(const ICalculationMethod& method,
+                                     std::size_t count, const IClock& clock);
+
+// Lazily yield the upcoming dates of the feasts, starting today, in date order
+// across all of them; feasts on the same day come in the order given. The
+// method gives the dates of Pascha, as for daysUntilNext. Only the next date of
+// each feast is held, so memory use is constant however many are taken. The
+// method, clock and feasts must outlive the generator, and the clock is read
+// once, when iteration begins. Errors thrown by the method are rethrown from
+// the iterator. For example, the next 50 Paschas, Ascensions and Pentecosts:
+//
+//   const std::array<Feast, 3> feasts{kFeasts[0], kFeasts[6], kFeasts[7]};
+//   for (const FeastCountdown& next :
+//        upcomingFeasts(method, clock, feasts) | std::views::take(150)) {
+//     ...
+//   }
+Generator<FeastCountdown>
+    upcomingFeasts(const ICalculationMethod& method, const IClock& clock,
+                   std::span<const Feast> feasts = kFeasts);
+
+} // namespace pascha
+
+#endif // !PASCHA_COUNTDOWN_H
@@ -33,6 +33,14 @@ struct Date
   Day day;
 }; // struct Date
 
+// A date together with the year it was calculated for, which is not
+// necessarily the year of the date itself (e.g. Byzantine years).
+struct YearResult
+{
+  Year year;
+  Date date;
+}; // struct YearResult
+
 struct Weeks
 {
   std::int64_t value;
@@ -1,6 +1,6 @@
 // Copyright (C) 2022, 2024 Christopher Michael Mescher
 //
-// pascha-gui: A GUI Pascha (Easter) date calculator.
+// pascha-lib: A library for calculating the date of Pascha (Easter).
 //
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -0,0 +1,65 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_DATE_PIPELINE_H
+#define PASCHA_DATE_PIPELINE_H
+
+#include "calculation_options.h"
+#include "calendar_conversion.h"
+#include "computus.h"
+#include "date.h"
+#include "typedefs.h"
+
+namespace pascha
+{
+
+// The steps makeCalculationMethod stacks as decorators, composed once into
+// plain functions, so that a date costs no allocation or virtual calls.
+// Calculates the same dates as the method built for the same options.
+class DatePipeline
+{
+ public:
+  // Throws std::invalid_argument for weeksBetween, as makeCalculationMethod
+  // does.
+  explicit DatePipeline(const CalculationOptions& options);
+  explicit DatePipeline(OptionKey key) : DatePipeline{unpackOptions(key, 0)}
+  {
+  }
+
+  // Throws std::overflow_error if the date cannot be represented.
+  Date operator()(Year year) const
+  {
+    Date date{m_computus(year)};
+    if (m_offset != 0) { date = addDays(date, m_offset); }
+    date = m_calendar(date);
+    if (m_byzantine) { date = toByzantine(date); }
+    return date;
+  }
+
+ private:
+  Computus m_computus{&julianPascha};
+  CalcInt m_offset{0};
+  OutputCalendarConversion m_calendar{&sameDate};
+  bool m_byzantine{false};
+}; // class DatePipeline
+
+} // namespace pascha
+
+#endif // !PASCHA_DATE_PIPELINE_H
@@ -0,0 +1,56 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_DATE_STREAM_H
+#define PASCHA_DATE_STREAM_H
+
+#include "date.h"
+#include "generator.h"
+#include "i_calculation_method.h"
+#include "typedefs.h"
+
+#include <cstddef>
+
+namespace pascha
+{
+
+// Years calculated together before their dates are yielded.
+constexpr std::size_t kStreamBatchYears{256};
+
+// Lazily yield the date calculated by the method for every year in
+// [first, last], in ascending order. Dates are calculated in batches, so memory
+// use is constant however large the range. The method must outlive the
+// generator. Errors thrown by the method (e.g. std::overflow_error) are
+// rethrown from the iterator which reaches the offending year.
+//
+// For example, the first ten years after 2000 where Pascha falls in May:
+//
+//   auto may = streamDates(method, 2001, 3000) |
+//              std::views::filter([](const YearResult& r) {
+//                return r.date.month == 5;
+//              }) |
+//              std::views::take(10);
+Generator<YearResult> streamDates(const ICalculationMethod& method, Year first,
+                                  Year last,
+                                  std::size_t batch_years = kStreamBatchYears);
+
+} // namespace pascha
+
+#endif // !PASCHA_DATE_STREAM_H
@@ -0,0 +1,72 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_DIVERGENCE_H
+#define PASCHA_DIVERGENCE_H
+
+#include "typedefs.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pascha
+{
+
+// How far the Julian date of Pascha is from the Gregorian one over a range of
+// years, in whole weeks as reported by weeksBetween.
+struct DivergenceSummary
+{
+  Year first{0};
+  Year last{0};
+  std::uint64_t years{0};
+  // Years in which both methods give the same date.
+  std::uint64_t coincident{0};
+  std::int64_t total_weeks{0};
+  // The most weeks between the dates, and the first year in which it occurs.
+  std::int64_t max_weeks{0};
+  Year max_year{0};
+
+  double meanWeeks() const
+  {
+    return years > 0 ? static_cast<double>(total_weeks) /
+                           static_cast<double>(years)
+                     : 0.0;
+  }
+}; // struct DivergenceSummary
+
+// Compare the Julian and Gregorian dates of Pascha for every year in
+// [first, last] in a single pass, without calculating any dates: only the
+// difference between the two computus results and the calendars is reduced.
+// If weeks is not empty it must have a element for each year, and receives
+// the weeks between for each. Coincident years are appended to
+// coincident_years, if given.
+//
+// Throws std::invalid_argument if last < first or weeks is the wrong size,
+// and std::overflow_error if the range includes years for which the dates
+// cannot be calculated.
+DivergenceSummary analyseDivergence(Year first, Year last,
+                                    std::span<std::int64_t> weeks = {},
+                                    std::vector<Year>* coincident_years =
+                                        nullptr);
+
+} // namespace pascha
+
+#endif // !PASCHA_DIVERGENCE_H
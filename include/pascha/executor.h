@@ -0,0 +1,105 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_EXECUTOR_H
+#define PASCHA_EXECUTOR_H
+
+#include "cancellation.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace pascha
+{
+
+// Runs the given function on whichever thread should receive notifications,
+// e.g. by posting it to a GUI event loop. The function must be run exactly
+// once.
+using Dispatcher = std::function<void(std::function<void()>)>;
+
+// Called once a job's notifications have all been delivered.
+using Completion = std::function<void()>;
+
+// Handle to a job submitted to an executor.
+class JobHandle
+{
+ public:
+  JobHandle() = default;
+  JobHandle(std::shared_future<void> future, CancellationToken cancellation)
+    : m_future{std::move(future)}, m_cancellation{std::move(cancellation)} {}
+
+  bool valid() const { return m_future.valid(); }
+  bool ready() const
+  {
+    return m_future.valid() && m_future.wait_for(std::chrono::seconds{0}) ==
+                                   std::future_status::ready;
+  }
+  // Block until the job has run. Notifications delivered through a dispatcher
+  // may still be pending.
+  void wait() const
+  {
+    if (m_future.valid()) { m_future.wait(); }
+  }
+  // Ask the job to stop. A job which has not started yet will not calculate
+  // anything; a running one stops at its next check.
+  void cancel() const { m_cancellation.cancel(); }
+  bool cancelled() const { return m_cancellation.cancelled(); }
+
+ private:
+  std::shared_future<void> m_future{};
+  CancellationToken m_cancellation{};
+}; // class JobHandle
+
+// Runs jobs one at a time on a background thread, in the order they were
+// submitted.
+class SerialExecutor
+{
+ public:
+  SerialExecutor();
+  SerialExecutor(const SerialExecutor&) = delete;
+  SerialExecutor(SerialExecutor&&) = delete;
+  SerialExecutor& operator=(const SerialExecutor&) = delete;
+  SerialExecutor& operator=(SerialExecutor&&) = delete;
+  // Waits for the running job; jobs still queued are abandoned.
+  ~SerialExecutor();
+
+  // The token is attached to the returned handle; checking it is up to the
+  // job.
+  JobHandle submit(std::function<void()> job,
+                   CancellationToken cancellation = {});
+
+ private:
+  std::mutex m_mutex{};
+  std::condition_variable m_wake{};
+  std::deque<std::packaged_task<void()>> m_jobs{};
+  bool m_stop{false};
+  std::thread m_thread{};
+
+  void workerLoop();
+}; // class SerialExecutor
+
+} // namespace pascha
+
+#endif // !PASCHA_EXECUTOR_H
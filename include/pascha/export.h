@@ -0,0 +1,79 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_EXPORT_H
+#define PASCHA_EXPORT_H
+
+#include "calculation_options.h"
+#include "date_format.h"
+#include "range_calculation.h"
+#include "typedefs.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace pascha
+{
+
+enum class ExportFormat
+{
+  csv,
+  jsonLines,
+}; // enum class ExportFormat
+
+// Bytes of text gathered before they are written out.
+constexpr std::size_t kDefaultFlushBytes{std::size_t{1} << 20};
+
+struct ExportOptions
+{
+  // One column per target output, each of which must be a feast in kFeasts,
+  // in the calculation method and output calendar given. The year is ignored.
+  CalculationOptions calculation{e_calculation_method::julian,
+                                 {e_target_output::pascha},
+                                 e_output_calendar::gregorian,
+                                 {},
+                                 0};
+  ExportFormat format{ExportFormat::csv};
+  DateFormat date_format{DateFormat::YMD};
+  std::string date_separator{"-"};
+  std::size_t flush_bytes{kDefaultFlushBytes};
+}; // struct ExportOptions
+
+// Write a row for every year in [first, last], holding the year and the date
+// of each target output, to out. CSV starts with a header row naming the
+// feasts; JSON Lines writes one object per year, keyed by the same names.
+//
+// Rows are gathered in a buffer of flush_bytes, which is written by another
+// thread while the next buffer is filled, so memory use is bounded however
+// long the range. Cancellation is checked and progress is reported between
+// buffers.
+//
+// Throws std::invalid_argument if last < first, a target output is not a
+// feast or the separator contains a character needing quoting, and
+// std::overflow_error if a date overflows. Throws std::runtime_error if
+// writing fails, and OperationCancelled if cancelled; rows already written
+// are left in out.
+void exportRange(const ExportOptions& options, Year first, Year last,
+                 std::ostream& out, const RangeControl& control = {});
+
+} // namespace pascha
+
+#endif // !PASCHA_EXPORT_H
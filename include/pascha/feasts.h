@@ -0,0 +1,73 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_FEASTS_H
+#define PASCHA_FEASTS_H
+
+#include "calculation_options.h"
+#include "typedefs.h"
+
+#include <array>
+#include <cctype>
+#include <string>
+#include <string_view>
+
+namespace pascha
+{
+
+// A moveable feast, which falls a fixed number of days from Pascha.
+struct Feast
+{
+  ETargetOutput target;
+  std::string_view name;
+  CalcInt offset;
+}; // struct Feast
+
+// Every feast which has a target output, in the order of the target outputs.
+// The offsets match the TargetDate decorators.
+inline constexpr std::array<Feast, 8> kFeasts{{
+    {e_target_output::pascha, "Pascha", 0},
+    {e_target_output::meatfare, "Meatfare", -56},
+    {e_target_output::cheesefare, "Cheesefare", -49},
+    {e_target_output::ashWednesday, "Ash Wednesday", -46},
+    {e_target_output::midfeastPentecost, "Midfeast of Pentecost", 24},
+    {e_target_output::leavetakingPascha, "Leavetaking of Pascha", 38},
+    {e_target_output::ascension, "Ascension", 39},
+    {e_target_output::pentecost, "Pentecost", 49},
+}};
+
+// The feast's name in lower case with hyphens for spaces, e.g.
+// "ash-wednesday", for use in identifiers and on command lines.
+inline std::string feastSlug(const Feast& feast)
+{
+  std::string slug{feast.name};
+  for (char& c : slug) {
+    if (c == ' ') {
+      c = '-';
+    } else {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+  return slug;
+} // feastSlug
+
+} // namespace pascha
+
+#endif // !PASCHA_FEASTS_H
@@ -0,0 +1,139 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_GENERATOR_H
+#define PASCHA_GENERATOR_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+namespace pascha
+{
+
+// A lazily evaluated sequence produced by a coroutine using co_yield, in the
+// manner of C++23's std::generator. It is a move-only input view, so it can be
+// used in range-based for loops and piped into std::views adaptors. It may
+// only be iterated once.
+template <typename T>
+class Generator : public std::ranges::view_base
+{
+ public:
+  struct promise_type
+  {
+    const T* value{nullptr};
+    std::exception_ptr error{};
+
+    Generator get_return_object()
+    {
+      using Handle = std::coroutine_handle<promise_type>;
+      return Generator{Handle::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    // The yielded object outlives the suspension, so it is not copied.
+    std::suspend_always yield_value(const T& yielded) noexcept
+    {
+      value = std::addressof(yielded);
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() { error = std::current_exception(); }
+    // Generators only yield; they do not await.
+    template <typename U>
+    std::suspend_never await_transform(U&&) = delete;
+  }; // struct promise_type
+
+  class iterator
+  {
+   public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(std::coroutine_handle<promise_type> coroutine)
+        : m_coroutine{coroutine} {}
+
+    const T& operator*() const { return *m_coroutine.promise().value; }
+    const T* operator->() const { return m_coroutine.promise().value; }
+    iterator& operator++()
+    {
+      advance(m_coroutine);
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const
+    {
+      return !m_coroutine || m_coroutine.done();
+    }
+
+   private:
+    std::coroutine_handle<promise_type> m_coroutine{};
+  }; // class iterator
+
+  Generator() = default;
+  Generator(const Generator&) = delete;
+  Generator(Generator&& other) noexcept
+    : m_coroutine{std::exchange(other.m_coroutine, nullptr)} {}
+  Generator& operator=(const Generator&) = delete;
+  Generator& operator=(Generator&& other) noexcept
+  {
+    if (this != &other) {
+      if (m_coroutine) { m_coroutine.destroy(); }
+      m_coroutine = std::exchange(other.m_coroutine, nullptr);
+    }
+    return *this;
+  }
+  ~Generator()
+  {
+    if (m_coroutine) { m_coroutine.destroy(); }
+  }
+
+  // Runs the coroutine up to its first co_yield.
+  iterator begin()
+  {
+    if (m_coroutine) { advance(m_coroutine); }
+    return iterator{m_coroutine};
+  }
+  std::default_sentinel_t end() const noexcept { return {}; }
+
+ private:
+  std::coroutine_handle<promise_type> m_coroutine{};
+
+  explicit Generator(std::coroutine_handle<promise_type> coroutine)
+    : m_coroutine{coroutine} {}
+
+  // Resume the coroutine, rethrowing anything it threw.
+  static void advance(std::coroutine_handle<promise_type> coroutine)
+  {
+    coroutine.resume();
+    if (coroutine.promise().error) {
+      std::rethrow_exception(std::exchange(coroutine.promise().error, nullptr));
+    }
+  }
+}; // class Generator
+
+} // namespace pascha
+
+#endif // !PASCHA_GENERATOR_H
@@ -21,10 +21,13 @@
 #ifndef PASCHA_I_CALCULATOR_MODEL_H
 #define PASCHA_I_CALCULATOR_MODEL_H
 
+#include "clock.h"
+#include "executor.h"
 #include "i_calculation_method.h"
 #include "i_observable.h"
 #include "typedefs.h"
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 
@@ -37,6 +40,9 @@ class ICalculatorModel : public IObservable
   virtual ~ICalculatorModel() = default;
   virtual void setCalculationMethod(std::unique_ptr<ICalculationMethod>) = 0;
   virtual void calculate(Year) const = 0;
+  // Calculate every year in the given inclusive range, notifying the results
+  // in batches of consecutive years.
+  virtual void calculateRange(Year first, Year last) const = 0;
   // Calculate the number of days until Pascha in the given year.
   virtual void daysUntil(Year) const = 0;
   // Calculate the number of days between the dates calculated by the two
@@ -44,6 +50,28 @@ class ICalculatorModel : public IObservable
   // Gregorian methods for calculating Pascha.
   virtual void weeksBetween(Year, std::unique_ptr<ICalculationMethod>,
                             std::unique_ptr<ICalculationMethod>) const = 0;
+
+  // Asynchronous variants of the above. The calculation runs on a background
+  // thread, using the calculation method set when the job was submitted. Its
+  // notifications, followed by the completion, are delivered through the
+  // dispatcher. Jobs run in the order they were submitted. Cancelling a job
+  // through its handle suppresses any notifications not yet delivered, but
+  // not the completion. A calculation that throws notifies its error message
+  // instead, and is still completed. Range jobs also notify their progress.
+  virtual JobHandle calculateAsync(Year, Completion = {}) const = 0;
+  virtual JobHandle calculateRangeAsync(Year first, Year last,
+                                        Completion = {}) const = 0;
+  virtual JobHandle daysUntilAsync(Year, Completion = {}) const = 0;
+  virtual JobHandle weeksBetweenAsync(Year, std::unique_ptr<ICalculationMethod>,
+                                      std::unique_ptr<ICalculationMethod>,
+                                      Completion = {}) const = 0;
+  // Set how asynchronous notifications reach the observers. Without a
+  // dispatcher they are made directly from the background thread.
+  virtual void setDispatcher(Dispatcher) = 0;
+  // The number of dates calculated so far, by any of the above.
+  virtual std::uint64_t calculationCount() const = 0;
+  // The clock from which days until are counted.
+  virtual const IClock& clock() const = 0;
 }; // class ICalculatorModel
 
 } // namespace pascha
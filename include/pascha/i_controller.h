@@ -24,6 +24,7 @@
 #include "calculation_options.h"
 #include "i_calculator_model.h"
 #include "i_view.h"
+#include "latency_histogram.h"
 
 namespace pascha
 {
@@ -34,12 +35,17 @@ class IController
   virtual ~IController() = default;
   // Calculate the output using the model with the given options.
   virtual void calculate(const CalculationOptions& options) const = 0;
+  // Cancel the calculation in progress, if any, and return whether there was
+  // one.
+  virtual bool cancel() = 0;
   // Add a view to the controller.
   virtual void addView(IView&) = 0;
   // Remove a view from the controller.
   virtual void removeView(IView&) = 0;
   // Start the view.
   virtual void start() = 0;
+  // Time taken from calculation requests to their results being notified.
+  virtual const LatencyHistogram& latency() const = 0;
 }; // class IController
 
 } // namespace pascha
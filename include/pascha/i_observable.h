@@ -21,10 +21,12 @@
 #ifndef PASCHA_I_OBSERVABLE_H
 #define PASCHA_I_OBSERVABLE_H
 
+#include <span>
 #include <string_view>
 
 #include "date.h"
 #include "i_observer.h"
+#include "progress.h"
 
 namespace pascha
 {
@@ -43,6 +45,14 @@ class IObservable
   virtual void notify(Days) const = 0;
   // Used to notify string messages, such as errors.
   virtual void notify(std::string_view) const = 0;
+  // Used to notify a batch of date outputs for consecutive years from the
+  // model. By default each date is notified separately.
+  virtual void notify(std::span<const YearResult> results) const
+  {
+    for (const YearResult& result : results) { notify(result.date); }
+  }
+  // Used to notify the progress of long-running calculations.
+  virtual void notify(const Progress&) const = 0;
 }; // class IObservable
 
 } // namespace pascha
@@ -22,7 +22,9 @@
 #define PASCHA_I_OBSERVER_H
 
 #include "date.h"
+#include "progress.h"
 
+#include <span>
 #include <string_view>
 
 namespace pascha
@@ -40,6 +42,15 @@ class IObserver
   virtual void update(Days) = 0;
   // Used to receive string messages, such as errors.
   virtual void update(std::string_view) = 0;
+  // Used to receive a batch of date outputs for consecutive years (e.g. from
+  // the model). By default each date is received separately.
+  virtual void update(std::span<const YearResult> results)
+  {
+    for (const YearResult& result : results) { update(result.date); }
+  }
+  // Used to receive the progress of long-running calculations. Ignored by
+  // default.
+  virtual void update(const Progress&) {}
 }; // class IObserver
 
 } // namespace pascha
@@ -0,0 +1,79 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_ICALENDAR_H
+#define PASCHA_ICALENDAR_H
+
+#include "calculation_options.h"
+#include "date_format.h"
+#include "range_calculation.h"
+#include "typedefs.h"
+
+#include <ostream>
+#include <string>
+
+namespace pascha
+{
+
+// The range of years iCalendar dates can hold.
+constexpr Year kICalendarFirstYear{1};
+constexpr Year kICalendarLastYear{9999};
+
+struct ICalendarOptions
+{
+  // An event for each target output, each of which must be a feast in
+  // kFeasts; none means every feast. The year is ignored.
+  CalculationOptions calculation{e_calculation_method::julian,
+                                 {},
+                                 e_output_calendar::gregorian,
+                                 {},
+                                 0};
+  // How the date in the output calendar is written in the description of
+  // each event.
+  DateFormat date_format{DateFormat::YMD};
+  // The DTSTAMP of every event, as a UTC date-time such as
+  // "20240101T000000Z". Empty uses the current time.
+  std::string timestamp{};
+}; // struct ICalendarOptions
+
+// Write an iCalendar (RFC 5545) calendar to out holding an all-day event for
+// each feast in each year in [first, last], in date order within each year.
+//
+// Calendar software only knows the civil Gregorian calendar, so each event is
+// placed on the Gregorian date the feast falls on. When the output calendar
+// is not Gregorian, or Byzantine years are asked for, the date in the output
+// calendar is given in the event's description. Each event has a UID made of
+// the year, the feast and the calculation method, so importing the calendar
+// again updates the events rather than adding new ones.
+//
+// The text of each event other than its year and dates is rendered once, and
+// the calendar is written out in large blocks. Cancellation is checked and
+// progress is reported every few thousand years.
+//
+// Throws std::invalid_argument if last < first or a target output is not a
+// feast, std::out_of_range if a year is outside [kICalendarFirstYear,
+// kICalendarLastYear], std::runtime_error if writing fails, and
+// OperationCancelled if cancelled.
+void writeICalendar(const ICalendarOptions& options, Year first, Year last,
+                    std::ostream& out, const RangeControl& control = {});
+
+} // namespace pascha
+
+#endif // !PASCHA_ICALENDAR_H
@@ -0,0 +1,75 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_LATENCY_HISTOGRAM_H
+#define PASCHA_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace pascha
+{
+
+// A histogram of latencies with logarithmic buckets, each a sixteenth of a
+// power of two wide, so that any percentile is accurate to within about 6%.
+// Latencies may be recorded from any thread without locking.
+class LatencyHistogram
+{
+ public:
+  using Duration = std::chrono::nanoseconds;
+
+  LatencyHistogram() = default;
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  // Record the same latency count times, e.g. for requests answered
+  // together.
+  void record(Duration latency, std::uint64_t count = 1);
+  void reset();
+
+  std::uint64_t count() const;
+  Duration max() const;
+  Duration mean() const;
+  // The latency below which the given fraction (0 to 1) of recorded latencies
+  // fall, rounded up to the top of its bucket. Zero if nothing is recorded.
+  Duration percentile(double fraction) const;
+
+ private:
+  // Latencies below 2^kSubBucketBits nanoseconds have a bucket each.
+  static constexpr unsigned kSubBucketBits{4};
+  static constexpr std::size_t kSubBuckets{std::size_t{1} << kSubBucketBits};
+  static constexpr std::size_t kBuckets{kSubBuckets *
+                                        (64 - kSubBucketBits + 1)};
+
+  std::array<std::atomic<std::uint64_t>, kBuckets> m_buckets{};
+  std::atomic<std::uint64_t> m_count{0};
+  std::atomic<std::uint64_t> m_total{0};
+  std::atomic<std::uint64_t> m_max{0};
+
+  static std::size_t bucketOf(std::uint64_t nanoseconds);
+  static std::uint64_t bucketTop(std::size_t bucket);
+}; // class LatencyHistogram
+
+} // namespace pascha
+
+#endif // !PASCHA_LATENCY_HISTOGRAM_H
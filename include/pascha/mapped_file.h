@@ -0,0 +1,63 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_MAPPED_FILE_H
+#define PASCHA_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace pascha
+{
+
+// A read-only memory mapping of a whole file. The mapping stays valid until the
+// object is destroyed or reassigned; changes made to the file afterwards are
+// only guaranteed to be visible after mapping it again.
+class MappedFile
+{
+ public:
+  MappedFile() = default;
+  // Throws std::runtime_error if the file cannot be opened or mapped.
+  explicit MappedFile(const std::filesystem::path& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) noexcept;
+  ~MappedFile();
+
+  const std::byte* data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  std::span<const std::byte> bytes() const { return {m_data, m_size}; }
+
+ private:
+  const std::byte* m_data{nullptr};
+  std::size_t m_size{0};
+#ifdef _WIN32
+  void* m_mapping{nullptr};
+#endif
+
+  void unmap();
+}; // class MappedFile
+
+} // namespace pascha
+
+#endif // !PASCHA_MAPPED_FILE_H
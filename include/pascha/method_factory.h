@@ -0,0 +1,42 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_METHOD_FACTORY_H
+#define PASCHA_METHOD_FACTORY_H
+
+#include "calculation_options.h"
+#include "i_calculation_method.h"
+
+#include <memory>
+
+namespace pascha
+{
+
+// Build the calculation method, with its target date, output calendar and
+// output option decorators, for the first target output in the options.
+// For daysUntil only the undecorated Pascha method is built, since the number
+// of days is counted in the Gregorian calendar. Throws std::invalid_argument
+// for weeksBetween, which compares two methods rather than calculating a date.
+std::unique_ptr<ICalculationMethod>
+    makeCalculationMethod(const CalculationOptions& options);
+
+} // namespace pascha
+
+#endif // !PASCHA_METHOD_FACTORY_H
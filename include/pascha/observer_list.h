@@ -0,0 +1,82 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_OBSERVER_LIST_H
+#define PASCHA_OBSERVER_LIST_H
+
+#include "i_observer.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pascha
+{
+
+// A copy-on-write list of observers. Notifying threads take an immutable
+// snapshot, holding a lock only while copying its pointer, and iterate it
+// without the lock; adding or removing an observer copies the list and
+// publishes the copy, so registration may race with any number of notifying
+// threads.
+//
+// A removed observer may still receive notifications which were already in
+// progress when it was removed, so it must not be destroyed until they have
+// finished (e.g. by notifying and unregistering on the same thread).
+class ObserverList
+{
+ public:
+  using Snapshot = std::shared_ptr<const std::vector<IObserver*>>;
+
+  ObserverList() : m_observers{std::make_shared<std::vector<IObserver*>>()} {}
+  ObserverList(const ObserverList&) = delete;
+  ObserverList& operator=(const ObserverList&) = delete;
+
+  void add(IObserver& observer);
+  void remove(IObserver& observer);
+  Snapshot snapshot() const
+  {
+    std::lock_guard lock{m_snapshot_mutex};
+    return m_observers;
+  }
+  std::size_t size() const { return snapshot()->size(); }
+
+  // Call the function with each observer in the current snapshot.
+  template <typename Function>
+  void forEach(Function&& function) const
+  {
+    Snapshot observers{snapshot()};
+    for (IObserver* observer : *observers) { function(*observer); }
+  }
+
+ private:
+  // std::atomic<std::shared_ptr> is not available everywhere (e.g. libc++),
+  // so the pointer is guarded by a mutex held only to copy or replace it.
+  Snapshot m_observers;
+  mutable std::mutex m_snapshot_mutex{};
+  // Serialises writers, so that concurrent changes are not lost.
+  std::mutex m_write_mutex{};
+
+  void publish(Snapshot observers);
+}; // class ObserverList
+
+} // namespace pascha
+
+#endif // !PASCHA_OBSERVER_LIST_H
@@ -21,8 +21,21 @@
 #ifndef PASCHA_PASCHA_CALCULATOR_MODEL_H
 #define PASCHA_PASCHA_CALCULATOR_MODEL_H
 
+#include "clock.h"
 #include "i_calculator_model.h"
+#include "observer_list.h"
+#include "range_calculation.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <variant>
 #include <vector>
 
 namespace pascha
@@ -31,7 +44,13 @@ namespace pascha
 class PaschaCalculatorModel : public ICalculatorModel
 {
  public:
-  PaschaCalculatorModel() = default;
+  // Years per batch notified by calculateRange.
+  static constexpr std::size_t kNotifyBatchYears{4096};
+
+  // Days until are counted from today according to the clock, which is the
+  // system clock by default.
+  PaschaCalculatorModel();
+  explicit PaschaCalculatorModel(std::shared_ptr<const IClock> clock);
   PaschaCalculatorModel(const PaschaCalculatorModel&) = delete;
   PaschaCalculatorModel(PaschaCalculatorModel&&) = delete;
   PaschaCalculatorModel& operator=(const PaschaCalculatorModel&) = delete;
@@ -41,19 +60,84 @@ class PaschaCalculatorModel : public ICalculatorModel
   virtual void
       setCalculationMethod(std::unique_ptr<ICalculationMethod>) override;
   virtual void calculate(Year) const override;
+  // The range is calculated in parallel, so the calculation method must be
+  // safe to call concurrently. Batches are notified in ascending order from
+  // the calling thread.
+  virtual void calculateRange(Year first, Year last) const override;
   virtual void daysUntil(Year) const override;
   virtual void weeksBetween(Year, std::unique_ptr<ICalculationMethod>,
                             std::unique_ptr<ICalculationMethod>) const override;
+  virtual JobHandle calculateAsync(Year, Completion = {}) const override;
+  virtual JobHandle calculateRangeAsync(Year first, Year last,
+                                        Completion = {}) const override;
+  virtual JobHandle daysUntilAsync(Year, Completion = {}) const override;
+  virtual JobHandle
+      weeksBetweenAsync(Year, std::unique_ptr<ICalculationMethod>,
+                        std::unique_ptr<ICalculationMethod>,
+                        Completion = {}) const override;
+  // Must not be changed while asynchronous jobs are pending.
+  virtual void setDispatcher(Dispatcher) override;
+  virtual std::uint64_t calculationCount() const override;
+  virtual const IClock& clock() const override { return *m_clock; }
+  // Observers may be added and removed from any thread, concurrently with
+  // notifications.
   virtual void addObserver(IObserver&) override;
   virtual void removeObserver(IObserver&) override;
   virtual void notify(const Date&) const override;
   virtual void notify(Weeks) const override;
   virtual void notify(Days) const override;
   virtual void notify(std::string_view) const override;
+  virtual void notify(std::span<const YearResult>) const override;
+  virtual void notify(const Progress&) const override;
 
  private:
-  std::unique_ptr<ICalculationMethod> m_calculation_method{nullptr};
-  std::vector<IObserver*> m_observers{};
+  // The result of a single calculation, or an error message.
+  using Outcome = std::variant<Date, Weeks, Days, std::string>;
+  using Batch = std::vector<YearResult>;
+
+  // What an asynchronous range job has calculated but not yet delivered. At
+  // most one delivery is dispatched at a time; whatever the job calculates
+  // meanwhile is merged into it, so a busy dispatcher receives fewer, larger
+  // batches rather than an ever longer queue.
+  struct PendingRange
+  {
+    std::mutex mutex{};
+    Batch results{};
+    // Only the latest progress is of interest.
+    std::optional<Progress> progress{};
+    std::vector<std::string> messages{};
+    bool scheduled{false};
+  }; // struct PendingRange
+
+  // Shared with any pending asynchronous jobs.
+  std::shared_ptr<ICalculationMethod> m_calculation_method{nullptr};
+  std::shared_ptr<const IClock> m_clock{};
+  ObserverList m_observers{};
+  Dispatcher m_dispatcher{};
+  mutable std::atomic<std::uint64_t> m_calculations{0};
+  // Created on the first range calculation.
+  mutable std::unique_ptr<WorkStealingPool> m_pool{nullptr};
+  mutable std::mutex m_pool_mutex{};
+  // Created on the first asynchronous job. Declared last, so that it is
+  // destroyed, finishing the running job, before anything the job uses.
+  mutable std::unique_ptr<SerialExecutor> m_executor{nullptr};
+
+  void notifyOutcome(const Outcome&) const;
+  // Calculate the range, passing each batch and any error message on. Stops
+  // silently if cancelled.
+  void forEachBatch(const ICalculationMethod&, Year first, Year last,
+                    const RangeControl& control,
+                    const std::function<void(Batch&)>& on_batch,
+                    const std::function<void(std::string)>& on_error) const;
+  // Add to what is pending under its lock, dispatching a delivery unless one
+  // is already pending.
+  void post(const std::shared_ptr<PendingRange>&,
+            const CancellationToken& cancellation,
+            const std::function<void(PendingRange&)>& add) const;
+  JobHandle submit(std::function<void()> job,
+                   CancellationToken cancellation) const;
+  // Run the function on the dispatcher, or directly if there is none.
+  void dispatch(std::function<void()> function) const;
 }; // class PaschaCalculatorModel
 
 } // namespace pascha
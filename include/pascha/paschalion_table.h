@@ -0,0 +1,94 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PASCHALION_TABLE_H
+#define PASCHA_PASCHALION_TABLE_H
+
+#include "calculation_options.h"
+#include "date.h"
+#include "i_calculation_method.h"
+#include "typedefs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace pascha
+{
+
+// A table of dates with a row for each year in a range and a column for each
+// set of calculation options, e.g. Pascha and the moveable feasts in one
+// calendar. Rows are calculated on demand a block at a time, and only a few
+// blocks are kept, so memory use and the cost of a lookup do not depend on
+// the size of the range. Not thread-safe.
+class PaschalionTable
+{
+ public:
+  // Rows calculated together.
+  static constexpr std::uint64_t kBlockRows{256};
+  // Blocks kept; the least recently used is recalculated when needed again.
+  static constexpr std::size_t kCachedBlocks{8};
+  // Rows in a table at most, as many as a list control can show. A longer
+  // range is cut short.
+  static constexpr std::uint64_t kMaxRows{
+      static_cast<std::uint64_t>(std::numeric_limits<long>::max())};
+
+  // Throws std::invalid_argument if last < first, or if a column cannot be
+  // built by makeCalculationMethod.
+  PaschalionTable(const std::vector<CalculationOptions>& columns, Year first,
+                  Year last);
+
+  std::uint64_t rowCount() const { return m_rows; }
+  std::size_t columnCount() const { return m_methods.size(); }
+  Year year(std::uint64_t row) const
+  {
+    return static_cast<Year>(static_cast<std::uint64_t>(m_first) + row);
+  }
+  // The date in the given row and column, or nothing if it overflows.
+  std::optional<Date> date(std::uint64_t row, std::size_t column) const;
+  // Calculate the blocks covering the given rows, and the block after them,
+  // ahead of their being shown. At most kCachedBlocks - 1 blocks are kept.
+  void prefetch(std::uint64_t first_row, std::uint64_t last_row) const;
+
+ private:
+  struct Block
+  {
+    std::uint64_t index{0};
+    std::uint64_t last_used{0};
+    // Row-major, kBlockRows by columnCount().
+    std::vector<std::optional<Date>> dates{};
+  }; // struct Block
+
+  std::vector<std::unique_ptr<ICalculationMethod>> m_methods{};
+  Year m_first{0};
+  std::uint64_t m_rows{0};
+  mutable std::vector<Block> m_blocks{};
+  mutable std::uint64_t m_uses{0};
+
+  const Block& block(std::uint64_t index) const;
+  void fill(Block& block) const;
+}; // class PaschalionTable
+
+} // namespace pascha
+
+#endif // !PASCHA_PASCHALION_TABLE_H
@@ -0,0 +1,111 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PIPE_IO_H
+#define PASCHA_PIPE_IO_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace pascha
+{
+
+constexpr int kStandardInput{0};
+constexpr int kStandardOutput{1};
+
+// Read up to size bytes from the file descriptor into data, waiting for at
+// least one unless at the end of the input. Returns the number read, which
+// is zero only at the end. Throws std::runtime_error if reading fails.
+std::size_t readSome(int fd, char* data, std::size_t size);
+
+// Writes to a file descriptor from large buffers, which are filled in place.
+//
+// When splicing is asked for and the descriptor is a pipe on Linux, each
+// buffer is page-aligned and handed to the pipe with vmsplice, so the kernel
+// references its pages rather than copying them. Since the reader sees those
+// pages, a buffer is only filled again once the pipe holds fewer unread bytes
+// than were written after it, i.e. once the reader has taken all of it; until
+// then output goes through a separate buffer which is copied with write.
+// Anything else, or a pipe which refuses vmsplice, is written with write.
+//
+// A reader which passes the pages on with splice or tee, rather than reading
+// them, still holds them once they leave this pipe, and would see them
+// overwritten, so splicing is only for readers known to read their input.
+class PipeWriter
+{
+ public:
+  static constexpr std::size_t kDefaultBufferBytes{std::size_t{1} << 20};
+
+  // The buffer size is rounded up to whole pages. A pipe is asked to grow to
+  // hold a whole buffer. Without allow_splice, write is always used. Throws
+  // std::bad_alloc if the buffers cannot be mapped.
+  explicit PipeWriter(int fd, std::size_t buffer_bytes = kDefaultBufferBytes,
+                      bool allow_splice = false);
+  PipeWriter(const PipeWriter&) = delete;
+  PipeWriter& operator=(const PipeWriter&) = delete;
+  ~PipeWriter();
+
+  // Whether buffers are currently handed to the pipe rather than copied.
+  bool splicing() const { return m_splicing; }
+  std::size_t capacity() const { return m_capacity; }
+
+  // A buffer of capacity() bytes to fill, valid until the next write.
+  char* buffer();
+  // Write out the first size bytes of the last buffer. Throws
+  // std::runtime_error if writing fails.
+  void write(std::size_t size);
+
+ private:
+  // Buffers handed to the pipe in turn.
+  static constexpr std::size_t kSpliceBuffers{4};
+
+  // Buffers are mapped rather than taken from the heap, so that pages still
+  // in the pipe once they are unmapped are never handed out again.
+  struct UnmapBuffer
+  {
+    std::size_t size;
+    void operator()(char* data) const;
+  }; // struct UnmapBuffer
+  using Buffer = std::unique_ptr<char[], UnmapBuffer>;
+
+  int m_fd;
+  std::size_t m_capacity;
+  bool m_splicing{false};
+  std::array<Buffer, kSpliceBuffers> m_spliced{};
+  // Bytes written to the pipe once each spliced buffer had been written.
+  std::array<std::uint64_t, kSpliceBuffers> m_written_after{};
+  std::array<bool, kSpliceBuffers> m_in_pipe{};
+  std::size_t m_next{0};
+  Buffer m_copied;
+  // The buffer last returned by buffer(), or kSpliceBuffers for m_copied.
+  std::size_t m_current{kSpliceBuffers};
+  // Every byte written so far.
+  std::uint64_t m_written{0};
+
+  bool consumed(std::size_t index) const;
+  void splice(const char* data, std::size_t size);
+  void copy(const char* data, std::size_t size);
+}; // class PipeWriter
+
+} // namespace pascha
+
+#endif // !PASCHA_PIPE_IO_H
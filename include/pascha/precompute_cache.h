@@ -0,0 +1,91 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PRECOMPUTE_CACHE_H
+#define PASCHA_PRECOMPUTE_CACHE_H
+
+#include "calculation_options.h"
+#include "date.h"
+#include "executor.h"
+#include "typedefs.h"
+
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pascha
+{
+
+// Speculatively calculates the dates in a window of years around a position,
+// for several variants of the calculation options, on a background thread.
+// Stepping through neighbouring years can then be served from the cache
+// without calculating anything.
+//
+// Each variant is calculated with the method built by makeCalculationMethod,
+// so weeksBetween variants are not supported. Years which cannot be
+// calculated are left out of the cache.
+class PrecomputeCache
+{
+ public:
+  // Years calculated either side of the position.
+  static constexpr Year kDefaultRadius{256};
+
+  explicit PrecomputeCache(Year radius = kDefaultRadius) : m_radius{radius} {}
+  PrecomputeCache(const PrecomputeCache&) = delete;
+  PrecomputeCache& operator=(const PrecomputeCache&) = delete;
+  ~PrecomputeCache() { m_job.cancel(); }
+
+  // The date already calculated for the options packed in the key, if any.
+  // Safe to call while a window is being calculated.
+  std::optional<Date> find(OptionKey key, Year year) const;
+  // Move the window to the given year, calculating its years nearest first
+  // for each variant (whose own years are ignored). Speculation for an
+  // earlier position is cancelled, and dates far outside the new window are
+  // dropped. Does nothing while the position stays well within the window
+  // already requested for the same variants.
+  JobHandle recentre(const std::vector<CalculationOptions>& variants,
+                     Year centre);
+
+  Year radius() const { return m_radius; }
+  // The number of dates in the cache.
+  std::size_t size() const;
+
+ private:
+  using Dates = std::unordered_map<Year, Date>;
+
+  Year m_radius{kDefaultRadius};
+  mutable std::shared_mutex m_mutex{};
+  std::unordered_map<OptionKey, Dates> m_dates{};
+  // The most recent request.
+  std::vector<OptionKey> m_keys{};
+  Year m_centre{0};
+  JobHandle m_job{};
+  // Declared last, so that it is destroyed, finishing the running job,
+  // before anything the job uses.
+  SerialExecutor m_executor{};
+
+  void evict(Year centre);
+}; // class PrecomputeCache
+
+} // namespace pascha
+
+#endif // !PASCHA_PRECOMPUTE_CACHE_H
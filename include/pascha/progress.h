@@ -0,0 +1,107 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PROGRESS_H
+#define PASCHA_PROGRESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace pascha
+{
+
+// Progress of a long-running calculation over a range of years.
+struct Progress
+{
+  std::uint64_t years_done{0};
+  std::uint64_t years_total{0};
+  double years_per_second{0};
+  // Estimated time remaining, at the current rate.
+  std::chrono::duration<double> eta{0};
+  double fraction() const
+  {
+    return years_total > 0 ? static_cast<double>(years_done) /
+                                 static_cast<double>(years_total)
+                           : 1.0;
+  }
+}; // struct Progress
+
+using ProgressCallback = std::function<void(const Progress&)>;
+
+// Minimum time between progress reports.
+constexpr std::chrono::milliseconds kDefaultProgressInterval{100};
+
+// Tracks the progress of a calculation and passes it to a callback, at most
+// once per interval however often it advances, and once more when finished.
+class ProgressReporter
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  ProgressReporter(
+      std::uint64_t years_total, ProgressCallback callback,
+      std::chrono::milliseconds interval = kDefaultProgressInterval)
+    : m_callback{std::move(callback)}, m_interval{interval},
+      m_start{Clock::now()}, m_last_report{m_start}
+  {
+    m_progress.years_total = years_total;
+  }
+
+  void advance(std::uint64_t years)
+  {
+    m_progress.years_done += years;
+    if (!m_callback) { return; }
+    auto now{Clock::now()};
+    if (now - m_last_report >= m_interval) { report(now); }
+  }
+  void finish()
+  {
+    if (m_callback) { report(Clock::now()); }
+  }
+
+ private:
+  ProgressCallback m_callback{};
+  std::chrono::milliseconds m_interval{};
+  Clock::time_point m_start{};
+  Clock::time_point m_last_report{};
+  Progress m_progress{};
+
+  void report(Clock::time_point now)
+  {
+    m_last_report = now;
+    std::chrono::duration<double> elapsed{now - m_start};
+    if (elapsed.count() > 0) {
+      m_progress.years_per_second =
+          static_cast<double>(m_progress.years_done) / elapsed.count();
+    }
+    if (m_progress.years_per_second > 0 &&
+        m_progress.years_total > m_progress.years_done) {
+      m_progress.eta = std::chrono::duration<double>{
+          static_cast<double>(m_progress.years_total - m_progress.years_done) /
+          m_progress.years_per_second};
+    }
+    m_callback(m_progress);
+  }
+}; // class ProgressReporter
+
+} // namespace pascha
+
+#endif // !PASCHA_PROGRESS_H
@@ -0,0 +1,141 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_QUERY_SERVER_H
+#define PASCHA_QUERY_SERVER_H
+
+#include "batch.h"
+#include "date_format.h"
+#include "latency_histogram.h"
+#include "typedefs.h"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace pascha
+{
+
+struct QueryServerOptions
+{
+  std::filesystem::path socket_path{};
+  // Zero uses one worker per hardware thread.
+  std::size_t workers{0};
+  DateFormat date_format{DateFormat::YMD};
+  std::string date_separator{"-"};
+  // The window of years answered from the shared QueryCache.
+  Year cache_first{1900};
+  Year cache_last{2199};
+}; // struct QueryServerOptions
+
+// Answers batch queries (see batch.h) over a Unix domain socket. Linux only.
+//
+// A connection which starts with the binary batch header sends binary
+// records and is answered with a binary result for each. Any other connection
+// sends text lines and is answered with a line for each query: its date,
+// "error" if the date cannot be represented, or "error: " and the problem if
+// the query cannot be parsed. The text line "stats" is answered with the
+// number of queries answered and percentiles of their latency, as measured
+// below, e.g.
+//
+//   stats queries=1200 p50_ns=20000 p99_ns=90000 max_ns=120000 mean_ns=25000
+//
+// Requests may be pipelined: a client can send any number before reading,
+// and each connection is answered in the order of its requests.
+//
+// Every worker thread waits on one epoll instance, in which each connection
+// is armed for a single event at a time, so only one worker handles a
+// connection at once. A worker reads what has arrived on the connection, up
+// to a fixed amount so that a busy connection cannot hold up the others,
+// answers every complete request in one BatchEvaluator pass and sends the
+// results before the connection is armed again; while a client is not
+// reading its results, no more of its requests are read. The evaluators share
+// one QueryCache and the pipelines built for every set of options, so nothing
+// is built per connection.
+//
+// The latency of a query runs from a worker waking for its connection to its
+// result being handed to the socket, so it is the server's own service time:
+// it leaves out how long the connection was ready before a worker was free to
+// wake for it, and every query answered from one read is recorded with that
+// read's latency.
+class QueryServer
+{
+ public:
+  // Binds and listens on the socket, replacing a socket file which nothing
+  // is listening on. Throws std::runtime_error if it cannot, and
+  // std::invalid_argument for an invalid cache window.
+  explicit QueryServer(QueryServerOptions options);
+  QueryServer(const QueryServer&) = delete;
+  QueryServer& operator=(const QueryServer&) = delete;
+  // Closes every connection and removes the socket file.
+  ~QueryServer();
+
+  // Serve on the worker threads until stop() is called. Throws
+  // std::runtime_error if waiting for events fails.
+  void run();
+  // Ask run() to return. Safe to call from a signal handler or any thread.
+  void stop();
+
+  const LatencyHistogram& latency() const { return m_latency; }
+  // The answer to a stats request, without its newline.
+  std::string stats() const;
+
+ private:
+  struct Connection;
+  struct Worker;
+
+  QueryServerOptions m_options;
+  QueryCache m_cache;
+  LatencyHistogram m_latency{};
+  int m_listener{-1};
+  bool m_bound{false};
+  int m_epoll{-1};
+  // Readable once stop() is called.
+  int m_wake{-1};
+  // Held so that a connection can still be accepted, and refused, when the
+  // process runs out of descriptors.
+  int m_reserve{-1};
+  std::mutex m_mutex{};
+  std::unordered_map<Connection*, std::unique_ptr<Connection>>
+      m_connections;
+  std::exception_ptr m_error{};
+
+  void release();
+  void serve();
+  void accept();
+  void handle(Connection& connection, Worker& worker,
+              std::chrono::steady_clock::time_point woken);
+  std::uint64_t answer(Connection& connection, Worker& worker, bool at_end);
+  std::uint64_t answerText(Connection& connection, Worker& worker,
+                           bool at_end);
+  std::uint64_t answerBinary(Connection& connection, Worker& worker,
+                             bool at_end);
+  void arm(Connection& connection, bool writing);
+  void close(Connection& connection);
+}; // class QueryServer
+
+} // namespace pascha
+
+#endif // !PASCHA_QUERY_SERVER_H
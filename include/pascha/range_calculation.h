@@ -0,0 +1,98 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_RANGE_CALCULATION_H
+#define PASCHA_RANGE_CALCULATION_H
+
+#include "cancellation.h"
+#include "date.h"
+#include "i_calculation_method.h"
+#include "progress.h"
+#include "thread_pool.h"
+#include "typedefs.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace pascha
+{
+
+// Years per task. Keeps the dates written by one task within a typical L2
+// cache.
+constexpr Year kDefaultChunkYears{4096};
+
+struct RangeOptions
+{
+  // Worker threads; zero uses one per hardware thread.
+  std::size_t threads{0};
+  Year chunk_years{kDefaultChunkYears};
+}; // struct RangeOptions
+
+struct RangeResult
+{
+  std::vector<Date> dates{};
+  std::vector<WorkerStats> workers{};
+}; // struct RangeResult
+
+// Optional control over a running range calculation.
+struct RangeControl
+{
+  // Checked before each chunk. Once cancelled, no further windows are passed
+  // to the consumer and OperationCancelled is thrown.
+  const CancellationToken* cancellation{nullptr};
+  // Called on the calling thread as windows are completed, rate-limited to
+  // once per interval.
+  ProgressCallback progress{};
+  std::chrono::milliseconds progress_interval{kDefaultProgressInterval};
+}; // struct RangeControl
+
+// Receives consecutive runs of dates, starting with the given year.
+using RangeConsumer =
+    std::function<void(Year first, std::span<const Date> dates)>;
+
+// The following functions calculate the date for every year in [first, last]
+// by splitting the range into chunks which are calculated in parallel. The
+// method must be safe to call concurrently. The results are always in
+// ascending year order regardless of scheduling. Throws std::invalid_argument
+// if last < first, and rethrows the first exception (e.g. std::overflow_error)
+// raised by the method.
+
+// Streams the results to the consumer, on the calling thread, holding only a
+// bounded window of chunks in memory at a time.
+void calculateRange(const ICalculationMethod& method, Year first, Year last,
+                    WorkStealingPool& pool, const RangeConsumer& consumer,
+                    Year chunk_years = kDefaultChunkYears);
+// As above, with cancellation and progress reporting.
+void calculateRange(const ICalculationMethod& method, Year first, Year last,
+                    WorkStealingPool& pool, const RangeConsumer& consumer,
+                    const RangeControl& control,
+                    Year chunk_years = kDefaultChunkYears);
+std::vector<Date> calculateRange(const ICalculationMethod& method, Year first,
+                                 Year last, WorkStealingPool& pool,
+                                 Year chunk_years = kDefaultChunkYears);
+// Uses a pool of its own, reporting its utilization in the result.
+RangeResult calculateRange(const ICalculationMethod& method, Year first,
+                           Year last, const RangeOptions& options = {});
+
+} // namespace pascha
+
+#endif // !PASCHA_RANGE_CALCULATION_H
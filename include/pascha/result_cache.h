@@ -0,0 +1,112 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_RESULT_CACHE_H
+#define PASCHA_RESULT_CACHE_H
+
+#include "calculation_options.h"
+#include "date.h"
+#include "mapped_file.h"
+#include "typedefs.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <utility>
+
+namespace pascha
+{
+
+// Version of the cache file layout.
+constexpr std::uint32_t kCacheFormatVersion{1};
+// Version of the calculations whose results are cached. Bump this whenever a
+// change to the library would alter any calculated date, so that caches
+// written by older versions are discarded rather than served.
+constexpr std::uint32_t kCacheAlgorithmVersion{1};
+
+// An on-disk cache of calculated date ranges.
+//
+// The file is a fixed header followed by appended blocks, each holding the
+// dates for a contiguous range of years under one set of options, and a
+// checksum of those dates. The file is mapped read-only and dates are served
+// directly from the mapping. Blocks which fail their checksum (e.g. a torn
+// write) end the readable part of the file and are overwritten by the next
+// store. A header with a different format or algorithm version invalidates the
+// whole file.
+//
+// Blocks are indexed by options and first year when the file is mapped. A
+// year is looked up only in the block of its options starting latest at or
+// before it, and of blocks starting at the same year the last stored wins;
+// CachedCalculationMethod stores whole aligned blocks, which never overlap
+// otherwise.
+//
+// Processes may share the file: each holds an advisory lock on it while
+// reading or appending, and a store first checks, under the lock, what other
+// processes appended since, so that only a torn block is ever dropped.
+//
+// Safe to use from several threads, e.g. by a CachedCalculationMethod
+// calculating a range in parallel: finds share a lock, which a store, as it
+// remaps the file, takes exclusively.
+class ResultCache
+{
+ public:
+  // Opens (but does not create) the cache at the given path. A missing or
+  // invalid file results in an empty cache.
+  explicit ResultCache(std::filesystem::path path);
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+  ~ResultCache() = default;
+
+  // Find the cached date calculated for the given year and options.
+  std::optional<Date> find(OptionKey key, Year year) const;
+  // Append the dates for the years first, first + 1, ... under the given
+  // options. Throws std::runtime_error if the file cannot be written.
+  void store(OptionKey key, Year first, std::span<const Date> dates);
+  // Number of valid blocks in the cache.
+  std::size_t blockCount() const;
+  const std::filesystem::path& path() const { return m_path; }
+
+ private:
+  struct Block
+  {
+    std::uint64_t count;
+    const std::byte* records;
+  }; // struct Block
+
+  std::filesystem::path m_path{};
+  mutable std::shared_mutex m_mutex{};
+  MappedFile m_file{};
+  // Valid blocks, by options and first year.
+  std::map<std::pair<OptionKey, Year>, Block> m_blocks{};
+  std::size_t m_block_count{0};
+  // Offset one past the last valid block, or zero if the header is invalid.
+  std::size_t m_valid_end{0};
+
+  // Map the file and index its blocks, checking the checksum of those from
+  // verified_end on.
+  void load(std::size_t verified_end);
+}; // class ResultCache
+
+} // namespace pascha
+
+#endif // !PASCHA_RESULT_CACHE_H
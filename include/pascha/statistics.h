@@ -0,0 +1,124 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_STATISTICS_H
+#define PASCHA_STATISTICS_H
+
+#include "calculation_options.h"
+#include "range_calculation.h"
+#include "thread_pool.h"
+#include "typedefs.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace pascha
+{
+
+// The distribution of dates over a range of years, with how the Julian and
+// Gregorian dates of Pascha compare over the same range.
+struct PaschaStatistics
+{
+  Year first{0};
+  Year last{0};
+  // Years counted in the distribution; years which overflow are skipped.
+  std::uint64_t years{0};
+  std::uint64_t skipped{0};
+  // Dates falling on each calendar day, indexed by month - 1 and day - 1.
+  std::array<std::array<std::uint64_t, 31>, 12> by_day{};
+  std::array<std::uint64_t, 12> by_month{};
+  // Years compared, those in which both methods give the same date, and the
+  // total of the weeks between them as given by weeksBetween.
+  std::uint64_t compared{0};
+  std::uint64_t coincident{0};
+  std::int64_t total_weeks_between{0};
+
+  double coincidenceRate() const
+  {
+    return compared > 0 ? static_cast<double>(coincident) /
+                              static_cast<double>(compared)
+                        : 0.0;
+  }
+  double meanWeeksBetween() const
+  {
+    return compared > 0 ? static_cast<double>(total_weeks_between) /
+                              static_cast<double>(compared)
+                        : 0.0;
+  }
+  // Add the counts of statistics over another range.
+  void merge(const PaschaStatistics& other);
+}; // struct PaschaStatistics
+
+// Years per task.
+constexpr Year kStatisticsChunkYears{1 << 16};
+
+// Calculate the statistics for every year in [first, last] in parallel. The
+// distribution is of the dates given by the options (as built by
+// makeCalculationMethod, Pascha for the days until and weeks between
+// targets). Only a few chunks per worker are queued at a time, however wide
+// the range. Throws std::invalid_argument if last < first, and
+// OperationCancelled once the control's cancellation token is cancelled.
+PaschaStatistics calculateStatistics(const CalculationOptions& options,
+                                     Year first, Year last,
+                                     WorkStealingPool& pool,
+                                     const RangeControl& control = {});
+
+// Calculates statistics with a pool of its own, keeping the most recent
+// results for each range and set of options.
+class StatisticsCalculator
+{
+ public:
+  static constexpr std::size_t kCachedResults{32};
+
+  explicit StatisticsCalculator(std::size_t threads = 0) : m_pool{threads} {}
+
+  // Safe to call from several threads; calculations are run one at a time,
+  // but cached results are returned without waiting for a running one. A
+  // cancelled calculation throws OperationCancelled and is not kept.
+  std::shared_ptr<const PaschaStatistics>
+      calculate(const CalculationOptions& options, Year first, Year last,
+                const RangeControl& control = {});
+  std::size_t cachedCount() const;
+
+ private:
+  using Key = std::tuple<OptionKey, Year, Year>;
+
+  WorkStealingPool m_pool;
+  // Held while calculating, as the pool is not reentrant.
+  std::mutex m_run_mutex{};
+  // Held while using the results.
+  mutable std::mutex m_mutex{};
+  std::map<Key, std::shared_ptr<const PaschaStatistics>> m_results{};
+  // Oldest first.
+  std::deque<Key> m_order{};
+
+  // The cached result for the key, or null.
+  std::shared_ptr<const PaschaStatistics> find(const Key& key) const;
+}; // class StatisticsCalculator
+
+} // namespace pascha
+
+#endif // !PASCHA_STATISTICS_H
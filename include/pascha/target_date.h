@@ -40,7 +40,6 @@ class TargetDate : public CalculationMethodDecorator
 
  private:
   int m_shift_amount{};
-  void shift(int, Date&) const;
 }; // class TargetDate
 
 } // namespace pascha
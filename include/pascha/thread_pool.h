@@ -0,0 +1,105 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_THREAD_POOL_H
+#define PASCHA_THREAD_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pascha
+{
+
+// Per-worker statistics, accumulated over WorkStealingPool::run calls.
+struct WorkerStats
+{
+  std::uint64_t tasks{0};   // tasks executed
+  std::uint64_t stolen{0};  // tasks taken from other workers' queues
+  std::chrono::nanoseconds busy{0};
+  std::chrono::nanoseconds wall{0}; // total duration of the runs
+  double utilization() const
+  {
+    return wall.count() > 0 ? static_cast<double>(busy.count()) /
+                                  static_cast<double>(wall.count())
+                            : 0.0;
+  }
+}; // struct WorkerStats
+
+// A fixed set of worker threads executing batches of tasks. Each worker owns a
+// queue which it drains from the back; once empty it steals from the front of
+// the other workers' queues, so uneven tasks still keep every worker busy.
+class WorkStealingPool
+{
+ public:
+  using Task = std::function<void()>;
+
+  // A thread count of zero uses one thread per hardware thread.
+  explicit WorkStealingPool(std::size_t threads = 0);
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool(WorkStealingPool&&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+  ~WorkStealingPool();
+
+  std::size_t threadCount() const { return m_threads.size(); }
+  // Execute the tasks and wait for all of them to finish. If any task throws,
+  // the remaining tasks still run and the first exception is rethrown. Not
+  // reentrant: tasks must not call run on the same pool.
+  void run(std::vector<Task> tasks);
+  // Statistics since construction or the last resetStats(), one entry per
+  // worker.
+  std::vector<WorkerStats> stats() const;
+  void resetStats();
+
+ private:
+  struct Worker
+  {
+    std::mutex mutex{};
+    std::deque<Task> tasks{};
+    WorkerStats stats{};
+  }; // struct Worker
+
+  std::vector<std::unique_ptr<Worker>> m_workers{};
+  std::vector<std::thread> m_threads{};
+  mutable std::mutex m_mutex{};
+  std::condition_variable m_wake{};
+  std::condition_variable m_done{};
+  std::uint64_t m_generation{0};
+  std::size_t m_pending{0};
+  std::exception_ptr m_error{};
+  bool m_stop{false};
+
+  void workerLoop(std::size_t index);
+  bool takeTask(std::size_t index, Task& task, bool& stolen);
+}; // class WorkStealingPool
+
+} // namespace pascha
+
+#endif // !PASCHA_THREAD_POOL_H
@@ -0,0 +1,126 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_VIEWS_H
+#define PASCHA_VIEWS_H
+
+#include "calendar_conversion.h"
+#include "computus.h"
+#include "date.h"
+#include "typedefs.h"
+
+#include <ranges>
+
+namespace pascha
+{
+
+// Function objects for each step of a calculation. They mirror the
+// ICalculationMethod decorators, but are resolved at compile time.
+
+struct JulianComputus
+{
+  Date operator()(Year year) const { return julianPascha(year); }
+}; // struct JulianComputus
+
+struct GregorianComputus
+{
+  Date operator()(Year year) const { return gregorianPascha(year); }
+}; // struct GregorianComputus
+
+struct JulianCalendar
+{
+  Date operator()(const Date& date) const { return gregorianToJulian(date); }
+}; // struct JulianCalendar
+
+struct GregorianCalendar
+{
+  Date operator()(const Date& date) const { return date; }
+}; // struct GregorianCalendar
+
+struct RevisedJulianCalendar
+{
+  Date operator()(const Date& date) const
+  {
+    return gregorianToRevJulian(date);
+  }
+}; // struct RevisedJulianCalendar
+
+struct FeastShift
+{
+  CalcInt days;
+  Date operator()(const Date& date) const { return addDays(date, days); }
+}; // struct FeastShift
+
+struct ByzantineYear
+{
+  Date operator()(const Date& date) const { return toByzantine(date); }
+}; // struct ByzantineYear
+
+inline constexpr JulianComputus julian_computus{};
+inline constexpr GregorianComputus gregorian_computus{};
+inline constexpr JulianCalendar julian_calendar{};
+inline constexpr GregorianCalendar gregorian_calendar{};
+inline constexpr RevisedJulianCalendar rev_julian_calendar{};
+
+// Range adaptors applying the steps above to each element, in the same order
+// as the decorators are stacked by the controller: the computus, then the
+// target feast, then the output calendar, then the options. For example, the
+// Julian dates of Meatfare Sunday in Byzantine years:
+//
+//   std::views::iota(first, last + 1) | views::pascha(julian_computus) |
+//       views::feast(-56) | views::to_calendar(julian_calendar) |
+//       views::byzantine
+//
+// Unlike ICalculationMethod, no virtual calls are involved, so the whole
+// pipeline is visible to the optimizer.
+namespace views
+{
+
+// Years to the date of Pascha, in the Gregorian calendar.
+template <typename Computus>
+  requires std::is_invocable_r_v<Date, const Computus&, Year>
+constexpr auto pascha(Computus computus)
+{
+  return std::views::transform(computus);
+}
+
+// Pascha to the feast the given number of days away from it, e.g. -56 for
+// Meatfare Sunday or 49 for Pentecost.
+constexpr auto feast(CalcInt offset)
+{
+  return std::views::transform(FeastShift{offset});
+}
+
+// Gregorian dates to the output calendar.
+template <typename Calendar>
+  requires std::is_invocable_r_v<Date, const Calendar&, const Date&>
+constexpr auto to_calendar(Calendar calendar)
+{
+  return std::views::transform(calendar);
+}
+
+// Dates to Byzantine years.
+inline constexpr auto byzantine = std::views::transform(ByzantineYear{});
+
+} // namespace views
+
+} // namespace pascha
+
+#endif // !PASCHA_VIEWS_H
@@ -0,0 +1,148 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-served: A daemon answering Pascha (Easter) date queries.
+//
+// Version: 1.0 (2024-01-07)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "arguments.h"
+#include "options.h"
+
+#include "pascha/query_server.h"
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Years the cache may span, at most, keeping it to a few tens of megabytes.
+constexpr Year kMaxCacheYears{10000};
+
+pascha::QueryServer* g_server{nullptr};
+
+void printUsage(std::ostream& out)
+{
+  out << "Usage: pascha-served [OPTIONS]\n"
+         "\n"
+         "Answers batch queries, as pascha-cli batch reads them, over a\n"
+         "Unix socket until interrupted. Send the line \"stats\" for the\n"
+         "number of queries answered and the server's latency answering\n"
+         "them, from reading them to sending the results.\n"
+         "\n"
+         "Options:\n"
+         "  --socket PATH            (default $XDG_RUNTIME_DIR/"
+         "pascha-served.sock)\n"
+         "  --workers N              (default one per hardware thread)\n"
+         "  --cache-first YEAR       (default 1900)\n"
+         "  --cache-last YEAR        (default 2199)\n"
+         "  --date-format ymd|mdy|dmy (default ymd)\n"
+         "  --separator TEXT         (default -)\n"
+         "  --help                   Show this message\n";
+} // printUsage
+
+std::string defaultSocketPath()
+{
+  const char* runtime{std::getenv("XDG_RUNTIME_DIR")};
+  return std::string{runtime && *runtime ? runtime : "/tmp"} +
+         "/pascha-served.sock";
+} // defaultSocketPath
+
+pascha::QueryServerOptions serverOptions(const pascha::Arguments& arguments)
+{
+  using namespace pascha;
+
+  arguments.allowOnly({"socket", "workers", "cache-first", "cache-last",
+                       "date-format", "separator"});
+  QueryServerOptions options{};
+  options.socket_path = arguments.value("socket", defaultSocketPath());
+  if (auto workers{arguments.integer("workers")}) {
+    if (*workers < 1 || *workers > 1024) {
+      throw UsageError{"--workers must be from 1 to 1024"};
+    }
+    options.workers = static_cast<std::size_t>(*workers);
+  }
+  if (arguments.value("cache-first")) {
+    options.cache_first = arguments.year("cache-first");
+  }
+  if (arguments.value("cache-last")) {
+    options.cache_last = arguments.year("cache-last");
+  }
+  // The span may not fit in a Year.
+  if (options.cache_last < options.cache_first ||
+      static_cast<std::uint64_t>(options.cache_last) -
+              static_cast<std::uint64_t>(options.cache_first) >=
+          static_cast<std::uint64_t>(kMaxCacheYears)) {
+    throw UsageError{"The cache must span 1 to " +
+                     std::to_string(kMaxCacheYears) + " years"};
+  }
+  options.date_format = dateFormat(arguments);
+  options.date_separator = arguments.value("separator", "-");
+  if (options.date_separator.find('\n') != std::string::npos) {
+    throw UsageError{"The separator cannot contain a newline"};
+  }
+  return options;
+} // serverOptions
+
+extern "C" void stopServer(int)
+{
+  if (g_server) { g_server->stop(); }
+} // stopServer
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  using namespace pascha;
+
+  try {
+    // Arguments reads a command first; the daemon has just the one.
+    std::vector<const char*> words{argv[0], "serve"};
+    words.insert(words.end(), argv + 1, argv + argc);
+    Arguments arguments{static_cast<int>(words.size()), words.data()};
+    if (arguments.flag("help")) {
+      printUsage(std::cout);
+      return 0;
+    }
+
+    QueryServer server{serverOptions(arguments)};
+    g_server = &server;
+    struct sigaction action{};
+    action.sa_handler = &stopServer;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    server.run();
+    g_server = nullptr;
+    std::cerr << "pascha-served: " << server.stats() << '\n';
+    return 0;
+  } catch (const UsageError& e) {
+    std::cerr << "pascha-served: " << e.what() << "\n\n";
+    printUsage(std::cerr);
+    return 2;
+  } catch (const std::exception& e) {
+    std::cerr << "pascha-served: " << e.what() << '\n';
+    return 1;
+  }
+} // main
@@ -0,0 +1,444 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/batch.h"
+
+#include "pascha/executor.h"
+#include "pascha/feasts.h"
+#include "pascha/mapped_file.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+namespace
+{
+
+using namespace pascha;
+
+constexpr std::size_t kMethods{e_calculation_method::last};
+constexpr std::size_t kTargets{e_target_output::last};
+constexpr std::size_t kCalendars{e_output_calendar::last};
+
+// The packed key of every combination of options a query can hold, indexed
+// by method, target, calendar and Byzantine years, so that queries are keyed
+// without building CalculationOptions. Zero marks a target which is not a
+// feast. The pipeline of each key is built here too, once for the process.
+class QueryKeys
+{
+ public:
+  QueryKeys()
+  {
+    for (const Feast& feast : kFeasts) {
+      for (std::size_t method = 0; method < kMethods; ++method) {
+        for (std::size_t calendar = 0; calendar < kCalendars; ++calendar) {
+          for (std::size_t byzantine = 0; byzantine < 2; ++byzantine) {
+            CalculationOptions options{
+                static_cast<ECalculationMethod>(method),
+                {feast.target},
+                static_cast<EOutputCalendar>(calendar),
+                {},
+                0};
+            if (byzantine) { options.options = {e_output_option::byzantine}; }
+            const OptionKey key{packOptions(options)};
+            m_keys[index(method, static_cast<std::size_t>(feast.target),
+                         calendar, byzantine)] = key | kValid;
+            m_pipelines.emplace(key, DatePipeline{options});
+          }
+        }
+      }
+    }
+  }
+
+  // The key of the options, marked as valid, or zero if they are out of
+  // range or the target is not a feast.
+  OptionKey find(std::size_t method, std::size_t target, std::size_t calendar,
+                 std::size_t byzantine) const
+  {
+    if (method >= kMethods || target >= kTargets || calendar >= kCalendars ||
+        byzantine > 1) {
+      return 0;
+    }
+    return m_keys[index(method, target, calendar, byzantine)];
+  }
+  // The key itself, without the mark.
+  static OptionKey key(OptionKey found) { return found & ~kValid; }
+  // The pipeline of an unmarked key, or nullptr if no query holds it.
+  const DatePipeline* pipeline(OptionKey key) const
+  {
+    auto found{m_pipelines.find(key)};
+    return found == m_pipelines.end() ? nullptr : &found->second;
+  }
+  const std::unordered_map<OptionKey, DatePipeline>& pipelines() const
+  {
+    return m_pipelines;
+  }
+
+ private:
+  // Above the bits packOptions uses.
+  static constexpr OptionKey kValid{OptionKey{1} << 31};
+
+  std::array<OptionKey, kMethods * kTargets * kCalendars * 2> m_keys{};
+  std::unordered_map<OptionKey, DatePipeline> m_pipelines{};
+
+  static std::size_t index(std::size_t method, std::size_t target,
+                           std::size_t calendar, std::size_t byzantine)
+  {
+    return ((method * kTargets + target) * kCalendars + calendar) * 2 +
+           byzantine;
+  }
+}; // class QueryKeys
+
+const QueryKeys& queryKeys()
+{
+  static const QueryKeys keys{};
+  return keys;
+} // queryKeys
+
+std::uint64_t readLittleEndian(const std::byte* bytes, std::size_t size)
+{
+  std::uint64_t value{0};
+  for (std::size_t i = size; i-- > 0;) {
+    value = (value << 8) | static_cast<std::uint64_t>(bytes[i]);
+  }
+  return value;
+} // readLittleEndian
+
+std::byte* writeLittleEndian(std::uint64_t value, std::size_t size,
+                             std::byte* out)
+{
+  for (std::size_t i = 0; i < size; ++i, value >>= 8) {
+    out[i] = static_cast<std::byte>(value & 0xff);
+  }
+  return out + size;
+} // writeLittleEndian
+
+// Splits off the text up to the next comma, or all of it at the last field.
+std::string_view nextField(std::string_view& line)
+{
+  const auto comma{line.find(',')};
+  const std::string_view field{line.substr(0, comma)};
+  line.remove_prefix(comma == std::string_view::npos ? line.size()
+                                                     : comma + 1);
+  return field;
+} // nextField
+
+std::size_t indexOf(std::string_view field,
+                    std::initializer_list<std::string_view> names)
+{
+  std::size_t index{0};
+  for (std::string_view name : names) {
+    if (name == field) { return index; }
+    ++index;
+  }
+  return index;
+} // indexOf
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+TextQueryParser::TextQueryParser() : m_targets(kTargets)
+{
+  for (const Feast& feast : kFeasts) {
+    m_targets[static_cast<std::size_t>(feast.target)] = feastSlug(feast);
+  }
+} // TextQueryParser::TextQueryParser
+
+std::size_t TextQueryParser::parse(std::string_view text,
+                                   BatchQueries& queries, std::size_t max,
+                                   bool at_end)
+{
+  std::size_t used{0};
+  while (queries.size() < max && used < text.size()) {
+    std::size_t end{text.find('\n', used)};
+    if (end == std::string_view::npos) {
+      if (!at_end) { break; }
+      end = text.size();
+    }
+    std::string_view line{text.substr(used, end - used)};
+    used = std::min(end + 1, text.size());
+    ++m_lines;
+
+    if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+    if (line.empty() || line.front() == '#') { continue; }
+    parseLine(line, queries);
+  }
+  return used;
+} // TextQueryParser::parse
+
+void TextQueryParser::parseLine(std::string_view line,
+                                BatchQueries& queries) const
+{
+  auto fail{[this](const char* problem) {
+    throw std::runtime_error{"Line " + std::to_string(m_lines) + ": " +
+                             problem};
+  }};
+
+  const std::string_view year_field{nextField(line)};
+  Year year{};
+  auto [year_end, error]{std::from_chars(
+      year_field.data(), year_field.data() + year_field.size(), year)};
+  if (error != std::errc{} ||
+      year_end != year_field.data() + year_field.size()) {
+    fail("The year is not a number");
+  }
+
+  const std::size_t method{indexOf(nextField(line), {"julian", "gregorian"})};
+  const std::string_view target_field{nextField(line)};
+  const std::size_t target{static_cast<std::size_t>(
+      std::ranges::find(m_targets, target_field) - m_targets.begin())};
+  const std::size_t calendar{
+      indexOf(nextField(line), {"julian", "gregorian", "revised-julian"})};
+  const std::size_t byzantine{indexOf(nextField(line), {"0", "1"})};
+  if (!line.empty()) { fail("Expected five fields"); }
+
+  const OptionKey key{queryKeys().find(method, target, calendar, byzantine)};
+  if (key == 0) {
+    fail("Unknown method, feast, calendar or Byzantine flag");
+  }
+  queries.years.push_back(year);
+  queries.keys.push_back(QueryKeys::key(key));
+} // TextQueryParser::parseLine
+
+std::size_t parseBinaryQueries(std::span<const std::byte> records,
+                               BatchQueries& queries, std::size_t max)
+{
+  const QueryKeys& keys{queryKeys()};
+  std::size_t used{0};
+  for (; queries.size() < max && records.size() - used >= kBatchRecordSize;
+       used += kBatchRecordSize) {
+    const std::byte* record{records.data() + used};
+    const OptionKey key{keys.find(static_cast<std::size_t>(record[8]),
+                                  static_cast<std::size_t>(record[9]),
+                                  static_cast<std::size_t>(record[10]),
+                                  static_cast<std::size_t>(record[11]))};
+    if (key == 0 || readLittleEndian(record + 12, 4) != 0) {
+      throw std::runtime_error{"Invalid batch record"};
+    }
+    queries.years.push_back(
+        static_cast<Year>(readLittleEndian(record, sizeof(Year))));
+    queries.keys.push_back(QueryKeys::key(key));
+  }
+  if (used < records.size() && records.size() - used < kBatchRecordSize &&
+      queries.size() < max) {
+    throw std::runtime_error{"The last batch record is incomplete"};
+  }
+  return used;
+} // parseBinaryQueries
+
+QueryCache::QueryCache(Year first, Year last) : m_first{first}, m_last{last}
+{
+  if (last < first) {
+    throw std::invalid_argument{"The last year is before the first"};
+  }
+  const auto years{static_cast<std::uint64_t>(last) -
+                   static_cast<std::uint64_t>(first) + 1};
+  for (const auto& [key, pipeline] : queryKeys().pipelines()) {
+    std::vector<Date>& dates{m_dates[key]};
+    dates.reserve(years);
+    for (Year year = first;; ++year) {
+      dates.push_back(pipeline(year));
+      if (year == last) { break; }
+    }
+  }
+} // QueryCache::QueryCache
+
+const Date* QueryCache::dates(OptionKey key) const
+{
+  auto found{m_dates.find(key)};
+  return found == m_dates.end() ? nullptr : found->second.data();
+} // QueryCache::dates
+
+BatchEvaluator::BatchEvaluator(DateFormat date_format,
+                               std::string_view date_separator,
+                               const QueryCache* cache)
+    : m_formatter{date_format, date_separator}, m_cache{cache}
+{
+} // BatchEvaluator::BatchEvaluator
+
+std::size_t BatchEvaluator::maxResultSize() const
+{
+  return std::max(m_formatter.maxSize(), std::string_view{"error"}.size()) + 1;
+} // BatchEvaluator::maxResultSize
+
+const DatePipeline& BatchEvaluator::pipeline(OptionKey key)
+{
+  if (const DatePipeline* shared{queryKeys().pipeline(key)}) { return *shared; }
+  auto found{m_pipelines.find(key)};
+  if (found == m_pipelines.end()) {
+    found = m_pipelines.emplace(key, DatePipeline{key}).first;
+  }
+  return found->second;
+} // BatchEvaluator::pipeline
+
+void BatchEvaluator::group(const BatchQueries& queries)
+{
+  // Number the distinct keys, remembering each query's group. Queries with
+  // the same options tend to come together, so the last key is checked
+  // before the map.
+  m_group_of.clear();
+  m_group_keys.clear();
+  m_groups.resize(queries.size());
+  OptionKey last_key{};
+  std::uint32_t last_group{0};
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    const OptionKey key{queries.keys[i]};
+    if (m_group_keys.empty() || key != last_key) {
+      auto [found, added]{m_group_of.try_emplace(
+          key, static_cast<std::uint32_t>(m_group_keys.size()))};
+      if (added) { m_group_keys.push_back(key); }
+      last_key = key;
+      last_group = found->second;
+    }
+    m_groups[i] = last_group;
+  }
+
+  // Counting sort of the queries by group, keeping their order within it.
+  m_group_starts.assign(m_group_keys.size() + 1, 0);
+  for (std::uint32_t group : m_groups) { ++m_group_starts[group + 1]; }
+  for (std::size_t g = 1; g < m_group_starts.size(); ++g) {
+    m_group_starts[g] += m_group_starts[g - 1];
+  }
+  m_order.resize(queries.size());
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    m_order[m_group_starts[m_groups[i]]++] = static_cast<std::uint32_t>(i);
+  }
+  // Each start was advanced to the next group's; shift them back.
+  std::shift_right(m_group_starts.begin(), m_group_starts.end(), 1);
+  m_group_starts.front() = 0;
+} // BatchEvaluator::group
+
+void BatchEvaluator::evaluate(const BatchQueries& queries)
+{
+  group(queries);
+  m_dates.resize(queries.size());
+  m_failed.assign(queries.size(), false);
+  for (std::size_t g = 0; g < m_group_keys.size(); ++g) {
+    const DatePipeline& calculate{pipeline(m_group_keys[g])};
+    const Date* cached{m_cache ? m_cache->dates(m_group_keys[g]) : nullptr};
+    for (std::uint32_t at = m_group_starts[g]; at < m_group_starts[g + 1];
+         ++at) {
+      const std::uint32_t i{m_order[at]};
+      const Year year{queries.years[i]};
+      if (cached && year >= m_cache->first() && year <= m_cache->last()) {
+        m_dates[i] = cached[year - m_cache->first()];
+        continue;
+      }
+      try {
+        m_dates[i] = calculate(year);
+      } catch (const std::overflow_error&) {
+        m_failed[i] = true;
+      }
+    }
+  }
+} // BatchEvaluator::evaluate
+
+char* BatchEvaluator::write(const BatchQueries& queries, char* out)
+{
+  evaluate(queries);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    if (m_failed[i]) {
+      std::memcpy(out, "error", 5);
+      out += 5;
+    } else {
+      out = m_formatter.write(m_dates[i], out);
+    }
+    *out++ = '\n';
+  }
+  return out;
+} // BatchEvaluator::write
+
+std::byte* BatchEvaluator::writeResults(const BatchQueries& queries,
+                                        std::byte* out)
+{
+  evaluate(queries);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    const Date date{m_failed[i] ? Date{0, 0, 0} : m_dates[i]};
+    out = writeLittleEndian(static_cast<std::uint64_t>(date.year), 8, out);
+    *out++ = static_cast<std::byte>(date.month);
+    *out++ = static_cast<std::byte>(date.day);
+    *out++ = static_cast<std::byte>(m_failed[i] ? kBatchResultOverflow
+                                                : kBatchResultDate);
+    out = writeLittleEndian(0, 5, out);
+  }
+  return out;
+} // BatchEvaluator::writeResults
+
+void evaluateBatchFile(const std::filesystem::path& path, std::ostream& out,
+                       const BatchOptions& options)
+{
+  const MappedFile file{path};
+  std::span<const std::byte> input{file.bytes()};
+  const bool binary{input.size() >= kBatchMagic.size() &&
+                    std::memcmp(input.data(), kBatchMagic.data(),
+                                kBatchMagic.size()) == 0};
+  if (binary) {
+    if (input.size() < kBatchHeaderSize ||
+        readLittleEndian(input.data() + 8, 4) != kBatchFormatVersion ||
+        readLittleEndian(input.data() + 12, 4) != kBatchRecordSize) {
+      throw std::runtime_error{path.string() +
+                               " is not a batch file this version can read"};
+    }
+    input = input.subspan(kBatchHeaderSize);
+  }
+
+  BatchEvaluator evaluator{options.date_format, options.date_separator};
+  std::vector<char> text(kBatchChunkQueries * evaluator.maxResultSize());
+  TextQueryParser parser{};
+  std::array<BatchQueries, 2> chunks{};
+  std::exception_ptr parse_error{};
+  auto parseNext{[&](BatchQueries& chunk) {
+    chunk.clear();
+    try {
+      const std::size_t used{
+          binary ? parseBinaryQueries(input, chunk, kBatchChunkQueries)
+                 : parser.parse({reinterpret_cast<const char*>(input.data()),
+                                 input.size()},
+                                chunk, kBatchChunkQueries, true)};
+      input = input.subspan(used);
+    } catch (...) {
+      parse_error = std::current_exception();
+    }
+  }};
+
+  // Declared last, so that a running parse finishes before what it uses
+  // goes.
+  SerialExecutor parsing{};
+  JobHandle parsed{parsing.submit([&] { parseNext(chunks[0]); })};
+  for (std::size_t current = 0;; current = 1 - current) {
+    parsed.wait();
+    if (parse_error) { std::rethrow_exception(parse_error); }
+    if (chunks[current].empty()) { break; }
+    BatchQueries& next{chunks[1 - current]};
+    parsed = parsing.submit([&] { parseNext(next); });
+
+    const char* end{evaluator.write(chunks[current], text.data())};
+    out.write(text.data(), end - text.data());
+    if (!out) { throw std::runtime_error{"Failed to write the results"}; }
+  }
+  out.flush();
+  if (!out) { throw std::runtime_error{"Failed to write the results"}; }
+} // evaluateBatchFile
+
+} // namespace pascha
@@ -0,0 +1,172 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/bulk_date_formatter.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+
+using namespace pascha;
+
+constexpr std::array<char, 200> makeDigitPairs()
+{
+  std::array<char, 200> pairs{};
+  for (int i = 0; i < 100; ++i) {
+    pairs[2 * i] = static_cast<char>('0' + i / 10);
+    pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+} // makeDigitPairs
+
+// "00" to "99", indexed by twice the number.
+constexpr std::array<char, 200> kDigitPairs{makeDigitPairs()};
+
+constexpr std::size_t kMaxIntegerSize{BulkDateFormatter::kMaxYearSize};
+
+char* writePair(std::uint64_t value, char* out)
+{
+  std::memcpy(out, &kDigitPairs[2 * value], 2);
+  return out + 2;
+} // writePair
+
+char* writeInteger(std::int64_t value, char* out)
+{
+  // The magnitude is taken as unsigned, so that the smallest value is safe.
+  std::uint64_t magnitude{static_cast<std::uint64_t>(value)};
+  if (value < 0) {
+    *out++ = '-';
+    magnitude = 0 - magnitude;
+  }
+
+  // Write backwards into a scratch buffer, two digits at a time.
+  char digits[kMaxIntegerSize];
+  char* first{digits + kMaxIntegerSize};
+  while (magnitude >= 100) {
+    first -= 2;
+    writePair(magnitude % 100, first);
+    magnitude /= 100;
+  }
+  if (magnitude >= 10) {
+    first -= 2;
+    writePair(magnitude, first);
+  } else {
+    *--first = static_cast<char>('0' + magnitude);
+  }
+
+  const auto size{static_cast<std::size_t>(digits + kMaxIntegerSize - first)};
+  std::memcpy(out, first, size);
+  return out + size;
+} // writeInteger
+
+char* writeYearDigits(Year year, char* out)
+{
+  if (year >= 1000 && year <= 9999) {
+    out = writePair(static_cast<std::uint64_t>(year / 100), out);
+    return writePair(static_cast<std::uint64_t>(year % 100), out);
+  }
+  return writeInteger(year, out);
+} // writeYearDigits
+
+// For months and days.
+char* writeShort(std::int16_t value, char* out)
+{
+  if (value >= 0 && value < 10) {
+    *out = static_cast<char>('0' + value);
+    return out + 1;
+  }
+  if (value >= 10 && value < 100) {
+    return writePair(static_cast<std::uint64_t>(value), out);
+  }
+  return writeInteger(value, out);
+} // writeShort
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+BulkDateFormatter::BulkDateFormatter(DateFormat format,
+                                     std::string_view separator)
+    : m_format{format},
+      m_separator{separator},
+      m_max_size{3 * kMaxIntegerSize + 2 * separator.size()}
+{
+} // BulkDateFormatter::BulkDateFormatter
+
+char* BulkDateFormatter::write(const Date& date, char* out) const
+{
+  switch (m_format) {
+    case DateFormat::MDY:
+      out = writeSeparator(writeShort(date.month, out));
+      out = writeSeparator(writeShort(date.day, out));
+      return writeYearDigits(date.year, out);
+    case DateFormat::DMY:
+      out = writeSeparator(writeShort(date.day, out));
+      out = writeSeparator(writeShort(date.month, out));
+      return writeYearDigits(date.year, out);
+    case DateFormat::YMD:
+    default:
+      out = writeSeparator(writeYearDigits(date.year, out));
+      out = writeSeparator(writeShort(date.month, out));
+      return writeShort(date.day, out);
+  }
+} // BulkDateFormatter::write
+
+void BulkDateFormatter::append(std::span<const Date> dates, std::string& text,
+                               char terminator) const
+{
+  // Reserve for the widest dates, write, then trim to what was written.
+  const std::size_t first{text.size()};
+  text.resize(first + dates.size() * (m_max_size + 1));
+  char* out{text.data() + first};
+  for (const Date& date : dates) {
+    out = write(date, out);
+    *out++ = terminator;
+  }
+  text.resize(static_cast<std::size_t>(out - text.data()));
+} // BulkDateFormatter::append
+
+std::string BulkDateFormatter::format(const Date& date) const
+{
+  std::string text(m_max_size, '\0');
+  text.resize(static_cast<std::size_t>(write(date, text.data()) - text.data()));
+  return text;
+} // BulkDateFormatter::format
+
+char* BulkDateFormatter::writeSeparator(char* out) const
+{
+  if (m_separator.size() == 1) {
+    *out = m_separator.front();
+    return out + 1;
+  }
+  std::memcpy(out, m_separator.data(), m_separator.size());
+  return out + m_separator.size();
+} // BulkDateFormatter::writeSeparator
+
+char* BulkDateFormatter::writeYear(Year year, char* out)
+{
+  return writeYearDigits(year, out);
+} // BulkDateFormatter::writeYear
+
+} // namespace pascha
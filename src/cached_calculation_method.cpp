@@ -0,0 +1,65 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/cached_calculation_method.h"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace pascha
+{
+
+Date CachedCalculationMethod::calculate(Year year) const
+{
+  if (auto date = m_cache->find(m_key, year)) { return *date; }
+
+  // Years at the very ends of the range are not worth caching, and would
+  // overflow the block bounds.
+  if (year < std::numeric_limits<Year>::min() + kBlockYears ||
+      year > std::numeric_limits<Year>::max() - kBlockYears) {
+    return calculation_method().calculate(year);
+  }
+
+  Year first{year / kBlockYears * kBlockYears};
+  if (year < 0 && year % kBlockYears != 0) { first -= kBlockYears; }
+
+  std::vector<Date> dates{};
+  dates.reserve(kBlockYears);
+  try {
+    for (Year y = first; y < first + kBlockYears; ++y) {
+      dates.push_back(calculation_method().calculate(y));
+    }
+  } catch (const std::overflow_error&) {
+    // Part of the block is out of range; calculate only the requested year,
+    // which will throw if it is itself out of range.
+    return calculation_method().calculate(year);
+  }
+
+  try {
+    m_cache->store(m_key, first, dates);
+  } catch (const std::runtime_error&) {
+    // Caching is best effort; the result is still valid.
+  }
+
+  return dates[year - first];
+} // CachedCalculationMethod::calculate
+
+} // namespace pascha
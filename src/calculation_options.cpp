@@ -0,0 +1,76 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_options.h"
+
+namespace
+{
+
+// Bit layout of an OptionKey
+constexpr int kMethodShift{0};
+constexpr int kTargetShift{4};
+constexpr int kCalendarShift{12};
+constexpr int kOptionsShift{16};
+constexpr pascha::OptionKey kMethodMask{0xf};
+constexpr pascha::OptionKey kTargetMask{0xff};
+constexpr pascha::OptionKey kCalendarMask{0xf};
+constexpr pascha::OptionKey kOptionsMask{0xffff};
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+OptionKey packOptions(const CalculationOptions& options)
+{
+  OptionKey key{};
+  key |= (static_cast<OptionKey>(options.calculation_method) & kMethodMask)
+         << kMethodShift;
+  if (!options.target_outputs.empty()) {
+    key |= (static_cast<OptionKey>(options.target_outputs.front()) &
+            kTargetMask)
+           << kTargetShift;
+  }
+  key |= (static_cast<OptionKey>(options.output_calendar) & kCalendarMask)
+         << kCalendarShift;
+  for (auto option : options.options) {
+    key |= ((OptionKey{1} << option) & kOptionsMask) << kOptionsShift;
+  }
+  return key;
+} // packOptions
+
+CalculationOptions unpackOptions(OptionKey key, Year year)
+{
+  CalculationOptions options{};
+  options.calculation_method =
+      static_cast<ECalculationMethod>((key >> kMethodShift) & kMethodMask);
+  options.target_outputs.push_back(
+      static_cast<ETargetOutput>((key >> kTargetShift) & kTargetMask));
+  options.output_calendar =
+      static_cast<EOutputCalendar>((key >> kCalendarShift) & kCalendarMask);
+  OptionKey flags{(key >> kOptionsShift) & kOptionsMask};
+  for (EOutputOption option = 0; option < e_output_option::last; ++option) {
+    if (flags & (OptionKey{1} << option)) { options.options.push_back(option); }
+  }
+  options.year = year;
+  return options;
+} // unpackOptions
+
+} // namespace pascha
@@ -42,7 +42,68 @@ constexpr CalcInt kRevJulianMinYear{-5508};
 // The following functions calculate the Julian Day Number (JDN) from a given
 // calendar date. This is used as a fixed point to convert between calendars.
 
-// gregorianToJdn is in the pascha namespace below.
+// As gregorianToJdn, but without checking that the year is in range.
+CalcInt gregorianToJdnUnchecked(const Date& date)
+{
+  CalcInt y = date.year;
+  CalcInt m = date.month;
+  CalcInt jdn{};
+
+  // Calculate the number of 400 year cycles
+  CalcInt cycles{};
+  if (y < 0) {
+    cycles = y / 400 - 1;
+    if (y % 400 == 0) { ++cycles; }
+    y = (400 - (-1 * y % 400)) % 400;
+  } else {
+    cycles = y / 400;
+    y = y % 400;
+  }
+
+  // Treat months prior to leap day as if they were in the previous year
+  if (m < 3) {
+    m += 12;
+    --y;
+  }
+
+  // Add contribution from number of leap years
+  if (y < 0 && y % 4 != 0) {
+    jdn = 365 * y + (y / 4 - 1);
+  } else {
+    jdn = 365 * y + (y / 4);
+  }
+
+  // Add contribution from number of months and current day in month
+  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
+
+  // Adjustments for leap year differences between Julian and Gregorian
+  // calendars (leap years skipped when divisible by 100 but not by 400)
+  // Adjustments when year is negative (casues off by one problem with modulo
+  // for leap year checks)
+  if (y < 0) {
+    if (y % 100 != 0) {
+      if (y % 400 != 0) {
+        jdn = jdn - (y / 100 - 1) + (y / 400 - 1);
+      } else {
+        jdn = jdn - (y / 100 - 1) + (y / 400);
+      }
+    } else {
+      if (y % 400 != 0) {
+        jdn = jdn - (y / 100) + (y / 400 - 1);
+      } else {
+        jdn = jdn - (y / 100) + (y / 400);
+      }
+    }
+  } else {
+    jdn = jdn - y / 100 + y / 400;
+  }
+
+  // Add base contribution for days prior to 1/1/1
+  // and the total number of unaccounted cycles
+  jdn = jdn + 1721120 + 146097 * cycles;
+
+  return jdn;
+} // gregorianToJdnUnchecked
 
 CalcInt julianToJdn(const Date& date)
 {
@@ -319,65 +380,7 @@ CalcInt gregorianToJdn(const Date& date)
     throw std::overflow_error("Gregorian year out of range");
   }
 
-  CalcInt y = date.year;
-  CalcInt m = date.month;
-  CalcInt jdn{};
-
-  // Calculate the number of 400 year cycles
-  CalcInt cycles{};
-  if (y < 0) {
-    cycles = y / 400 - 1;
-    if (y % 400 == 0) { ++cycles; }
-    y = (400 - (-1 * y % 400)) % 400;
-  } else {
-    cycles = y / 400;
-    y = y % 400;
-  }
-
-  // Treat months prior to leap day as if they were in the previous year
-  if (m < 3) {
-    m += 12;
-    --y;
-  }
-
-  // Add contribution from number of leap years
-  if (y < 0 && y % 4 != 0) {
-    jdn = 365 * y + (y / 4 - 1);
-  } else {
-    jdn = 365 * y + (y / 4);
-  }
-
-  // Add contribution from number of months and current day in month
-  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
-
-  // Adjustments for leap year differences between Julian and Gregorian
-  // calendars (leap years skipped when divisible by 100 but not by 400)
-  // Adjustments when year is negative (casues off by one problem with modulo
-  // for leap year checks)
-  if (y < 0) {
-    if (y % 100 != 0) {
-      if (y % 400 != 0) {
-        jdn = jdn - (y / 100 - 1) + (y / 400 - 1);
-      } else {
-        jdn = jdn - (y / 100 - 1) + (y / 400);
-      }
-    } else {
-      if (y % 400 != 0) {
-        jdn = jdn - (y / 100) + (y / 400 - 1);
-      } else {
-        jdn = jdn - (y / 100) + (y / 400);
-      }
-    }
-  } else {
-    jdn = jdn - y / 100 + y / 400;
-  }
-
-  // Add base contribution for days prior to 1/1/1
-  // and the total number of unaccounted cycles
-  jdn = jdn + 1721120 + 146097 * cycles;
-
-  return jdn;
-
+  return gregorianToJdnUnchecked(date);
 } // gregorianToJdn
 
 Date gregorianToJulian(const Date& date)
@@ -412,4 +415,17 @@ Date revJulianToGregorian(const Date& date)
   return gregorian_date;
 } // revJulianToGregorian
 
+Date addDays(const Date& date, CalcInt days)
+{
+  // The lower bound of gregorianToJdn only guards the Byzantine calendar, so
+  // only overflow is checked here.
+  if (date.year > kGregorianMaxYear || date.year < -kGregorianMaxYear) {
+    throw std::overflow_error("Gregorian year out of range");
+  }
+
+  Date shifted_date{};
+  jdnToGregorian(gregorianToJdnUnchecked(date) + days, shifted_date);
+  return shifted_date;
+} // addDays
+
 } // namespace pascha
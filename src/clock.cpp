@@ -0,0 +1,76 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/clock.h"
+
+#include "pascha/calendar_conversion.h"
+
+#include <ctime>
+
+namespace pascha
+{
+
+std::shared_ptr<const SystemClock::CachedToday> SystemClock::current() const
+{
+  auto now{std::chrono::system_clock::now()};
+  std::shared_ptr<const CachedToday> today{};
+  {
+    std::lock_guard lock{m_mutex};
+    today = m_today;
+  }
+  if (today && now < today->next_midnight) { return today; }
+
+  // std::localtime shares a static buffer between threads, so use the
+  // reentrant variants.
+  std::time_t time{std::chrono::system_clock::to_time_t(now)};
+  std::tm local{};
+#ifdef _WIN32
+  localtime_s(&local, &time);
+#else
+  localtime_r(&time, &local);
+#endif
+
+  Date date{};
+  date.year = local.tm_year + 1900;
+  date.month = static_cast<Month>(local.tm_mon + 1);
+  date.day = static_cast<Day>(local.tm_mday);
+
+  // mktime normalises the day after the end of the month, and accounts for
+  // any change of daylight saving time.
+  std::tm midnight{};
+  midnight.tm_year = local.tm_year;
+  midnight.tm_mon = local.tm_mon;
+  midnight.tm_mday = local.tm_mday + 1;
+  midnight.tm_isdst = -1;
+
+  today = std::make_shared<const CachedToday>(CachedToday{
+      Today{date, gregorianToJdn(date)},
+      std::chrono::system_clock::from_time_t(std::mktime(&midnight))});
+  std::lock_guard lock{m_mutex};
+  m_today = today;
+  return today;
+} // SystemClock::current
+
+FixedClock::FixedClock(const Date& today)
+    : m_today{today, gregorianToJdn(today)}
+{
+} // FixedClock::FixedClock
+
+} // namespace pascha
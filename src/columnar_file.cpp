@@ -0,0 +1,485 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/columnar_file.h"
+
+#include "pascha/method_factory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+
+using namespace pascha;
+
+constexpr std::array<char, 8> kFileMagic{'P', 'A', 'S', 'C',
+                                         'H', 'C', 'O', 'L'};
+constexpr std::uint32_t kBlockMagic{0x4b424350}; // "PCBK"
+constexpr std::uint32_t kByteOrderMark{0x01020304};
+
+// Years between checks for cancellation and progress reports.
+constexpr std::uint64_t kColumnarCheckYears{4096};
+
+// Packed dates hold the year difference in the bits above the month and day.
+constexpr int kYearShift{9};
+constexpr std::uint64_t kMaxYearDifference{(std::uint64_t{1} << 22) - 1};
+
+struct FileHeader
+{
+  std::array<char, 8> magic;
+  std::uint32_t format_version;
+  std::uint32_t byte_order;
+  std::uint32_t column_count;
+  std::uint32_t block_rows;
+  std::uint64_t block_count;
+  std::uint64_t row_count;
+  std::uint64_t index_offset;
+  std::uint64_t checksum; // of the fields above, the columns and the index
+}; // struct FileHeader
+
+struct BlockHeader
+{
+  std::uint32_t magic;
+  std::uint32_t rows;
+  std::int64_t first_year;
+  std::uint32_t gap_bytes;
+  std::uint32_t reserved;
+}; // struct BlockHeader
+
+static_assert(sizeof(FileHeader) == 56);
+static_assert(sizeof(BlockHeader) == 24);
+static_assert(sizeof(ColumnarIndexEntry) == 32);
+
+// 64-bit FNV-1a, continuing from the given hash.
+std::uint64_t checksum(const void* data, std::size_t size,
+                       std::uint64_t hash = 0xcbf29ce484222325)
+{
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+} // checksum
+
+std::uint64_t headerChecksum(const FileHeader& header,
+                             std::span<const OptionKey> columns,
+                             std::span<const ColumnarIndexEntry> index)
+{
+  std::uint64_t hash{checksum(&header, offsetof(FileHeader, checksum))};
+  hash = checksum(columns.data(), columns.size_bytes(), hash);
+  return checksum(index.data(), index.size_bytes(), hash);
+} // headerChecksum
+
+constexpr std::uint64_t padding(std::uint64_t size, std::uint64_t alignment)
+{
+  return (alignment - size % alignment) % alignment;
+} // padding
+
+// Where the first block starts: after the header and the columns, aligned so
+// that the packed dates can be read in place.
+std::uint64_t firstBlockOffset(std::size_t column_count)
+{
+  std::uint64_t size{sizeof(FileHeader) + column_count * sizeof(OptionKey)};
+  return size + padding(size, 8);
+} // firstBlockOffset
+
+[[noreturn]] void throwCorrupt()
+{
+  throw std::runtime_error{"Corrupt columnar file"};
+} // throwCorrupt
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+std::uint32_t packDate(Year row_year, const Date& date)
+{
+  // The distance is taken as unsigned, so that it cannot overflow.
+  const std::uint64_t distance{
+      date.year >= row_year
+          ? static_cast<std::uint64_t>(date.year) -
+                static_cast<std::uint64_t>(row_year)
+          : static_cast<std::uint64_t>(row_year) -
+                static_cast<std::uint64_t>(date.year)};
+  if (distance > kMaxYearDifference) {
+    throw std::overflow_error{"Date too far from its year to pack"};
+  }
+  const auto difference{static_cast<std::int32_t>(date.year - row_year)};
+  return (static_cast<std::uint32_t>(difference) << kYearShift) |
+         (static_cast<std::uint32_t>(date.month & 0xf) << 5) |
+         static_cast<std::uint32_t>(date.day & 0x1f);
+} // packDate
+
+Date unpackDate(Year row_year, std::uint32_t packed)
+{
+  // Arithmetic shift of the signed difference.
+  const std::int32_t difference{static_cast<std::int32_t>(packed) >>
+                                kYearShift};
+  return Date{row_year + difference, static_cast<Month>((packed >> 5) & 0xf),
+              static_cast<Day>(packed & 0x1f)};
+} // unpackDate
+
+ColumnarWriter::ColumnarWriter(const std::filesystem::path& path,
+                               std::vector<OptionKey> columns,
+                               std::uint32_t block_rows)
+    : m_path{path},
+      m_file{path, std::ios::binary | std::ios::trunc},
+      m_columns{std::move(columns)},
+      m_block_rows{std::max<std::uint32_t>(block_rows, 1)},
+      m_dates(m_columns.size() * m_block_rows)
+{
+  if (!m_file) {
+    throw std::runtime_error{"Unable to create " + m_path.string()};
+  }
+  // A zeroed header, which readers reject until finish() replaces it.
+  const std::vector<char> placeholder(firstBlockOffset(m_columns.size()));
+  write(placeholder.data(), placeholder.size());
+} // ColumnarWriter::ColumnarWriter
+
+void ColumnarWriter::append(Year year, std::span<const Date> dates)
+{
+  if (dates.size() != m_columns.size()) {
+    throw std::invalid_argument{"A row needs one date per column"};
+  }
+  if (m_last_year && year <= *m_last_year) {
+    throw std::invalid_argument{"Years must be strictly ascending"};
+  }
+
+  if (m_rows == 0) {
+    m_block_first = year;
+  } else {
+    std::uint64_t gap{static_cast<std::uint64_t>(year) -
+                      static_cast<std::uint64_t>(*m_last_year) - 1};
+    while (gap >= 0x80) {
+      m_year_gaps.push_back(static_cast<std::uint8_t>(gap | 0x80));
+      gap >>= 7;
+    }
+    m_year_gaps.push_back(static_cast<std::uint8_t>(gap));
+  }
+  for (std::size_t column = 0; column < m_columns.size(); ++column) {
+    m_dates[column * m_block_rows + m_rows] = packDate(year, dates[column]);
+  }
+  m_last_year = year;
+  if (++m_rows == m_block_rows) { writeBlock(); }
+} // ColumnarWriter::append
+
+void ColumnarWriter::finish()
+{
+  writeBlock();
+  const std::uint64_t index_offset{m_offset};
+  write(m_index.data(), m_index.size() * sizeof(ColumnarIndexEntry));
+  writeHeader(index_offset);
+  m_file.close();
+  if (!m_file) {
+    throw std::runtime_error{"Unable to write " + m_path.string()};
+  }
+} // ColumnarWriter::finish
+
+void ColumnarWriter::write(const void* data, std::size_t size)
+{
+  m_file.write(static_cast<const char*>(data),
+               static_cast<std::streamsize>(size));
+  if (!m_file) {
+    throw std::runtime_error{"Unable to write " + m_path.string()};
+  }
+  m_offset += size;
+} // ColumnarWriter::write
+
+void ColumnarWriter::writeBlock()
+{
+  if (m_rows == 0) { return; }
+
+  constexpr std::array<char, 8> zeros{};
+  m_index.push_back(
+      ColumnarIndexEntry{m_block_first, *m_last_year, m_offset, m_rows});
+  BlockHeader header{kBlockMagic, m_rows, m_block_first,
+                     static_cast<std::uint32_t>(m_year_gaps.size()), 0};
+  write(&header, sizeof(header));
+  write(m_year_gaps.data(), m_year_gaps.size());
+  write(zeros.data(), padding(m_year_gaps.size(), 4));
+  for (std::size_t column = 0; column < m_columns.size(); ++column) {
+    write(m_dates.data() + column * m_block_rows,
+          m_rows * sizeof(std::uint32_t));
+  }
+  write(zeros.data(), padding(m_offset, 8));
+
+  m_total_rows += m_rows;
+  m_rows = 0;
+  m_year_gaps.clear();
+} // ColumnarWriter::writeBlock
+
+void ColumnarWriter::writeHeader(std::uint64_t index_offset)
+{
+  FileHeader header{kFileMagic,
+                    kColumnarFormatVersion,
+                    kByteOrderMark,
+                    static_cast<std::uint32_t>(m_columns.size()),
+                    m_block_rows,
+                    m_index.size(),
+                    m_total_rows,
+                    index_offset,
+                    0};
+  header.checksum = headerChecksum(header, m_columns, m_index);
+  m_file.seekp(0);
+  m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_file.write(reinterpret_cast<const char*>(m_columns.data()),
+               static_cast<std::streamsize>(m_columns.size() *
+                                            sizeof(OptionKey)));
+} // ColumnarWriter::writeHeader
+
+ColumnarBlock::ColumnarBlock(Year first_year, std::size_t rows,
+                             std::vector<Year> years,
+                             const std::uint32_t* dates, std::size_t columns)
+    : m_first_year{first_year}, m_rows{rows}, m_years{std::move(years)},
+      m_dates{dates}, m_columns{columns}
+{
+} // ColumnarBlock::ColumnarBlock
+
+Year ColumnarBlock::year(std::size_t row) const
+{
+  if (row >= m_rows) { throw std::out_of_range{"No such row"}; }
+  if (m_years.empty()) {
+    return static_cast<Year>(static_cast<std::uint64_t>(m_first_year) + row);
+  }
+  return m_years[row];
+} // ColumnarBlock::year
+
+std::optional<std::size_t> ColumnarBlock::findRow(Year year) const
+{
+  if (m_years.empty()) {
+    const std::uint64_t row{static_cast<std::uint64_t>(year) -
+                            static_cast<std::uint64_t>(m_first_year)};
+    if (year < m_first_year || row >= m_rows) { return std::nullopt; }
+    return static_cast<std::size_t>(row);
+  }
+  auto found{std::ranges::lower_bound(m_years, year)};
+  if (found == m_years.end() || *found != year) { return std::nullopt; }
+  return static_cast<std::size_t>(found - m_years.begin());
+} // ColumnarBlock::findRow
+
+std::span<const std::uint32_t>
+    ColumnarBlock::packedDates(std::size_t column) const
+{
+  if (column >= m_columns) { throw std::out_of_range{"No such column"}; }
+  return {m_dates + column * m_rows, m_rows};
+} // ColumnarBlock::packedDates
+
+Date ColumnarBlock::date(std::size_t row, std::size_t column) const
+{
+  return unpackDate(year(row), packedDates(column)[row]);
+} // ColumnarBlock::date
+
+ColumnarReader::ColumnarReader(const std::filesystem::path& path)
+    : m_file{path}
+{
+  const std::byte* data{m_file.data()};
+  const std::size_t size{m_file.size()};
+
+  FileHeader header{};
+  if (size < sizeof(header)) { throwCorrupt(); }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kFileMagic) {
+    throw std::runtime_error{path.string() + " is not a columnar file"};
+  }
+  if (header.format_version != kColumnarFormatVersion ||
+      header.byte_order != kByteOrderMark) {
+    throw std::runtime_error{path.string() +
+                             " is from another version or byte order"};
+  }
+
+  const std::uint64_t blocks_start{firstBlockOffset(header.column_count)};
+  if (blocks_start > size || header.index_offset < blocks_start ||
+      header.index_offset > size ||
+      header.block_count > (size - header.index_offset) /
+                               sizeof(ColumnarIndexEntry)) {
+    throwCorrupt();
+  }
+  m_columns.resize(header.column_count);
+  std::memcpy(m_columns.data(), data + sizeof(header),
+              m_columns.size() * sizeof(OptionKey));
+  m_index.resize(header.block_count);
+  std::memcpy(m_index.data(), data + header.index_offset,
+              m_index.size() * sizeof(ColumnarIndexEntry));
+  if (headerChecksum(header, m_columns, m_index) != header.checksum) {
+    throwCorrupt();
+  }
+
+  // Each block must lie between the columns and the index, in year and file
+  // order.
+  const std::uint64_t dates_per_row{m_columns.size() * sizeof(std::uint32_t)};
+  for (std::size_t i = 0; i < m_index.size(); ++i) {
+    const ColumnarIndexEntry& entry{m_index[i]};
+    if (entry.rows == 0 || entry.first_year > entry.last_year ||
+        entry.offset < blocks_start || entry.offset % 8 != 0 ||
+        entry.offset > header.index_offset ||
+        entry.rows > (header.index_offset - entry.offset) /
+                         std::max<std::uint64_t>(dates_per_row, 1) ||
+        (i > 0 && (entry.first_year <= m_index[i - 1].last_year ||
+                   entry.offset <= m_index[i - 1].offset))) {
+      throwCorrupt();
+    }
+    m_rows += entry.rows;
+  }
+  if (m_rows != header.row_count) { throwCorrupt(); }
+  m_index_offset = header.index_offset;
+} // ColumnarReader::ColumnarReader
+
+Year ColumnarReader::firstYear() const
+{
+  return m_index.empty() ? 0 : m_index.front().first_year;
+} // ColumnarReader::firstYear
+
+Year ColumnarReader::lastYear() const
+{
+  return m_index.empty() ? 0 : m_index.back().last_year;
+} // ColumnarReader::lastYear
+
+ColumnarBlock ColumnarReader::block(std::size_t index) const
+{
+  const ColumnarIndexEntry& entry{m_index.at(index)};
+  // The last block ends where the index starts.
+  const std::uint64_t end{index + 1 < m_index.size()
+                              ? m_index[index + 1].offset
+                              : m_index_offset};
+  const std::byte* data{m_file.data() + entry.offset};
+
+  BlockHeader header{};
+  if (end - entry.offset < sizeof(header)) { throwCorrupt(); }
+  std::memcpy(&header, data, sizeof(header));
+  const std::uint64_t gaps_end{sizeof(header) + header.gap_bytes +
+                               padding(header.gap_bytes, 4)};
+  if (header.magic != kBlockMagic || header.rows != entry.rows ||
+      header.first_year != entry.first_year ||
+      gaps_end + entry.rows * m_columns.size() * sizeof(std::uint32_t) >
+          end - entry.offset) {
+    throwCorrupt();
+  }
+
+  const std::uint32_t* dates{
+      reinterpret_cast<const std::uint32_t*>(data + gaps_end)};
+  const auto span{static_cast<std::uint64_t>(entry.last_year) -
+                  static_cast<std::uint64_t>(entry.first_year)};
+  if (span + 1 == entry.rows) {
+    // Consecutive years, whose gaps need not be decoded.
+    return ColumnarBlock{entry.first_year, entry.rows, {}, dates,
+                         m_columns.size()};
+  }
+
+  std::vector<Year> years{};
+  years.reserve(entry.rows);
+  years.push_back(header.first_year);
+  const auto* gap_byte{reinterpret_cast<const std::uint8_t*>(data) +
+                       sizeof(header)};
+  const auto* gaps_last{gap_byte + header.gap_bytes};
+  while (gap_byte != gaps_last && years.size() < entry.rows) {
+    std::uint64_t gap{0};
+    for (int shift = 0; gap_byte != gaps_last; shift += 7) {
+      const std::uint8_t byte{*gap_byte++};
+      if (shift < 64) { gap |= std::uint64_t{byte & 0x7fu} << shift; }
+      if (!(byte & 0x80)) { break; }
+    }
+    years.push_back(static_cast<Year>(static_cast<std::uint64_t>(years.back()) +
+                                      gap + 1));
+  }
+  if (years.size() != entry.rows || gap_byte != gaps_last ||
+      years.back() != entry.last_year) {
+    throwCorrupt();
+  }
+
+  return ColumnarBlock{entry.first_year, entry.rows, std::move(years), dates,
+                       m_columns.size()};
+} // ColumnarReader::block
+
+std::optional<std::size_t> ColumnarReader::findBlock(Year year) const
+{
+  auto entry{std::ranges::lower_bound(m_index, year, {},
+                                      &ColumnarIndexEntry::last_year)};
+  if (entry == m_index.end() || entry->first_year > year) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(entry - m_index.begin());
+} // ColumnarReader::findBlock
+
+std::optional<Date> ColumnarReader::find(Year year, std::size_t column) const
+{
+  if (column >= m_columns.size()) {
+    throw std::out_of_range{"No such column"};
+  }
+  std::optional<std::size_t> index{findBlock(year)};
+  if (!index) { return std::nullopt; }
+
+  ColumnarBlock found{block(*index)};
+  std::optional<std::size_t> row{found.findRow(year)};
+  if (!row) { return std::nullopt; }
+  return found.date(*row, column);
+} // ColumnarReader::find
+
+void exportColumnar(const std::filesystem::path& path,
+                    std::span<const CalculationOptions> columns, Year first,
+                    Year last, const RangeControl& control)
+{
+  if (last < first) {
+    throw std::invalid_argument{"The last year is before the first"};
+  }
+
+  std::vector<std::unique_ptr<ICalculationMethod>> methods{};
+  std::vector<OptionKey> keys{};
+  for (const CalculationOptions& column : columns) {
+    if (!column.target_outputs.empty() &&
+        column.target_outputs.front() == e_target_output::daysUntil) {
+      throw std::invalid_argument{"Days until is not a date"};
+    }
+    methods.push_back(makeCalculationMethod(column));
+    keys.push_back(packOptions(column));
+  }
+
+  ColumnarWriter writer{path, std::move(keys)};
+  std::vector<Date> row(methods.size());
+  const auto years_total{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first) + 1};
+  ProgressReporter progress{years_total, control.progress,
+                            control.progress_interval};
+  std::uint64_t unchecked{0};
+  for (Year year = first;; ++year) {
+    for (std::size_t column = 0; column < methods.size(); ++column) {
+      row[column] = methods[column]->calculate(year);
+    }
+    writer.append(year, row);
+
+    if (++unchecked == kColumnarCheckYears || year == last) {
+      if (control.cancellation && control.cancellation->cancelled()) {
+        throw OperationCancelled{};
+      }
+      progress.advance(unchecked);
+      unchecked = 0;
+    }
+    if (year == last) { break; }
+  }
+  writer.finish();
+  progress.finish();
+} // exportColumnar
+
+} // namespace pascha
@@ -0,0 +1,108 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/countdown.h"
+
+#include "pascha/calendar_conversion.h"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+namespace pascha
+{
+
+std::vector<Countdown> daysUntilNext(const ICalculationMethod& method,
+                                     std::size_t count, const IClock& clock)
+{
+  std::vector<Countdown> countdowns{};
+  countdowns.reserve(count);
+
+  // Read the clock once, so that the whole series is relative to one day.
+  const Today today{clock.snapshot()};
+  for (Year year = today.date.year; countdowns.size() < count; ++year) {
+    Date date{method.calculate(year)};
+    CalcInt days{gregorianToJdn(date) - today.jdn};
+    if (days >= 0) { countdowns.push_back(Countdown{year, date, Days{days}}); }
+  }
+  return countdowns;
+} // daysUntilNext
+
+namespace
+{
+
+// The next date of one feast in the merge.
+struct FeastCursor
+{
+  CalcInt jdn;
+  std::size_t feast;
+  Year year;
+  Date date;
+
+  bool operator>(const FeastCursor& other) const
+  {
+    return std::tie(jdn, feast) > std::tie(other.jdn, other.feast);
+  }
+}; // struct FeastCursor
+
+FeastCursor feastCursor(const ICalculationMethod& method,
+                        std::span<const Feast> feasts, std::size_t feast,
+                        Year year)
+{
+  Date date{addDays(method.calculate(year), feasts[feast].offset)};
+  return FeastCursor{gregorianToJdn(date), feast, year, date};
+} // feastCursor
+
+} // anonymous namespace
+
+Generator<FeastCountdown> upcomingFeasts(const ICalculationMethod& method,
+                                         const IClock& clock,
+                                         std::span<const Feast> feasts)
+{
+  // Read the clock once, so that the year and day agree.
+  const Today today{clock.snapshot()};
+  const CalcInt today_jdn{today.jdn};
+  const Year this_year{today.date.year};
+
+  // Each feast's dates are already in order, so a min-heap holding the next
+  // date of each one merges them.
+  std::vector<FeastCursor> heap{};
+  heap.reserve(feasts.size());
+  for (std::size_t feast = 0; feast < feasts.size(); ++feast) {
+    // Start a year early, in case a feast falls in the next calendar year.
+    FeastCursor cursor{feastCursor(method, feasts, feast, this_year - 1)};
+    while (cursor.jdn < today_jdn) {
+      cursor = feastCursor(method, feasts, feast, cursor.year + 1);
+    }
+    heap.push_back(cursor);
+  }
+  std::ranges::make_heap(heap, std::greater{});
+
+  while (!heap.empty()) {
+    std::ranges::pop_heap(heap, std::greater{});
+    FeastCursor& next{heap.back()};
+    co_yield FeastCountdown{&feasts[next.feast], next.year, next.date,
+                            Days{next.jdn - today_jdn}};
+    next = feastCursor(method, feasts, next.feast, next.year + 1);
+    std::ranges::push_heap(heap, std::greater{});
+  }
+} // upcomingFeasts
+
+} // namespace pascha
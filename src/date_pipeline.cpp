@@ -0,0 +1,52 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/date_pipeline.h"
+
+#include "pascha/feasts.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace pascha
+{
+
+DatePipeline::DatePipeline(const CalculationOptions& options)
+    : m_computus{computusFor(options.calculation_method)}
+{
+  ETargetOutput target{options.target_outputs.empty()
+                           ? ETargetOutput{e_target_output::pascha}
+                           : options.target_outputs.front()};
+  if (target == e_target_output::weeksBetween) {
+    throw std::invalid_argument{"Weeks between does not calculate a date"};
+  }
+  // Days until counts from Pascha in the Gregorian calendar, as it is.
+  if (target == e_target_output::daysUntil) { return; }
+
+  // Any other target is Pascha.
+  auto feast{std::ranges::find(kFeasts, target, &Feast::target)};
+  if (feast != kFeasts.end()) { m_offset = feast->offset; }
+  m_calendar = outputCalendarFor(options.output_calendar);
+  m_byzantine = std::ranges::find(options.options,
+                                  e_output_option::byzantine) !=
+                options.options.end();
+} // DatePipeline::DatePipeline
+
+} // namespace pascha
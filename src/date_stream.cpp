@@ -0,0 +1,60 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/date_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pascha
+{
+
+Generator<YearResult> streamDates(const ICalculationMethod& method, Year first,
+                                  Year last, std::size_t batch_years)
+{
+  if (last < first) { co_return; }
+  if (batch_years == 0) { batch_years = kStreamBatchYears; }
+
+  // Offsets from first, so that a range ending at the largest Year cannot
+  // overflow.
+  const auto last_offset{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first)};
+  std::vector<Date> batch(batch_years);
+
+  std::uint64_t offset{0};
+  while (true) {
+    const std::uint64_t count{
+        std::min<std::uint64_t>(batch_years - 1, last_offset - offset) + 1};
+    const auto batch_first{static_cast<std::uint64_t>(first) + offset};
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+      batch[i] = method.calculate(static_cast<Year>(batch_first + i));
+    }
+    for (std::uint64_t i = 0; i < count; ++i) {
+      co_yield YearResult{static_cast<Year>(batch_first + i), batch[i]};
+    }
+
+    if (last_offset - offset < batch_years) { co_return; }
+    offset += batch_years;
+  }
+} // streamDates
+
+} // namespace pascha
@@ -0,0 +1,127 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/divergence.h"
+
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+
+using namespace pascha;
+
+// Days from the Gregorian to the Julian date of Pascha, as
+// gregorianToJdn(julianPascha(year)) - gregorianToJdn(gregorianPascha(year)).
+//
+// Both computus give Pascha as a number of days after March 22nd, and any
+// date from March onwards is floor(y / 100) - floor(y / 400) - 2 days later in
+// the Gregorian calendar than in the Julian one, so the difference needs
+// neither dates nor day numbers. Only valid for years >= 0, for which the
+// divisions below are floor divisions.
+inline CalcInt daysBetween(CalcInt year)
+{
+  // Julian computus
+  CalcInt julian_d = (19 * (year % 19) + 15) % 30;
+  CalcInt julian_e = (2 * (year % 4) + 4 * (year % 7) - julian_d + 34) % 7;
+
+  // Gregorian computus
+  CalcInt a = year % 19;
+  CalcInt b = year / 100;
+  CalcInt c = year % 100;
+  CalcInt d = b / 4;
+  CalcInt e = b % 4;
+  CalcInt f = (b + 8) / 25;
+  CalcInt g = (b - f + 1) / 3;
+  CalcInt h = (19 * a + b - d - g + 15) % 30;
+  CalcInt i = c / 4;
+  CalcInt k = c % 4;
+  CalcInt l = (32 + 2 * e + 2 * i - h - k) % 7;
+  CalcInt m = (a + 11 * h + 22 * l) / 451;
+
+  CalcInt calendar_offset = b - d - 2;
+  return julian_d + julian_e + calendar_offset - (h + l - 7 * m);
+} // daysBetween
+
+// As above, through the dates, for the years daysBetween does not cover.
+CalcInt daysBetweenByDates(Year year)
+{
+  return gregorianToJdn(julianPascha(year)) -
+         gregorianToJdn(gregorianPascha(year));
+} // daysBetweenByDates
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+DivergenceSummary analyseDivergence(Year first, Year last,
+                                    std::span<std::int64_t> weeks,
+                                    std::vector<Year>* coincident_years)
+{
+  if (last < first) { throw std::invalid_argument{"Invalid year range"}; }
+  std::uint64_t count{static_cast<std::uint64_t>(last) -
+                      static_cast<std::uint64_t>(first) + 1};
+  if (!weeks.empty() && weeks.size() != count) {
+    throw std::invalid_argument{"Weeks do not match the year range"};
+  }
+
+  // The dates can be calculated for every year between two which can, so
+  // checking the ends throws std::overflow_error for any which cannot.
+  daysBetweenByDates(first);
+  daysBetweenByDates(last);
+
+  DivergenceSummary summary{};
+  summary.first = first;
+  summary.last = last;
+  summary.years = count;
+  summary.max_weeks = std::numeric_limits<std::int64_t>::min();
+  summary.max_year = first;
+
+  auto reduce = [&](Year year, CalcInt days) {
+    CalcInt week_count{days / 7};
+    summary.total_weeks += week_count;
+    if (days == 0) {
+      ++summary.coincident;
+      if (coincident_years) { coincident_years->push_back(year); }
+    }
+    if (week_count > summary.max_weeks) {
+      summary.max_weeks = week_count;
+      summary.max_year = year;
+    }
+    if (!weeks.empty()) {
+      weeks[static_cast<std::uint64_t>(year - first)] = week_count;
+    }
+  };
+
+  // The ends were checked above, so the loops cannot overflow.
+  Year year{first};
+  for (; year <= last && year < 0; ++year) {
+    reduce(year, daysBetweenByDates(year));
+  }
+  for (; year <= last; ++year) { reduce(year, daysBetween(year)); }
+
+  return summary;
+} // analyseDivergence
+
+} // namespace pascha
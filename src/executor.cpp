@@ -0,0 +1,69 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/executor.h"
+
+namespace pascha
+{
+
+SerialExecutor::SerialExecutor() : m_thread{&SerialExecutor::workerLoop, this}
+{
+} // SerialExecutor::SerialExecutor
+
+SerialExecutor::~SerialExecutor()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  m_thread.join();
+} // SerialExecutor::~SerialExecutor
+
+JobHandle SerialExecutor::submit(std::function<void()> job,
+                                 CancellationToken cancellation)
+{
+  std::packaged_task<void()> task{std::move(job)};
+  JobHandle handle{task.get_future().share(), std::move(cancellation)};
+  {
+    std::lock_guard lock{m_mutex};
+    m_jobs.push_back(std::move(task));
+  }
+  m_wake.notify_one();
+  return handle;
+} // SerialExecutor::submit
+
+void SerialExecutor::workerLoop()
+{
+  while (true) {
+    std::packaged_task<void()> task{};
+    {
+      std::unique_lock lock{m_mutex};
+      m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+      if (m_stop) { return; }
+      task = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+    // Exceptions are stored in the job's future.
+    task();
+  }
+} // SerialExecutor::workerLoop
+
+} // namespace pascha
@@ -0,0 +1,222 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/export.h"
+
+#include "pascha/bulk_date_formatter.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+#include "pascha/executor.h"
+#include "pascha/feasts.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+// Years between checks for cancellation and progress reports.
+constexpr std::uint64_t kExportCheckYears{4096};
+
+const Feast& findFeast(ETargetOutput target)
+{
+  auto feast{std::ranges::find(kFeasts, target, &Feast::target)};
+  if (feast == kFeasts.end()) {
+    throw std::invalid_argument{"Only the dates of feasts can be exported"};
+  }
+  return *feast;
+} // findFeast
+
+void checkSeparator(std::string_view separator)
+{
+  for (char c : separator) {
+    if (c == ',' || c == '"' || c == '\\' ||
+        static_cast<unsigned char>(c) < 0x20) {
+      throw std::invalid_argument{
+          "The date separator cannot contain commas, quotes, backslashes or "
+          "control characters"};
+    }
+  }
+} // checkSeparator
+
+char* append(char* out, std::string_view text)
+{
+  std::memcpy(out, text.data(), text.size());
+  return out + text.size();
+} // append
+
+// Gathers text in one buffer while the other is written out on a thread of
+// its own.
+class DoubleBuffer
+{
+ public:
+  DoubleBuffer(std::ostream& out, std::size_t flush_bytes,
+               std::size_t max_row)
+    : m_out{&out}, m_flush_bytes{std::max<std::size_t>(flush_bytes, 1)},
+      m_buffers{std::make_unique<char[]>(m_flush_bytes + max_row),
+                std::make_unique<char[]>(m_flush_bytes + max_row)},
+      m_end{m_buffers[0].get()}
+  {
+  }
+
+  // Where to write the next row, which has room for max_row characters.
+  char* end() const { return m_end; }
+  // Take the row written up to end, writing the buffer out once it is full.
+  void commit(char* end)
+  {
+    m_end = end;
+    if (size() >= m_flush_bytes) { flush(); }
+  }
+  void finish()
+  {
+    flush();
+    waitForWriter();
+    m_out->flush();
+    if (!*m_out) { throw std::runtime_error{"Failed to write the export"}; }
+  }
+
+ private:
+  std::ostream* m_out;
+  std::size_t m_flush_bytes;
+  std::array<std::unique_ptr<char[]>, 2> m_buffers;
+  std::size_t m_filling{0};
+  char* m_end;
+  JobHandle m_writing{};
+  // Declared last, so that its thread finishes before the buffers go.
+  SerialExecutor m_writer{};
+
+  std::size_t size() const
+  {
+    return static_cast<std::size_t>(m_end - m_buffers[m_filling].get());
+  }
+
+  void waitForWriter()
+  {
+    m_writing.wait();
+    if (!*m_out) { throw std::runtime_error{"Failed to write the export"}; }
+  }
+
+  void flush()
+  {
+    if (size() == 0) { return; }
+    waitForWriter();
+    const char* data{m_buffers[m_filling].get()};
+    const auto count{static_cast<std::streamsize>(size())};
+    m_writing = m_writer.submit([this, data, count] {
+      m_out->write(data, count);
+    });
+    m_filling = 1 - m_filling;
+    m_end = m_buffers[m_filling].get();
+  }
+}; // class DoubleBuffer
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+void exportRange(const ExportOptions& options, Year first, Year last,
+                 std::ostream& out, const RangeControl& control)
+{
+  if (last < first) {
+    throw std::invalid_argument{"The last year is before the first"};
+  }
+  checkSeparator(options.date_separator);
+
+  const CalculationOptions& calculation{options.calculation};
+  std::vector<const Feast*> feasts{};
+  for (ETargetOutput target : calculation.target_outputs) {
+    feasts.push_back(&findFeast(target));
+  }
+  if (feasts.empty()) { feasts.push_back(&findFeast(e_target_output::pascha)); }
+
+  const Computus computus{computusFor(calculation.calculation_method)};
+  const OutputCalendarConversion output_calendar{
+      outputCalendarFor(calculation.output_calendar)};
+  const bool byzantine{std::ranges::find(calculation.options,
+                                         e_output_option::byzantine) !=
+                       calculation.options.end()};
+  const BulkDateFormatter formatter{options.date_format,
+                                    options.date_separator};
+
+  // The text around each field, rendered once.
+  const bool json{options.format == ExportFormat::jsonLines};
+  const std::string_view row_start{json ? "{\"year\":" : ""};
+  const std::string_view row_end{json ? "}\n" : "\n"};
+  const std::string_view field_end{json ? "\"" : ""};
+  std::vector<std::string> field_starts{};
+  std::size_t max_row{row_start.size() + BulkDateFormatter::kMaxYearSize +
+                      row_end.size()};
+  for (const Feast* feast : feasts) {
+    field_starts.push_back(json ? ",\"" + std::string{feast->name} + "\":\""
+                                : std::string{","});
+    max_row +=
+        field_starts.back().size() + formatter.maxSize() + field_end.size();
+  }
+
+  DoubleBuffer buffer{out, options.flush_bytes, max_row};
+  if (!json) {
+    std::string header{"year"};
+    for (const Feast* feast : feasts) {
+      header += ',';
+      header += feast->name;
+    }
+    header += '\n';
+    buffer.commit(append(buffer.end(), header));
+  }
+
+  const auto years_total{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first) + 1};
+  ProgressReporter progress{years_total, control.progress,
+                            control.progress_interval};
+  std::uint64_t unchecked{0};
+  for (Year year = first;; ++year) {
+    const Date pascha{computus(year)};
+    char* end{append(buffer.end(), row_start)};
+    end = BulkDateFormatter::writeYear(year, end);
+    for (std::size_t i = 0; i < feasts.size(); ++i) {
+      Date date{output_calendar(addDays(pascha, feasts[i]->offset))};
+      if (byzantine) { date = toByzantine(date); }
+      end = append(end, field_starts[i]);
+      end = append(formatter.write(date, end), field_end);
+    }
+    buffer.commit(append(end, row_end));
+
+    if (++unchecked == kExportCheckYears || year == last) {
+      if (control.cancellation && control.cancellation->cancelled()) {
+        throw OperationCancelled{};
+      }
+      progress.advance(unchecked);
+      unchecked = 0;
+    }
+    if (year == last) { break; }
+  }
+  buffer.finish();
+  progress.finish();
+} // exportRange
+
+} // namespace pascha
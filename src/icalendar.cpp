@@ -0,0 +1,270 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/icalendar.h"
+
+#include "pascha/bulk_date_formatter.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+#include "pascha/feasts.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+// Years between checks for cancellation and progress reports.
+constexpr std::uint64_t kICalendarCheckYears{4096};
+// Bytes of text gathered before they are written out.
+constexpr std::size_t kICalendarFlushBytes{std::size_t{1} << 16};
+// Characters in a date written as YYYYMMDD.
+constexpr std::size_t kBasicDateSize{8};
+
+constexpr std::string_view kEventStart{"BEGIN:VEVENT\r\nUID:"};
+constexpr std::string_view kEventEnd{"TRANSP:TRANSPARENT\r\nEND:VEVENT\r\n"};
+constexpr std::string_view kDescriptionEnd{
+    "\r\nTRANSP:TRANSPARENT\r\nEND:VEVENT\r\n"};
+
+// The text of one feast's events, split around the parts which change with
+// the year.
+struct EventFragments
+{
+  const Feast* feast;
+  // From the year in the UID to the start date.
+  std::string after_year;
+  // From the start date to the date in the description, or to kEventEnd if
+  // there is no description.
+  std::string after_start;
+}; // struct EventFragments
+
+std::string_view methodName(ECalculationMethod method)
+{
+  return method == e_calculation_method::gregorian ? "gregorian" : "julian";
+} // methodName
+
+std::string_view calendarName(EOutputCalendar calendar)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return "Gregorian";
+    case e_output_calendar::rev_julian: return "Revised Julian";
+    default: return "Julian";
+  }
+} // calendarName
+
+std::vector<const Feast*> eventFeasts(const CalculationOptions& calculation)
+{
+  std::vector<const Feast*> feasts{};
+  for (ETargetOutput target : calculation.target_outputs) {
+    auto feast{std::ranges::find(kFeasts, target, &Feast::target)};
+    if (feast == kFeasts.end()) {
+      throw std::invalid_argument{
+          "Only feasts can be written to a calendar"};
+    }
+    feasts.push_back(&*feast);
+  }
+  if (feasts.empty()) {
+    for (const Feast& feast : kFeasts) { feasts.push_back(&feast); }
+  }
+  // In the order they fall within the year, each once.
+  std::ranges::stable_sort(feasts, {}, &Feast::offset);
+  auto duplicates{std::ranges::unique(feasts)};
+  feasts.erase(duplicates.begin(), duplicates.end());
+  return feasts;
+} // eventFeasts
+
+std::string currentTimestamp()
+{
+  using namespace std::chrono;
+  const auto now{floor<seconds>(system_clock::now())};
+  const auto today{floor<days>(now)};
+  const year_month_day date{today};
+  const hh_mm_ss time{now - today};
+  char text[32];
+  std::snprintf(text, sizeof(text), "%04d%02u%02uT%02d%02d%02dZ",
+                static_cast<int>(date.year()),
+                static_cast<unsigned>(date.month()),
+                static_cast<unsigned>(date.day()),
+                static_cast<int>(time.hours().count()),
+                static_cast<int>(time.minutes().count()),
+                static_cast<int>(time.seconds().count()));
+  return text;
+} // currentTimestamp
+
+// Check the timestamp is exactly YYYYMMDDTHHMMSSZ, with each field in range.
+void checkTimestamp(std::string_view timestamp)
+{
+  constexpr std::string_view kForm{"00000000T000000Z"};
+  bool valid{timestamp.size() == kForm.size()};
+  for (std::size_t i = 0; valid && i < kForm.size(); ++i) {
+    valid = kForm[i] == '0' ? timestamp[i] >= '0' && timestamp[i] <= '9'
+                            : timestamp[i] == kForm[i];
+  }
+  auto field{[timestamp](std::size_t at) {
+    return static_cast<unsigned>(timestamp[at] - '0') * 10 +
+           static_cast<unsigned>(timestamp[at + 1] - '0');
+  }};
+  // A leap second may be 60.
+  if (!valid || field(4) < 1 || field(4) > 12 || field(6) < 1 ||
+      field(6) > 31 || field(9) > 23 || field(11) > 59 || field(13) > 60) {
+    throw std::invalid_argument{"The timestamp is not a UTC date-time"};
+  }
+} // checkTimestamp
+
+char* append(char* out, std::string_view text)
+{
+  std::memcpy(out, text.data(), text.size());
+  return out + text.size();
+} // append
+
+char* writeTwoDigits(unsigned value, char* out)
+{
+  out[0] = static_cast<char>('0' + value / 10);
+  out[1] = static_cast<char>('0' + value % 10);
+  return out + 2;
+} // writeTwoDigits
+
+// Write a date as YYYYMMDD; the year must have four digits at most.
+char* writeBasicDate(const Date& date, char* out)
+{
+  const auto year{static_cast<unsigned>(date.year)};
+  out = writeTwoDigits(year / 100, out);
+  out = writeTwoDigits(year % 100, out);
+  out = writeTwoDigits(static_cast<unsigned>(date.month), out);
+  return writeTwoDigits(static_cast<unsigned>(date.day), out);
+} // writeBasicDate
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+void writeICalendar(const ICalendarOptions& options, Year first, Year last,
+                    std::ostream& out, const RangeControl& control)
+{
+  if (last < first) {
+    throw std::invalid_argument{"The last year is before the first"};
+  }
+  if (first < kICalendarFirstYear || last > kICalendarLastYear) {
+    throw std::out_of_range{"iCalendar dates must be in the years 1 to 9999"};
+  }
+  const std::string timestamp{options.timestamp.empty() ? currentTimestamp()
+                                                        : options.timestamp};
+  checkTimestamp(timestamp);
+
+  const CalculationOptions& calculation{options.calculation};
+  const Computus computus{computusFor(calculation.calculation_method)};
+  const OutputCalendarConversion output_calendar{
+      outputCalendarFor(calculation.output_calendar)};
+  const bool byzantine{std::ranges::find(calculation.options,
+                                         e_output_option::byzantine) !=
+                       calculation.options.end()};
+  const bool describe{
+      byzantine || calculation.output_calendar != e_output_calendar::gregorian};
+  const BulkDateFormatter formatter{options.date_format, "-"};
+
+  // Everything but the years and dates, rendered once.
+  std::string description{};
+  if (describe) {
+    description = "DESCRIPTION:";
+    description += calendarName(calculation.output_calendar);
+    description += byzantine ? " calendar (Byzantine era): " : " calendar: ";
+  }
+  std::vector<EventFragments> events{};
+  std::size_t max_year{kEventStart.size() + BulkDateFormatter::kMaxYearSize};
+  for (const Feast* feast : eventFeasts(calculation)) {
+    EventFragments& event{events.emplace_back()};
+    event.feast = feast;
+    event.after_year = "-" + feastSlug(*feast) + "-";
+    event.after_year += methodName(calculation.calculation_method);
+    event.after_year += "@pascha-lib\r\nDTSTAMP:" + timestamp +
+                        "\r\nDTSTART;VALUE=DATE:";
+    event.after_start = "\r\nSUMMARY:" + std::string{feast->name} + "\r\n" +
+                        description;
+    max_year += event.after_year.size() + kBasicDateSize +
+                event.after_start.size() + formatter.maxSize() +
+                kDescriptionEnd.size();
+  }
+
+  std::vector<char> buffer(kICalendarFlushBytes + max_year);
+  char* const begin{buffer.data()};
+  char* end{begin};
+  auto flush{[&] {
+    out.write(begin, end - begin);
+    if (!out) { throw std::runtime_error{"Failed to write the calendar"}; }
+    end = begin;
+  }};
+
+  end = append(end, "BEGIN:VCALENDAR\r\n"
+                    "VERSION:2.0\r\n"
+                    "PRODID:-//pascha//pascha-lib//EN\r\n"
+                    "CALSCALE:GREGORIAN\r\n"
+                    "METHOD:PUBLISH\r\n");
+
+  const auto years_total{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first) + 1};
+  ProgressReporter progress{years_total, control.progress,
+                            control.progress_interval};
+  std::uint64_t unchecked{0};
+  for (Year year = first;; ++year) {
+    const Date pascha{computus(year)};
+    for (const EventFragments& event : events) {
+      const Date civil{addDays(pascha, event.feast->offset)};
+      end = append(end, kEventStart);
+      end = BulkDateFormatter::writeYear(year, end);
+      end = append(end, event.after_year);
+      end = writeBasicDate(civil, end);
+      end = append(end, event.after_start);
+      if (describe) {
+        Date date{output_calendar(civil)};
+        if (byzantine) { date = toByzantine(date); }
+        end = append(formatter.write(date, end), kDescriptionEnd);
+      } else {
+        end = append(end, kEventEnd);
+      }
+    }
+    if (static_cast<std::size_t>(end - begin) >= kICalendarFlushBytes) {
+      flush();
+    }
+
+    if (++unchecked == kICalendarCheckYears || year == last) {
+      if (control.cancellation && control.cancellation->cancelled()) {
+        throw OperationCancelled{};
+      }
+      progress.advance(unchecked);
+      unchecked = 0;
+    }
+    if (year == last) { break; }
+  }
+  end = append(end, "END:VCALENDAR\r\n");
+  flush();
+  out.flush();
+  if (!out) { throw std::runtime_error{"Failed to write the calendar"}; }
+  progress.finish();
+} // writeICalendar
+
+} // namespace pascha
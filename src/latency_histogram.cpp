@@ -0,0 +1,115 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/latency_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace pascha
+{
+
+void LatencyHistogram::record(Duration latency, std::uint64_t count)
+{
+  if (count == 0) { return; }
+  auto nanoseconds{static_cast<std::uint64_t>(
+      std::max(latency.count(), Duration::rep{0}))};
+  m_buckets[bucketOf(nanoseconds)].fetch_add(count,
+                                             std::memory_order_relaxed);
+  m_count.fetch_add(count, std::memory_order_relaxed);
+  m_total.fetch_add(nanoseconds * count, std::memory_order_relaxed);
+  std::uint64_t max{m_max.load(std::memory_order_relaxed)};
+  while (nanoseconds > max &&
+         !m_max.compare_exchange_weak(max, nanoseconds,
+                                      std::memory_order_relaxed)) {}
+} // LatencyHistogram::record
+
+void LatencyHistogram::reset()
+{
+  for (auto& bucket : m_buckets) { bucket.store(0, std::memory_order_relaxed); }
+  m_count.store(0, std::memory_order_relaxed);
+  m_total.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+} // LatencyHistogram::reset
+
+std::uint64_t LatencyHistogram::count() const
+{
+  return m_count.load(std::memory_order_relaxed);
+} // LatencyHistogram::count
+
+LatencyHistogram::Duration LatencyHistogram::max() const
+{
+  return Duration{static_cast<Duration::rep>(m_max.load())};
+} // LatencyHistogram::max
+
+LatencyHistogram::Duration LatencyHistogram::mean() const
+{
+  std::uint64_t count{m_count.load()};
+  if (count == 0) { return Duration{0}; }
+  return Duration{static_cast<Duration::rep>(m_total.load() / count)};
+} // LatencyHistogram::mean
+
+LatencyHistogram::Duration LatencyHistogram::percentile(double fraction) const
+{
+  // Concurrent recording may make the buckets and count disagree slightly, so
+  // rank against the buckets themselves.
+  std::uint64_t total{0};
+  for (const auto& bucket : m_buckets) {
+    total += bucket.load(std::memory_order_relaxed);
+  }
+  if (total == 0) { return Duration{0}; }
+
+  fraction = std::clamp(fraction, 0.0, 1.0);
+  auto rank{std::max(std::uint64_t{1},
+                     static_cast<std::uint64_t>(std::ceil(
+                         fraction * static_cast<double>(total))))};
+  std::uint64_t seen{0};
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += m_buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return Duration{static_cast<Duration::rep>(
+          std::min(bucketTop(i), m_max.load(std::memory_order_relaxed)))};
+    }
+  }
+  return max();
+} // LatencyHistogram::percentile
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t nanoseconds)
+{
+  if (nanoseconds < kSubBuckets) { return nanoseconds; }
+  // The leading bit selects the power of two, the next kSubBucketBits bits
+  // the sub-bucket within it.
+  auto magnitude{static_cast<unsigned>(std::bit_width(nanoseconds)) -
+                 kSubBucketBits};
+  auto sub_bucket{(nanoseconds >> (magnitude - 1)) & (kSubBuckets - 1)};
+  return magnitude * kSubBuckets + sub_bucket;
+} // LatencyHistogram::bucketOf
+
+std::uint64_t LatencyHistogram::bucketTop(std::size_t bucket)
+{
+  if (bucket < kSubBuckets) { return bucket; }
+  std::size_t magnitude{bucket / kSubBuckets};
+  std::uint64_t sub_bucket{bucket % kSubBuckets};
+  std::uint64_t bottom{(kSubBuckets + sub_bucket) << (magnitude - 1)};
+  return bottom + ((std::uint64_t{1} << (magnitude - 1)) - 1);
+} // LatencyHistogram::bucketTop
+
+} // namespace pascha
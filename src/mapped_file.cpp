@@ -0,0 +1,148 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/mapped_file.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pascha
+{
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  HANDLE file{CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ |
+                                                        FILE_SHARE_WRITE,
+                          nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                          nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Unable to open " + path.string());
+  }
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("Unable to stat " + path.string());
+  }
+
+  // Windows refuses to map empty files, which are simply left unmapped.
+  if (size.QuadPart > 0) {
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping) {
+      m_data = static_cast<const std::byte*>(
+          MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!m_data) {
+      if (m_mapping) { CloseHandle(m_mapping); }
+      m_mapping = nullptr;
+      CloseHandle(file);
+      throw std::runtime_error("Unable to map " + path.string());
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+  }
+
+  CloseHandle(file);
+} // MappedFile::MappedFile
+
+void MappedFile::unmap()
+{
+  if (m_data) { UnmapViewOfFile(m_data); }
+  if (m_mapping) { CloseHandle(m_mapping); }
+  m_data = nullptr;
+  m_mapping = nullptr;
+  m_size = 0;
+} // MappedFile::unmap
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  int fd{::open(path.c_str(), O_RDONLY)};
+  if (fd < 0) { throw std::runtime_error("Unable to open " + path.string()); }
+
+  struct stat status
+  {};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Unable to stat " + path.string());
+  }
+
+  // mmap refuses zero length mappings, so empty files are left unmapped.
+  if (status.st_size > 0) {
+    void* data{::mmap(nullptr, static_cast<std::size_t>(status.st_size),
+                      PROT_READ, MAP_SHARED, fd, 0)};
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Unable to map " + path.string());
+    }
+    m_data = static_cast<const std::byte*>(data);
+    m_size = static_cast<std::size_t>(status.st_size);
+  }
+
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+} // MappedFile::MappedFile
+
+void MappedFile::unmap()
+{
+  if (m_data) { ::munmap(const_cast<std::byte*>(m_data), m_size); }
+  m_data = nullptr;
+  m_size = 0;
+} // MappedFile::unmap
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)}
+#ifdef _WIN32
+      ,
+      m_mapping{std::exchange(other.m_mapping, nullptr)}
+#endif
+{
+} // MappedFile::MappedFile
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other) {
+    unmap();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+  }
+  return *this;
+} // MappedFile::operator=
+
+MappedFile::~MappedFile() { unmap(); } // MappedFile::~MappedFile
+
+} // namespace pascha
@@ -0,0 +1,58 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/observer_list.h"
+
+#include <algorithm>
+
+namespace pascha
+{
+
+void ObserverList::add(IObserver& observer)
+{
+  std::lock_guard lock{m_write_mutex};
+  auto observers{std::make_shared<std::vector<IObserver*>>(*snapshot())};
+  observers->push_back(&observer);
+  publish(std::move(observers));
+} // ObserverList::add
+
+void ObserverList::remove(IObserver& observer)
+{
+  std::lock_guard lock{m_write_mutex};
+  Snapshot current{snapshot()};
+  if (std::find(current->begin(), current->end(), &observer) ==
+      current->end()) {
+    return;
+  }
+  auto observers{std::make_shared<std::vector<IObserver*>>(*current)};
+  std::erase(*observers, &observer);
+  publish(std::move(observers));
+} // ObserverList::remove
+
+void ObserverList::publish(Snapshot observers)
+{
+  // Swap under the lock, so that the old list is released outside it.
+  {
+    std::lock_guard lock{m_snapshot_mutex};
+    m_observers.swap(observers);
+  }
+} // ObserverList::publish
+
+} // namespace pascha
@@ -20,15 +20,14 @@
 
 #include "pascha/output_options.h"
 
+#include "pascha/computus.h"
+
 namespace pascha
 {
 
 Date ByzantineDate::calculate(Year year) const
 {
-  Date date{calculation_method().calculate(year)};
-  date.year += 5508;
-  if (date.month > 8) { ++date.year; }
-  return date;
+  return toByzantine(calculation_method().calculate(year));
 } // ByzantineDate::calculate
 
 } // namespace pascha
@@ -21,12 +21,89 @@
 #include "pascha/pascha_calculator_model.h"
 
 #include "pascha/calendar_conversion.h"
+#include "pascha/range_calculation.h"
 
-#include <ctime>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+using namespace pascha;
+using namespace std::literals; // for sv
+
+using Outcome = std::variant<Date, Weeks, Days, std::string>;
+using Counter = std::atomic<std::uint64_t>;
+
+const std::string kNoMethodMessage{"No calculation method set!"};
+const std::string kFailedMessage{"Calculation failed!"};
+
+Outcome calculateOutcome(const ICalculationMethod* method, Year year,
+                         Counter& calculations)
+{
+  if (!method) { return kNoMethodMessage; }
+  ++calculations;
+
+  try {
+    return method->calculate(year);
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return kFailedMessage;
+  }
+} // calculateOutcome
+
+Outcome daysUntilOutcome(const ICalculationMethod* method, Year year,
+                         const IClock& clock, Counter& calculations)
+{
+  if (!method) { return kNoMethodMessage; }
+  ++calculations;
+
+  try {
+    CalcInt dateJdn{gregorianToJdn(method->calculate(year))};
+    return Days{dateJdn - clock.todayJdn()};
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return kFailedMessage;
+  }
+} // daysUntilOutcome
+
+Outcome weeksBetweenOutcome(const ICalculationMethod* method1,
+                            const ICalculationMethod* method2, Year year,
+                            Counter& calculations)
+{
+  if (!method1 || !method2) { return kNoMethodMessage; }
+  calculations += 2;
+
+  try {
+    CalcInt date1Jdn{gregorianToJdn(method1->calculate(year))};
+    CalcInt date2Jdn{gregorianToJdn(method2->calculate(year))};
+
+    return Weeks{(date1Jdn - date2Jdn) / 7};
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return kFailedMessage;
+  }
+} // weeksBetweenOutcome
+
+} // anonymous namespace
 
 namespace pascha
 {
 
+PaschaCalculatorModel::PaschaCalculatorModel()
+    : PaschaCalculatorModel{std::make_shared<SystemClock>()}
+{
+} // PaschaCalculatorModel::PaschaCalculatorModel
+
+PaschaCalculatorModel::PaschaCalculatorModel(
+    std::shared_ptr<const IClock> clock)
+    : m_clock{std::move(clock)}
+{
+} // PaschaCalculatorModel::PaschaCalculatorModel
+
 void PaschaCalculatorModel::setCalculationMethod(
     std::unique_ptr<ICalculationMethod> calculation_method)
 {
@@ -35,96 +112,301 @@ void PaschaCalculatorModel::setCalculationMethod(
 
 void PaschaCalculatorModel::calculate(Year year) const
 {
-  using namespace std::literals; // for sv
+  notifyOutcome(
+      calculateOutcome(m_calculation_method.get(), year, m_calculations));
+} // PaschaCalculatorModel::calculate
 
+void PaschaCalculatorModel::calculateRange(Year first, Year last) const
+{
   if (!m_calculation_method) {
-    notify("No calculation method set!"sv);
+    notify(kNoMethodMessage);
     return;
   }
 
-  try {
-    Date date = m_calculation_method->calculate(year);
-    notify(date);
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
-  }
-} // PaschaCalculatorModel::calculate
+  RangeControl control{};
+  control.progress = [this](const Progress& progress) { notify(progress); };
+  forEachBatch(
+      *m_calculation_method, first, last, control,
+      [this](Batch& batch) { notify(std::span<const YearResult>{batch}); },
+      [this](std::string message) { notify(message); });
+} // PaschaCalculatorModel::calculateRange
 
 void PaschaCalculatorModel::daysUntil(Year year) const
 {
-  using namespace std::literals; // for sv
-
-  if (!m_calculation_method) {
-    notify("No calculation method set!"sv);
-    return;
-  }
-
-  try {
-    CalcInt dateJdn{gregorianToJdn(m_calculation_method->calculate(year))};
-
-    std::time_t t = std::time(0); // get time now
-    std::tm* now = std::localtime(&t);
-    Date nowDate{};
-    nowDate.year = now->tm_year + 1900;
-    nowDate.month = now->tm_mon + 1;
-    nowDate.day = now->tm_mday;
-    CalcInt nowJdn{gregorianToJdn(nowDate)};
-
-    notify(Days{dateJdn - nowJdn});
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
-  }
+  notifyOutcome(
+      daysUntilOutcome(m_calculation_method.get(), year, *m_clock,
+                       m_calculations));
 } // PaschaCalculatorModel::daysUntil
 
 void PaschaCalculatorModel::weeksBetween(
     Year year, std::unique_ptr<ICalculationMethod> method1,
     std::unique_ptr<ICalculationMethod> method2) const
 {
-  using namespace std::literals; // for sv
+  notifyOutcome(weeksBetweenOutcome(method1.get(), method2.get(), year,
+                                    m_calculations));
+} // PaschaCalculatorModel::weeksBetween
 
-  if (!method1 || !method2) {
-    notify("No calculation method set!"sv);
-    return;
-  }
+JobHandle PaschaCalculatorModel::calculateAsync(Year year,
+                                                Completion completion) const
+{
+  CancellationToken cancellation{};
+  return submit(
+      [this, method = m_calculation_method, year, cancellation,
+       completion = std::move(completion)] {
+        if (cancellation.cancelled()) {
+          if (completion) { dispatch(completion); }
+          return;
+        }
+        Outcome outcome{calculateOutcome(method.get(), year, m_calculations)};
+        dispatch([this, outcome = std::move(outcome), cancellation,
+                  completion] {
+          if (!cancellation.cancelled()) { notifyOutcome(outcome); }
+          if (completion) { completion(); }
+        });
+      },
+      cancellation);
+} // PaschaCalculatorModel::calculateAsync
 
-  try {
-    CalcInt date1Jdn{gregorianToJdn(method1->calculate(year))};
-    CalcInt date2Jdn{gregorianToJdn(method2->calculate(year))};
+JobHandle PaschaCalculatorModel::calculateRangeAsync(
+    Year first, Year last, Completion completion) const
+{
+  CancellationToken cancellation{};
+  return submit(
+      [this, method = m_calculation_method, first, last, cancellation,
+       completion = std::move(completion)] {
+        if (!method) {
+          dispatch([this] { notify(kNoMethodMessage); });
+        } else if (!cancellation.cancelled()) {
+          auto pending{std::make_shared<PendingRange>()};
+          RangeControl control{};
+          control.cancellation = &cancellation;
+          control.progress = [&](const Progress& progress) {
+            post(pending, cancellation,
+                 [&](PendingRange& range) { range.progress = progress; });
+          };
+          forEachBatch(
+              *method, first, last, control,
+              [&](Batch& batch) {
+                post(pending, cancellation, [&](PendingRange& range) {
+                  if (range.results.empty()) {
+                    range.results = std::move(batch);
+                  } else {
+                    range.results.insert(range.results.end(), batch.begin(),
+                                         batch.end());
+                  }
+                });
+              },
+              [&](std::string message) {
+                post(pending, cancellation, [&](PendingRange& range) {
+                  range.messages.push_back(std::move(message));
+                });
+              });
+        }
+        if (completion) { dispatch(completion); }
+      },
+      cancellation);
+} // PaschaCalculatorModel::calculateRangeAsync
 
-    notify(Weeks{(date1Jdn - date2Jdn) / 7});
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
-  }
-} // PaschaCalculatorModel::weeksBetween
+JobHandle PaschaCalculatorModel::daysUntilAsync(Year year,
+                                                Completion completion) const
+{
+  CancellationToken cancellation{};
+  return submit(
+      [this, method = m_calculation_method, year, cancellation,
+       completion = std::move(completion)] {
+        if (cancellation.cancelled()) {
+          if (completion) { dispatch(completion); }
+          return;
+        }
+        Outcome outcome{
+            daysUntilOutcome(method.get(), year, *m_clock, m_calculations)};
+        dispatch([this, outcome = std::move(outcome), cancellation,
+                  completion] {
+          if (!cancellation.cancelled()) { notifyOutcome(outcome); }
+          if (completion) { completion(); }
+        });
+      },
+      cancellation);
+} // PaschaCalculatorModel::daysUntilAsync
+
+JobHandle PaschaCalculatorModel::weeksBetweenAsync(
+    Year year, std::unique_ptr<ICalculationMethod> method1,
+    std::unique_ptr<ICalculationMethod> method2, Completion completion) const
+{
+  // std::function requires copyable jobs.
+  std::shared_ptr<ICalculationMethod> shared1{std::move(method1)};
+  std::shared_ptr<ICalculationMethod> shared2{std::move(method2)};
+  CancellationToken cancellation{};
+  return submit(
+      [this, shared1, shared2, year, cancellation,
+       completion = std::move(completion)] {
+        if (cancellation.cancelled()) {
+          if (completion) { dispatch(completion); }
+          return;
+        }
+        Outcome outcome{weeksBetweenOutcome(shared1.get(), shared2.get(), year,
+                                            m_calculations)};
+        dispatch([this, outcome = std::move(outcome), cancellation,
+                  completion] {
+          if (!cancellation.cancelled()) { notifyOutcome(outcome); }
+          if (completion) { completion(); }
+        });
+      },
+      cancellation);
+} // PaschaCalculatorModel::weeksBetweenAsync
+
+std::uint64_t PaschaCalculatorModel::calculationCount() const
+{
+  return m_calculations.load();
+} // PaschaCalculatorModel::calculationCount
+
+void PaschaCalculatorModel::setDispatcher(Dispatcher dispatcher)
+{
+  m_dispatcher = std::move(dispatcher);
+} // PaschaCalculatorModel::setDispatcher
 
 void PaschaCalculatorModel::addObserver(IObserver& observer)
 {
-  m_observers.push_back(&observer);
+  m_observers.add(observer);
 } // PaschaCalculatorModel::addObserver
 
 void PaschaCalculatorModel::removeObserver(IObserver& observer)
 {
-  std::erase(m_observers, &observer);
+  m_observers.remove(observer);
 } // PaschaCalculatorModel::removeObserver
 
 void PaschaCalculatorModel::notify(const Date& date) const
 {
-  for (IObserver* observer : m_observers) { observer->update(date); }
+  m_observers.forEach([&](IObserver& observer) { observer.update(date); });
 } // PaschaCalculatorModel::notify
 
 void PaschaCalculatorModel::notify(Weeks weeks) const
 {
-  for (IObserver* observer : m_observers) { observer->update(weeks); }
+  m_observers.forEach([&](IObserver& observer) { observer.update(weeks); });
 } // PaschaCalculatorModel::notify
 
 void PaschaCalculatorModel::notify(Days days) const
 {
-  for (IObserver* observer : m_observers) { observer->update(days); }
+  m_observers.forEach([&](IObserver& observer) { observer.update(days); });
 } // PaschaCalculatorModel::notify
 
 void PaschaCalculatorModel::notify(std::string_view message) const
 {
-  for (IObserver* observer : m_observers) { observer->update(message); }
+  m_observers.forEach([&](IObserver& observer) { observer.update(message); });
+} // PaschaCalculatorModel::notify
+
+void PaschaCalculatorModel::notify(std::span<const YearResult> results) const
+{
+  m_observers.forEach([&](IObserver& observer) { observer.update(results); });
+} // PaschaCalculatorModel::notify
+
+void PaschaCalculatorModel::notify(const Progress& progress) const
+{
+  m_observers.forEach([&](IObserver& observer) { observer.update(progress); });
 } // PaschaCalculatorModel::notify
 
+void PaschaCalculatorModel::notifyOutcome(const Outcome& outcome) const
+{
+  std::visit(
+      [this](const auto& result) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(result)>,
+                                     std::string>) {
+          notify(std::string_view{result});
+        } else {
+          notify(result);
+        }
+      },
+      outcome);
+} // PaschaCalculatorModel::notifyOutcome
+
+void PaschaCalculatorModel::forEachBatch(
+    const ICalculationMethod& method, Year first, Year last,
+    const RangeControl& control, const std::function<void(Batch&)>& on_batch,
+    const std::function<void(std::string)>& on_error) const
+{
+  if (last < first) {
+    on_error("Invalid year range");
+    return;
+  }
+
+  // The pool runs one range at a time.
+  std::lock_guard lock{m_pool_mutex};
+  if (!m_pool) { m_pool = std::make_unique<WorkStealingPool>(); }
+
+  Batch batch{};
+  batch.reserve(kNotifyBatchYears);
+  auto flush = [&on_batch, &batch] {
+    on_batch(batch);
+    batch.clear();
+    batch.reserve(kNotifyBatchYears);
+  };
+
+  try {
+    pascha::calculateRange(
+        method, first, last, *m_pool,
+        [&](Year window_first, std::span<const Date> dates) {
+          m_calculations += dates.size();
+          for (std::size_t i = 0; i < dates.size(); ++i) {
+            batch.push_back(
+                YearResult{window_first + static_cast<Year>(i), dates[i]});
+            if (batch.size() == kNotifyBatchYears) { flush(); }
+          }
+        },
+        control);
+    if (!batch.empty()) { flush(); }
+  } catch (const OperationCancelled&) {
+    // Whoever cancelled is no longer interested in the results.
+  } catch (const std::exception& e) {
+    on_error(e.what());
+  } catch (...) {
+    on_error(kFailedMessage);
+  }
+} // PaschaCalculatorModel::forEachBatch
+
+void PaschaCalculatorModel::post(
+    const std::shared_ptr<PendingRange>& pending,
+    const CancellationToken& cancellation,
+    const std::function<void(PendingRange&)>& add) const
+{
+  {
+    std::lock_guard lock{pending->mutex};
+    add(*pending);
+    if (std::exchange(pending->scheduled, true)) { return; }
+  }
+
+  dispatch([this, pending, cancellation] {
+    PendingRange range{};
+    {
+      std::lock_guard lock{pending->mutex};
+      range.results.swap(pending->results);
+      range.progress.swap(pending->progress);
+      range.messages.swap(pending->messages);
+      pending->scheduled = false;
+    }
+
+    if (cancellation.cancelled()) { return; }
+    if (!range.results.empty()) {
+      notify(std::span<const YearResult>{range.results});
+    }
+    if (range.progress) { notify(*range.progress); }
+    for (const auto& message : range.messages) { notify(message); }
+  });
+} // PaschaCalculatorModel::post
+
+JobHandle PaschaCalculatorModel::submit(std::function<void()> job,
+                                        CancellationToken cancellation) const
+{
+  if (!m_executor) { m_executor = std::make_unique<SerialExecutor>(); }
+  return m_executor->submit(std::move(job), std::move(cancellation));
+} // PaschaCalculatorModel::submit
+
+void PaschaCalculatorModel::dispatch(std::function<void()> function) const
+{
+  if (m_dispatcher) {
+    m_dispatcher(std::move(function));
+  } else {
+    function();
+  }
+} // PaschaCalculatorModel::dispatch
+
 } // namespace pascha
@@ -0,0 +1,114 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/paschalion_table.h"
+
+#include "pascha/method_factory.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace pascha
+{
+
+PaschalionTable::PaschalionTable(const std::vector<CalculationOptions>& columns,
+                                 Year first, Year last)
+    : m_first{first}
+{
+  if (last < first) { throw std::invalid_argument{"Invalid year range"}; }
+  // One less than the number of years, which wraps to zero for the whole
+  // range of Year.
+  const std::uint64_t last_row{static_cast<std::uint64_t>(last) -
+                               static_cast<std::uint64_t>(first)};
+  m_rows = std::min(last_row, kMaxRows - 1) + 1;
+  m_methods.reserve(columns.size());
+  for (const CalculationOptions& options : columns) {
+    m_methods.push_back(makeCalculationMethod(options));
+  }
+} // PaschalionTable::PaschalionTable
+
+std::optional<Date> PaschalionTable::date(std::uint64_t row,
+                                          std::size_t column) const
+{
+  if (row >= m_rows || column >= m_methods.size()) { return std::nullopt; }
+  const Block& rows{block(row / kBlockRows)};
+  return rows.dates[(row % kBlockRows) * m_methods.size() + column];
+} // PaschalionTable::date
+
+void PaschalionTable::prefetch(std::uint64_t first_row,
+                               std::uint64_t last_row) const
+{
+  if (m_rows == 0 || first_row > last_row) { return; }
+  last_row = std::min(last_row, m_rows - 1);
+  std::uint64_t first_block{first_row / kBlockRows};
+  // Look one block ahead, within what the cache can hold.
+  std::uint64_t last_block{std::min({last_row / kBlockRows + 1,
+                                     (m_rows - 1) / kBlockRows,
+                                     first_block + kCachedBlocks - 2})};
+  for (std::uint64_t index = first_block; index <= last_block; ++index) {
+    block(index);
+  }
+} // PaschalionTable::prefetch
+
+const PaschalionTable::Block& PaschalionTable::block(std::uint64_t index) const
+{
+  ++m_uses;
+  auto found{
+      std::find_if(m_blocks.begin(), m_blocks.end(),
+                   [index](const Block& b) { return b.index == index; })};
+  if (found != m_blocks.end()) {
+    found->last_used = m_uses;
+    return *found;
+  }
+
+  Block* target{nullptr};
+  if (m_blocks.size() < kCachedBlocks) {
+    target = &m_blocks.emplace_back();
+    target->dates.resize(kBlockRows * m_methods.size());
+  } else {
+    target = &*std::min_element(
+        m_blocks.begin(), m_blocks.end(), [](const Block& a, const Block& b) {
+          return a.last_used < b.last_used;
+        });
+  }
+  target->index = index;
+  target->last_used = m_uses;
+  fill(*target);
+  return *target;
+} // PaschalionTable::block
+
+void PaschalionTable::fill(Block& block) const
+{
+  std::uint64_t first_row{block.index * kBlockRows};
+  std::uint64_t rows{std::min(kBlockRows, m_rows - first_row)};
+  for (std::uint64_t row = 0; row < rows; ++row) {
+    Year year{this->year(first_row + row)};
+    for (std::size_t column = 0; column < m_methods.size(); ++column) {
+      auto& date{block.dates[row * m_methods.size() + column]};
+      try {
+        date = m_methods[column]->calculate(year);
+      } catch (const std::overflow_error&) {
+        date.reset();
+      }
+    }
+  }
+} // PaschalionTable::fill
+
+} // namespace pascha
@@ -0,0 +1,225 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/pipe_io.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+[[noreturn]] void throwSystemError(const char* what)
+{
+  throw std::runtime_error{std::string{what} + ": " + std::strerror(errno)};
+} // throwSystemError
+
+std::size_t pageSize()
+{
+#ifdef _WIN32
+  return 4096;
+#else
+  const long size{sysconf(_SC_PAGESIZE)};
+  return size > 0 ? static_cast<std::size_t>(size) : 4096;
+#endif
+} // pageSize
+
+#ifndef _WIN32
+// Wait until a non-blocking descriptor can be written to.
+void waitWritable(int fd)
+{
+  pollfd poll_fd{fd, POLLOUT, 0};
+  while (poll(&poll_fd, 1, -1) < 0) {
+    if (errno != EINTR) { throwSystemError("Failed to write the output"); }
+  }
+} // waitWritable
+#endif
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+std::size_t readSome(int fd, char* data, std::size_t size)
+{
+  for (;;) {
+#ifdef _WIN32
+    const int count{
+        _read(fd, data, static_cast<unsigned>(std::min<std::size_t>(
+                            size, std::size_t{1} << 30)))};
+#else
+    const ssize_t count{::read(fd, data, size)};
+#endif
+    if (count >= 0) { return static_cast<std::size_t>(count); }
+    if (errno != EINTR) { throwSystemError("Failed to read the input"); }
+  }
+} // readSome
+
+void PipeWriter::UnmapBuffer::operator()(char* data) const
+{
+#ifdef _WIN32
+  ::operator delete(data, std::align_val_t{pageSize()});
+#else
+  munmap(data, size);
+#endif
+} // PipeWriter::UnmapBuffer::operator()
+
+PipeWriter::PipeWriter(int fd, std::size_t buffer_bytes, bool allow_splice)
+    : m_fd{fd}
+{
+  const std::size_t page{pageSize()};
+  m_capacity = std::max<std::size_t>((buffer_bytes + page - 1) / page, 1) *
+               page;
+  auto allocate{[this] {
+#ifdef _WIN32
+    void* data{::operator new(m_capacity, std::align_val_t{pageSize()})};
+#else
+    void* data{mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (data == MAP_FAILED) { throw std::bad_alloc{}; }
+#endif
+    return Buffer{static_cast<char*>(data), UnmapBuffer{m_capacity}};
+  }};
+  m_copied = allocate();
+
+#ifdef __linux__
+  struct stat status{};
+  if (allow_splice && fstat(m_fd, &status) == 0 && S_ISFIFO(status.st_mode)) {
+    // A pipe holding a whole buffer takes it in one call. Growing it may be
+    // refused, which only means more calls.
+    fcntl(m_fd, F_SETPIPE_SZ, static_cast<int>(m_capacity));
+    for (Buffer& buffer : m_spliced) { buffer = allocate(); }
+    m_splicing = true;
+  }
+#else
+  static_cast<void>(allow_splice);
+#endif
+} // PipeWriter::PipeWriter
+
+PipeWriter::~PipeWriter() = default;
+
+char* PipeWriter::buffer()
+{
+  m_current = kSpliceBuffers;
+  if (m_splicing && consumed(m_next)) { m_current = m_next; }
+  return m_current == kSpliceBuffers ? m_copied.get()
+                                     : m_spliced[m_current].get();
+} // PipeWriter::buffer
+
+void PipeWriter::write(std::size_t size)
+{
+  if (m_current == kSpliceBuffers) {
+    copy(m_copied.get(), size);
+    return;
+  }
+  splice(m_spliced[m_current].get(), size);
+  m_in_pipe[m_current] = true;
+  m_written_after[m_current] = m_written;
+  m_next = (m_current + 1) % kSpliceBuffers;
+  m_current = kSpliceBuffers;
+} // PipeWriter::write
+
+bool PipeWriter::consumed(std::size_t index) const
+{
+  if (!m_in_pipe[index]) { return true; }
+#ifdef __linux__
+  // Unread bytes are the last ones written, unless another process is also
+  // writing, which only makes this more cautious.
+  int unread{};
+  if (ioctl(m_fd, FIONREAD, &unread) != 0 || unread < 0) { return false; }
+  return m_written - m_written_after[index] >=
+         static_cast<std::uint64_t>(unread);
+#else
+  return false;
+#endif
+} // PipeWriter::consumed
+
+void PipeWriter::splice(const char* data, std::size_t size)
+{
+#ifdef __linux__
+  while (size > 0) {
+    iovec pages{const_cast<char*>(data), size};
+    const ssize_t count{vmsplice(m_fd, &pages, 1, 0)};
+    if (count > 0) {
+      data += count;
+      size -= static_cast<std::size_t>(count);
+      m_written += static_cast<std::uint64_t>(count);
+    } else if (count < 0 && errno == EAGAIN) {
+      waitWritable(m_fd);
+    } else if (count < 0 && errno != EINTR) {
+      if (errno != EINVAL && errno != ENOSYS) {
+        throwSystemError("Failed to write the output");
+      }
+      // The pipe does not take spliced pages, so the rest is copied, as is
+      // everything after it. Pages already spliced are not reused.
+      m_splicing = false;
+      copy(data, size);
+      return;
+    }
+  }
+#else
+  copy(data, size);
+#endif
+} // PipeWriter::splice
+
+void PipeWriter::copy(const char* data, std::size_t size)
+{
+  while (size > 0) {
+#ifdef _WIN32
+    const int count{
+        _write(m_fd, data, static_cast<unsigned>(std::min<std::size_t>(
+                               size, std::size_t{1} << 30)))};
+#else
+    const ssize_t count{::write(m_fd, data, size)};
+#endif
+    if (count > 0) {
+      data += count;
+      size -= static_cast<std::size_t>(count);
+      m_written += static_cast<std::uint64_t>(count);
+      continue;
+    }
+#ifndef _WIN32
+    if (count < 0 && errno == EAGAIN) {
+      waitWritable(m_fd);
+      continue;
+    }
+#endif
+    if (count < 0 && errno == EINTR) { continue; }
+    throwSystemError("Failed to write the output");
+  }
+} // PipeWriter::copy
+
+} // namespace pascha
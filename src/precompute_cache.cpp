@@ -0,0 +1,162 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/precompute_cache.h"
+
+#include "pascha/method_factory.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+using namespace pascha;
+
+struct Variant
+{
+  OptionKey key;
+  std::shared_ptr<const ICalculationMethod> method;
+}; // struct Variant
+
+struct Entry
+{
+  OptionKey key;
+  Year year;
+  Date date;
+}; // struct Entry
+
+// Whether year + offset can be represented.
+bool canOffset(Year year, Year offset)
+{
+  return offset >= 0 ? year <= std::numeric_limits<Year>::max() - offset
+                     : year >= std::numeric_limits<Year>::min() - offset;
+} // canOffset
+
+// The distance between two years, which may not fit in a Year.
+std::uint64_t yearDistance(Year a, Year b)
+{
+  return a >= b ? static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)
+                : static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+} // yearDistance
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+std::optional<Date> PrecomputeCache::find(OptionKey key, Year year) const
+{
+  std::shared_lock lock{m_mutex};
+  auto dates{m_dates.find(key)};
+  if (dates == m_dates.end()) { return std::nullopt; }
+  auto date{dates->second.find(year)};
+  if (date == dates->second.end()) { return std::nullopt; }
+  return date->second;
+} // PrecomputeCache::find
+
+JobHandle PrecomputeCache::recentre(
+    const std::vector<CalculationOptions>& variants, Year centre)
+{
+  std::vector<OptionKey> keys{};
+  keys.reserve(variants.size());
+  for (const CalculationOptions& options : variants) {
+    keys.push_back(packOptions(options));
+  }
+
+  // Ignore small moves, so that scrubbing does not restart the speculation on
+  // every step.
+  if (keys == m_keys && m_job.valid() && !m_job.cancelled() &&
+      yearDistance(centre, m_centre) <=
+          static_cast<std::uint64_t>(m_radius / 4)) {
+    return m_job;
+  }
+  m_job.cancel();
+  m_keys = keys;
+  m_centre = centre;
+
+  std::vector<Variant> methods{};
+  methods.reserve(variants.size());
+  for (std::size_t i = 0; i < variants.size(); ++i) {
+    methods.push_back(
+        Variant{keys[i], std::shared_ptr<const ICalculationMethod>{
+                             makeCalculationMethod(variants[i])}});
+  }
+
+  CancellationToken cancellation{};
+  m_job = m_executor.submit(
+      [this, methods = std::move(methods), centre, cancellation] {
+        evict(centre);
+
+        std::vector<Entry> ring{};
+        for (Year distance = 0; distance <= m_radius; ++distance) {
+          if (cancellation.cancelled()) { return; }
+
+          ring.clear();
+          for (Year offset : {-distance, distance}) {
+            if (!canOffset(centre, offset)) { continue; }
+            for (const Variant& variant : methods) {
+              try {
+                ring.push_back(Entry{
+                    variant.key, centre + offset,
+                    variant.method->calculate(centre + offset)});
+              } catch (const std::overflow_error&) {
+                // Left for the caller to calculate, and report.
+              }
+            }
+            if (distance == 0) { break; }
+          }
+
+          std::unique_lock lock{m_mutex};
+          for (const Entry& entry : ring) {
+            m_dates[entry.key].insert_or_assign(entry.year, entry.date);
+          }
+        }
+      },
+      cancellation);
+  return m_job;
+} // PrecomputeCache::recentre
+
+std::size_t PrecomputeCache::size() const
+{
+  std::shared_lock lock{m_mutex};
+  std::size_t size{0};
+  for (const auto& [key, dates] : m_dates) { size += dates.size(); }
+  return size;
+} // PrecomputeCache::size
+
+void PrecomputeCache::evict(Year centre)
+{
+  // Keep the previous window while it overlaps the new one, to serve steps
+  // back the way the position came.
+  std::unique_lock lock{m_mutex};
+  for (auto& [key, dates] : m_dates) {
+    std::erase_if(dates, [this, centre](const auto& entry) {
+      return yearDistance(entry.first, centre) >
+             2 * static_cast<std::uint64_t>(m_radius);
+    });
+  }
+} // PrecomputeCache::evict
+
+} // namespace pascha
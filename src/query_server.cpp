@@ -0,0 +1,543 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/query_server.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace pascha;
+
+// Bytes of requests read from a connection at a time. A text query must fit
+// within it.
+constexpr std::size_t kQueryInputBytes{std::size_t{1} << 16};
+
+// How long the listener waits before accepting again when it is out of
+// descriptors and has none in reserve to refuse a connection with.
+constexpr std::chrono::milliseconds kOutOfDescriptorsDelay{10};
+
+// The binary batch header this version answers.
+constexpr std::array<char, kBatchHeaderSize> kBinaryHeader{
+    'P', 'A', 'S', 'C', 'H', 'B', 'A', 'T', 1, 0, 0, 0, 16, 0, 0, 0};
+static_assert(kBatchFormatVersion == 1 && kBatchRecordSize == 16);
+
+[[noreturn]] void fail(const std::string& problem)
+{
+  throw std::runtime_error{problem + ": " + std::strerror(errno)};
+} // fail
+
+// Whether a server is accepting connections on the socket at the address.
+bool listening(const sockaddr_un& address)
+{
+  const int probe{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (probe < 0) { return true; }
+  const bool refused{::connect(probe,
+                               reinterpret_cast<const sockaddr*>(&address),
+                               sizeof(address)) != 0 &&
+                     errno == ECONNREFUSED};
+  ::close(probe);
+  return !refused;
+} // listening
+
+bool isStatsRequest(std::string_view line)
+{
+  if (line.ends_with('\n')) { line.remove_suffix(1); }
+  if (line.ends_with('\r')) { line.remove_suffix(1); }
+  return line == "stats";
+} // isStatsRequest
+
+std::string nanoseconds(LatencyHistogram::Duration latency)
+{
+  return std::to_string(latency.count());
+} // nanoseconds
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+struct QueryServer::Connection
+{
+  enum class Mode
+  {
+    unknown,
+    text,
+    binary
+  }; // enum class Mode
+
+  enum class Received
+  {
+    some,
+    ended, // the client will send nothing more
+    failed
+  }; // enum class Received
+
+  explicit Connection(int socket) : fd{socket} {}
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+  ~Connection() { ::close(fd); }
+
+  int fd;
+  Mode mode{Mode::unknown};
+  // Requests not yet answered are input[begin, end).
+  std::vector<char> input{std::vector<char>(kQueryInputBytes)};
+  std::size_t begin{0};
+  std::size_t end{0};
+  // Results not yet sent are output[sent, size).
+  std::vector<char> output{};
+  std::size_t sent{0};
+  TextQueryParser parser{};
+  // No more requests will be read; the connection closes once the output has
+  // been sent.
+  bool finished{false};
+
+  bool sending() const { return !output.empty(); }
+
+  // Read what has arrived, up to a full input. Anything left is read once
+  // the connection is next armed, as it is still readable then.
+  Received receive()
+  {
+    // Keep the unanswered part, and read more after it.
+    std::memmove(input.data(), input.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    for (;;) {
+      const ssize_t count{
+          ::recv(fd, input.data() + end, input.size() - end, 0)};
+      if (count > 0) {
+        end += static_cast<std::size_t>(count);
+        return Received::some;
+      }
+      if (count == 0) { return Received::ended; }
+      if (errno == EINTR) { continue; }
+      return errno == EAGAIN || errno == EWOULDBLOCK ? Received::some
+                                                     : Received::failed;
+    }
+  }
+
+  // Send as much of the output as the socket takes. Returns false if the
+  // client has gone.
+  bool flush()
+  {
+    while (sent < output.size()) {
+      const ssize_t count{::send(fd, output.data() + sent,
+                                 output.size() - sent, MSG_NOSIGNAL)};
+      if (count >= 0) {
+        sent += static_cast<std::size_t>(count);
+        continue;
+      }
+      if (errno == EINTR) { continue; }
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    output.clear();
+    sent = 0;
+    return true;
+  }
+
+  void reply(std::string_view line)
+  {
+    output.insert(output.end(), line.begin(), line.end());
+    output.push_back('\n');
+  }
+}; // struct QueryServer::Connection
+
+struct QueryServer::Worker
+{
+  Worker(const QueryServerOptions& options, const QueryCache& cache)
+    : evaluator{options.date_format, options.date_separator, &cache}
+  {
+  }
+
+  BatchEvaluator evaluator;
+  BatchQueries queries{};
+}; // struct QueryServer::Worker
+
+QueryServer::QueryServer(QueryServerOptions options)
+    : m_options{std::move(options)},
+      m_cache{m_options.cache_first, m_options.cache_last}
+{
+  if (m_options.workers == 0) {
+    m_options.workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string path{m_options.socket_path.string()};
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error{"The socket path is empty or too long"};
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  try {
+    m_listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0);
+    if (m_listener < 0) { fail("Failed to create a socket"); }
+    auto bind{[&] {
+      return ::bind(m_listener, reinterpret_cast<const sockaddr*>(&address),
+                    sizeof(address)) == 0;
+    }};
+    if (!bind()) {
+      // Replace a socket left behind by a server which has gone.
+      struct stat status{};
+      if (errno != EADDRINUSE || ::lstat(path.c_str(), &status) != 0 ||
+          !S_ISSOCK(status.st_mode) || listening(address) ||
+          ::unlink(path.c_str()) != 0 || !bind()) {
+        fail("Failed to bind " + path);
+      }
+    }
+    m_bound = true;
+    if (::listen(m_listener, SOMAXCONN) != 0) { fail("Failed to listen"); }
+
+    m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll < 0) { fail("Failed to create an epoll instance"); }
+    m_wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wake < 0) { fail("Failed to create an eventfd"); }
+    m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    if (m_reserve < 0) { fail("Failed to open /dev/null"); }
+    // The wake-up is level-triggered, so that it reaches every worker.
+    epoll_event wake{};
+    wake.events = EPOLLIN;
+    wake.data.ptr = &m_wake;
+    epoll_event accepting{};
+    accepting.events = EPOLLIN | EPOLLONESHOT;
+    accepting.data.ptr = &m_listener;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &wake) != 0 ||
+        ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listener, &accepting) != 0) {
+      fail("Failed to watch the socket");
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+} // QueryServer::QueryServer
+
+QueryServer::~QueryServer()
+{
+  release();
+} // QueryServer::~QueryServer
+
+void QueryServer::release()
+{
+  m_connections.clear();
+  for (int fd : {m_listener, m_epoll, m_wake, m_reserve}) {
+    if (fd >= 0) { ::close(fd); }
+  }
+  m_listener = m_epoll = m_wake = m_reserve = -1;
+  if (m_bound) { ::unlink(m_options.socket_path.c_str()); }
+  m_bound = false;
+} // QueryServer::release
+
+void QueryServer::run()
+{
+  std::vector<std::thread> workers{};
+  for (std::size_t i = 0; i < m_options.workers; ++i) {
+    workers.emplace_back([this] {
+      try {
+        serve();
+      } catch (...) {
+        {
+          std::lock_guard lock{m_mutex};
+          if (!m_error) { m_error = std::current_exception(); }
+        }
+        stop();
+      }
+    });
+  }
+  for (std::thread& worker : workers) { worker.join(); }
+  if (m_error) { std::rethrow_exception(std::exchange(m_error, {})); }
+} // QueryServer::run
+
+void QueryServer::stop()
+{
+  const std::uint64_t one{1};
+  [[maybe_unused]] const ssize_t written{::write(m_wake, &one, sizeof(one))};
+} // QueryServer::stop
+
+std::string QueryServer::stats() const
+{
+  return "stats queries=" + std::to_string(m_latency.count()) +
+         " p50_ns=" + nanoseconds(m_latency.percentile(0.5)) +
+         " p99_ns=" + nanoseconds(m_latency.percentile(0.99)) +
+         " max_ns=" + nanoseconds(m_latency.max()) +
+         " mean_ns=" + nanoseconds(m_latency.mean());
+} // QueryServer::stats
+
+void QueryServer::serve()
+{
+  Worker worker{m_options, m_cache};
+  epoll_event event{};
+  for (;;) {
+    // One event at a time, so that a worker never sits on events another
+    // could be handling.
+    const int ready{::epoll_wait(m_epoll, &event, 1, -1)};
+    if (ready < 0) {
+      if (errno == EINTR) { continue; }
+      fail("Failed to wait for connections");
+    }
+    if (ready == 0) { continue; }
+    const auto woken{std::chrono::steady_clock::now()};
+    if (event.data.ptr == &m_wake) { return; }
+    if (event.data.ptr == &m_listener) {
+      accept();
+    } else {
+      handle(*static_cast<Connection*>(event.data.ptr), worker, woken);
+    }
+  }
+} // QueryServer::serve
+
+void QueryServer::accept()
+{
+  for (;;) {
+    const int fd{::accept4(m_listener, nullptr, nullptr,
+                           SOCK_NONBLOCK | SOCK_CLOEXEC)};
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) { continue; }
+      if (errno == EMFILE || errno == ENFILE) {
+        // Out of descriptors: free the reserve to accept the connection and
+        // close it at once. Left queued, it would wake the listener again
+        // straight away, and the workers would spin until one closes.
+        if (m_reserve < 0) {
+          m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        }
+        if (m_reserve < 0) {
+          // The reserve was lost to another descriptor, so the connection
+          // cannot be refused: wait for descriptors to be freed instead.
+          std::this_thread::sleep_for(kOutOfDescriptorsDelay);
+          break;
+        }
+        ::close(m_reserve);
+        const int refused{::accept4(m_listener, nullptr, nullptr,
+                                    SOCK_CLOEXEC)};
+        if (refused >= 0) { ::close(refused); }
+        m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (refused >= 0) { continue; }
+      }
+      // Nothing more to accept.
+      break;
+    }
+    auto added{std::make_unique<Connection>(fd)};
+    Connection& connection{*added};
+    {
+      std::lock_guard lock{m_mutex};
+      m_connections.emplace(&connection, std::move(added));
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = &connection;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+      close(connection);
+    }
+  }
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.ptr = &m_listener;
+  if (::epoll_ctl(m_epoll, EPOLL_CTL_MOD, m_listener, &event) != 0) {
+    fail("Failed to watch the socket");
+  }
+} // QueryServer::accept
+
+void QueryServer::handle(Connection& connection, Worker& worker,
+                         std::chrono::steady_clock::time_point woken)
+{
+  bool open{connection.flush()};
+  // Read no more while earlier results are still waiting to be sent.
+  if (open && !connection.sending() && !connection.finished) {
+    const Connection::Received received{connection.receive()};
+    open = received != Connection::Received::failed;
+    if (open) {
+      const bool ended{received == Connection::Received::ended};
+      const std::uint64_t answered{answer(connection, worker, ended)};
+      connection.finished = connection.finished || ended;
+      open = connection.flush();
+      if (answered > 0) {
+        m_latency.record(std::chrono::steady_clock::now() - woken, answered);
+      }
+    }
+  }
+
+  if (!open || (connection.finished && !connection.sending())) {
+    close(connection);
+  } else {
+    arm(connection, connection.sending());
+  }
+} // QueryServer::handle
+
+std::uint64_t QueryServer::answer(Connection& connection, Worker& worker,
+                                  bool at_end)
+{
+  using Mode = Connection::Mode;
+  if (connection.mode == Mode::unknown) {
+    const char* start{connection.input.data() + connection.begin};
+    const std::size_t size{connection.end - connection.begin};
+    if (std::memcmp(start, kBatchMagic.data(),
+                    std::min(size, kBatchMagic.size())) != 0) {
+      connection.mode = Mode::text;
+    } else if (size < kBatchHeaderSize) {
+      if (!at_end) { return 0; }
+      connection.mode = Mode::text;
+    } else if (std::memcmp(start, kBinaryHeader.data(), kBatchHeaderSize) !=
+               0) {
+      // A binary client this version cannot answer.
+      connection.finished = true;
+      connection.begin = connection.end;
+      return 0;
+    } else {
+      connection.mode = Mode::binary;
+      connection.begin += kBatchHeaderSize;
+    }
+  }
+  return connection.mode == Mode::binary
+             ? answerBinary(connection, worker, at_end)
+             : answerText(connection, worker, at_end);
+} // QueryServer::answer
+
+std::uint64_t QueryServer::answerText(Connection& connection, Worker& worker,
+                                      bool at_end)
+{
+  std::uint64_t answered{0};
+  // Queries are answered together, up to the next request answered
+  // otherwise.
+  auto answerQueries{[&] {
+    if (worker.queries.empty()) { return; }
+    std::vector<char>& output{connection.output};
+    const std::size_t size{output.size()};
+    output.resize(size +
+                  worker.queries.size() * worker.evaluator.maxResultSize());
+    const char* end{
+        worker.evaluator.write(worker.queries, output.data() + size)};
+    output.resize(static_cast<std::size_t>(end - output.data()));
+    answered += worker.queries.size();
+    worker.queries.clear();
+  }};
+
+  while (connection.begin < connection.end) {
+    const char* start{connection.input.data() + connection.begin};
+    const std::size_t size{connection.end - connection.begin};
+    const auto* newline{
+        static_cast<const char*>(std::memchr(start, '\n', size))};
+    if (!newline && !at_end) {
+      if (size == connection.input.size()) {
+        answerQueries();
+        connection.reply("error: Line " +
+                         std::to_string(connection.parser.lines() + 1) +
+                         " is too long");
+        connection.finished = true;
+        connection.begin = connection.end;
+      }
+      break;
+    }
+    const std::string_view line{
+        start, newline ? static_cast<std::size_t>(newline - start) + 1 : size};
+    connection.begin += line.size();
+
+    if (isStatsRequest(line)) {
+      answerQueries();
+      connection.parser.skipLine();
+      connection.reply(stats());
+      continue;
+    }
+    try {
+      connection.parser.parse(line, worker.queries, kBatchChunkQueries, true);
+    } catch (const std::runtime_error& error) {
+      answerQueries();
+      connection.reply(std::string{"error: "} + error.what());
+    }
+  }
+  answerQueries();
+  return answered;
+} // QueryServer::answerText
+
+std::uint64_t QueryServer::answerBinary(Connection& connection,
+                                        Worker& worker, bool at_end)
+{
+  std::uint64_t answered{0};
+  auto answerQueries{[&] {
+    std::vector<char>& output{connection.output};
+    const std::size_t size{output.size()};
+    output.resize(size + worker.queries.size() * kBatchResultSize);
+    worker.evaluator.writeResults(
+        worker.queries, reinterpret_cast<std::byte*>(output.data() + size));
+    answered += worker.queries.size();
+    worker.queries.clear();
+  }};
+
+  while (connection.end - connection.begin >= kBatchRecordSize) {
+    const std::size_t size{connection.end - connection.begin};
+    const std::span<const std::byte> records{
+        reinterpret_cast<const std::byte*>(connection.input.data() +
+                                           connection.begin),
+        size - size % kBatchRecordSize};
+    try {
+      connection.begin +=
+          parseBinaryQueries(records, worker.queries, kBatchChunkQueries);
+      answerQueries();
+    } catch (const std::runtime_error&) {
+      // Answer the records before the invalid one, then the invalid one.
+      connection.begin += worker.queries.size() * kBatchRecordSize;
+      answerQueries();
+      std::array<char, kBatchResultSize> invalid{};
+      invalid[10] = static_cast<char>(kBatchResultInvalid);
+      connection.output.insert(connection.output.end(), invalid.begin(),
+                               invalid.end());
+      connection.begin += kBatchRecordSize;
+    }
+  }
+  // A record cut short by the end of the requests has no answer.
+  if (at_end) { connection.begin = connection.end; }
+  return answered;
+} // QueryServer::answerBinary
+
+void QueryServer::arm(Connection& connection, bool writing)
+{
+  epoll_event event{};
+  event.events = (writing ? EPOLLOUT : EPOLLIN) | EPOLLONESHOT;
+  event.data.ptr = &connection;
+  if (::epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+    close(connection);
+  }
+} // QueryServer::arm
+
+void QueryServer::close(Connection& connection)
+{
+  // Closing the socket also takes it out of the epoll instance.
+  std::lock_guard lock{m_mutex};
+  m_connections.erase(&connection);
+} // QueryServer::close
+
+} // namespace pascha
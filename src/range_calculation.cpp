@@ -0,0 +1,135 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/range_calculation.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+
+// Chunks per worker held in memory at once while streaming. Enough to even
+// out chunks of different cost without holding the whole range.
+constexpr std::uint64_t kChunksPerWorker{8};
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+void calculateRange(const ICalculationMethod& method, Year first, Year last,
+                    WorkStealingPool& pool, const RangeConsumer& consumer,
+                    Year chunk_years)
+{
+  calculateRange(method, first, last, pool, consumer, RangeControl{},
+                 chunk_years);
+} // calculateRange
+
+void calculateRange(const ICalculationMethod& method, Year first, Year last,
+                    WorkStealingPool& pool, const RangeConsumer& consumer,
+                    const RangeControl& control, Year chunk_years)
+{
+  if (last < first) { throw std::invalid_argument("Invalid year range"); }
+  if (chunk_years < 1) { chunk_years = kDefaultChunkYears; }
+
+  // Work in unsigned offsets from first, so that ranges spanning most of the
+  // Year type cannot overflow. The last offset is last - first, as the count
+  // itself may not be representable.
+  const auto last_offset{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first)};
+  const auto chunk{static_cast<std::uint64_t>(chunk_years)};
+  const std::uint64_t window{chunk * kChunksPerWorker * pool.threadCount()};
+
+  const CancellationToken* cancellation{control.cancellation};
+  // The total is one more than the last offset, saturating for the whole
+  // range of Year.
+  constexpr auto kMaxOffset{std::numeric_limits<std::uint64_t>::max()};
+  ProgressReporter progress{last_offset + (last_offset < kMaxOffset ? 1 : 0),
+                            control.progress, control.progress_interval};
+
+  std::vector<Date> buffer{};
+  std::uint64_t offset{0};
+  while (true) {
+    const std::uint64_t count{std::min(window - 1, last_offset - offset) + 1};
+    const Year window_first{
+        static_cast<Year>(static_cast<std::uint64_t>(first) + offset)};
+    buffer.resize(count);
+
+    std::vector<WorkStealingPool::Task> tasks{};
+    for (std::uint64_t begin = 0; begin < count; begin += chunk) {
+      std::uint64_t end{std::min(begin + chunk, count)};
+      tasks.push_back([&method, &buffer, cancellation, window_first, begin,
+                       end] {
+        if (cancellation && cancellation->cancelled()) { return; }
+        for (std::uint64_t i = begin; i < end; ++i) {
+          buffer[i] = method.calculate(static_cast<Year>(
+              static_cast<std::uint64_t>(window_first) + i));
+        }
+      });
+    }
+    pool.run(std::move(tasks));
+
+    // Some chunks may have been skipped, so the window is incomplete.
+    if (cancellation && cancellation->cancelled()) {
+      throw OperationCancelled{};
+    }
+
+    consumer(window_first, buffer);
+    progress.advance(count);
+
+    if (last_offset - offset < window) { break; }
+    offset += window;
+  }
+  progress.finish();
+} // calculateRange
+
+std::vector<Date> calculateRange(const ICalculationMethod& method, Year first,
+                                 Year last, WorkStealingPool& pool,
+                                 Year chunk_years)
+{
+  std::vector<Date> dates{};
+  if (first <= last) {
+    dates.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(
+        static_cast<std::uint64_t>(last) - static_cast<std::uint64_t>(first),
+        dates.max_size() - 1)) + 1);
+  }
+  calculateRange(
+      method, first, last, pool,
+      [&dates](Year, std::span<const Date> window) {
+        dates.insert(dates.end(), window.begin(), window.end());
+      },
+      chunk_years);
+  return dates;
+} // calculateRange
+
+RangeResult calculateRange(const ICalculationMethod& method, Year first,
+                           Year last, const RangeOptions& options)
+{
+  WorkStealingPool pool{options.threads};
+  RangeResult result{};
+  result.dates = calculateRange(method, first, last, pool, options.chunk_years);
+  result.workers = pool.stats();
+  return result;
+} // calculateRange
+
+} // namespace pascha
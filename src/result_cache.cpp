@@ -0,0 +1,522 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/result_cache.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+using namespace pascha;
+
+constexpr std::array<char, 8> kFileMagic{'P', 'A', 'S', 'C', 'H', 'A', 'C', 0};
+constexpr std::uint32_t kBlockMagic{0x4b4c4250}; // "PBLK"
+constexpr std::uint32_t kByteOrderMark{0x01020304};
+
+struct FileHeader
+{
+  std::array<char, 8> magic;
+  std::uint32_t format_version;
+  std::uint32_t algorithm_version;
+  std::uint32_t byte_order;
+  std::uint32_t record_size;
+  std::uint64_t checksum; // of the fields above
+}; // struct FileHeader
+
+struct BlockHeader
+{
+  std::uint32_t magic;
+  OptionKey key;
+  std::int64_t first;
+  std::uint64_t count;
+  std::uint64_t checksum; // of the records which follow
+}; // struct BlockHeader
+
+// A cached date as laid out on disk. Unlike Date it has no padding, so the
+// checksum covers only defined bytes.
+struct Record
+{
+  std::int64_t year;
+  std::int16_t month;
+  std::int16_t day;
+  std::uint32_t reserved;
+}; // struct Record
+
+static_assert(sizeof(FileHeader) == 32);
+static_assert(sizeof(BlockHeader) == 32);
+static_assert(sizeof(Record) == 16);
+
+// 64-bit FNV-1a
+std::uint64_t checksum(const void* data, std::size_t size)
+{
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  std::uint64_t hash{0xcbf29ce484222325};
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+} // checksum
+
+FileHeader currentHeader()
+{
+  FileHeader header{kFileMagic, kCacheFormatVersion, kCacheAlgorithmVersion,
+                    kByteOrderMark, sizeof(Record), 0};
+  header.checksum = checksum(&header, offsetof(FileHeader, checksum));
+  return header;
+} // currentHeader
+
+// The cache file, open and held under an advisory lock for as long as this
+// lives: shared to read it, exclusive to modify it. Every process using the
+// cache takes the lock, so one never truncates or rewrites the file while
+// another is reading or appending to it.
+class LockedFile
+{
+ public:
+  // Opens the file, creating it if exclusive. Throws std::runtime_error if
+  // it cannot be opened or locked.
+  LockedFile(const std::filesystem::path& path, bool exclusive);
+  LockedFile(const LockedFile&) = delete;
+  LockedFile& operator=(const LockedFile&) = delete;
+  // Releases the lock.
+  ~LockedFile();
+
+  std::uint64_t size() const;
+  // Read size bytes at offset, returning false if there are not that many.
+  bool read(std::uint64_t offset, void* data, std::size_t size) const;
+  void write(std::uint64_t offset, const void* data, std::size_t size);
+  void truncate(std::uint64_t size);
+  // Replace the file with one holding only the given header, e.g. when it
+  // was written by another version. Readers of the old file keep it, so
+  // nothing is truncated underneath their mappings.
+  void replace(const FileHeader& header);
+
+ private:
+  std::filesystem::path m_path;
+#ifdef _WIN32
+  HANDLE m_file{INVALID_HANDLE_VALUE};
+#else
+  int m_fd{-1};
+#endif
+
+  [[noreturn]] void fail(const char* what) const;
+}; // class LockedFile
+
+void LockedFile::fail(const char* what) const
+{
+  throw std::runtime_error(std::string{"Unable to "} + what + " cache " +
+                           m_path.string());
+} // LockedFile::fail
+
+#ifdef _WIN32
+
+// Lock a byte far past any data, as Windows locks are mandatory for the bytes
+// they cover and would otherwise block reads through other handles.
+OVERLAPPED lockRange()
+{
+  OVERLAPPED range{};
+  range.Offset = 0xffffffff;
+  range.OffsetHigh = 0x7fffffff;
+  return range;
+} // lockRange
+
+OVERLAPPED at(std::uint64_t offset)
+{
+  OVERLAPPED position{};
+  position.Offset = static_cast<DWORD>(offset);
+  position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+  return position;
+} // at
+
+LockedFile::LockedFile(const std::filesystem::path& path, bool exclusive)
+    : m_path{path}
+{
+  m_file = CreateFileW(path.c_str(),
+                       GENERIC_READ | (exclusive ? GENERIC_WRITE : 0),
+                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                       nullptr, exclusive ? OPEN_ALWAYS : OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) { fail("open"); }
+  OVERLAPPED range{lockRange()};
+  if (!LockFileEx(m_file, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0,
+                  &range)) {
+    CloseHandle(m_file);
+    fail("lock");
+  }
+} // LockedFile::LockedFile
+
+LockedFile::~LockedFile()
+{
+  OVERLAPPED range{lockRange()};
+  UnlockFileEx(m_file, 0, 1, 0, &range);
+  CloseHandle(m_file);
+} // LockedFile::~LockedFile
+
+std::uint64_t LockedFile::size() const
+{
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(m_file, &size)) { fail("stat"); }
+  return static_cast<std::uint64_t>(size.QuadPart);
+} // LockedFile::size
+
+bool LockedFile::read(std::uint64_t offset, void* data,
+                      std::size_t size) const
+{
+  auto* bytes{static_cast<char*>(data)};
+  while (size > 0) {
+    OVERLAPPED position{at(offset)};
+    DWORD count{0};
+    if (!ReadFile(m_file, bytes, static_cast<DWORD>(size), &count,
+                  &position) ||
+        count == 0) {
+      return false;
+    }
+    bytes += count;
+    offset += count;
+    size -= count;
+  }
+  return true;
+} // LockedFile::read
+
+void LockedFile::write(std::uint64_t offset, const void* data,
+                       std::size_t size)
+{
+  const auto* bytes{static_cast<const char*>(data)};
+  while (size > 0) {
+    OVERLAPPED position{at(offset)};
+    DWORD count{0};
+    if (!WriteFile(m_file, bytes, static_cast<DWORD>(size), &count,
+                   &position)) {
+      fail("write");
+    }
+    bytes += count;
+    offset += count;
+    size -= count;
+  }
+} // LockedFile::write
+
+void LockedFile::truncate(std::uint64_t size)
+{
+  LARGE_INTEGER end{};
+  end.QuadPart = static_cast<LONGLONG>(size);
+  if (!SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) ||
+      !SetEndOfFile(m_file)) {
+    fail("resize");
+  }
+} // LockedFile::truncate
+
+void LockedFile::replace(const FileHeader& header)
+{
+  // Windows will not truncate a file while it is mapped, so nobody can be
+  // reading past the new end.
+  truncate(0);
+  write(0, &header, sizeof(header));
+} // LockedFile::replace
+
+#else
+
+LockedFile::LockedFile(const std::filesystem::path& path, bool exclusive)
+    : m_path{path}
+{
+  for (;;) {
+    m_fd = ::open(path.c_str(),
+                  (exclusive ? O_RDWR | O_CREAT : O_RDONLY) | O_CLOEXEC, 0644);
+    if (m_fd < 0) { fail("open"); }
+    int result{0};
+    do {
+      result = ::flock(m_fd, exclusive ? LOCK_EX : LOCK_SH);
+    } while (result != 0 && errno == EINTR);
+    if (result != 0) {
+      ::close(m_fd);
+      fail("lock");
+    }
+
+    // Another process may have replaced the file while this one waited for
+    // the lock, in which case lock the new file instead.
+    struct stat held{};
+    struct stat current{};
+    if (::fstat(m_fd, &held) == 0 && ::stat(path.c_str(), &current) == 0 &&
+        held.st_dev == current.st_dev && held.st_ino == current.st_ino) {
+      return;
+    }
+    ::close(m_fd);
+  }
+} // LockedFile::LockedFile
+
+LockedFile::~LockedFile()
+{
+  // Closing the descriptor releases the lock.
+  ::close(m_fd);
+} // LockedFile::~LockedFile
+
+std::uint64_t LockedFile::size() const
+{
+  struct stat status{};
+  if (::fstat(m_fd, &status) != 0) { fail("stat"); }
+  return static_cast<std::uint64_t>(status.st_size);
+} // LockedFile::size
+
+bool LockedFile::read(std::uint64_t offset, void* data,
+                      std::size_t size) const
+{
+  auto* bytes{static_cast<char*>(data)};
+  while (size > 0) {
+    ssize_t count{::pread(m_fd, bytes, size, static_cast<off_t>(offset))};
+    if (count < 0 && errno == EINTR) { continue; }
+    if (count <= 0) { return false; }
+    bytes += count;
+    offset += static_cast<std::uint64_t>(count);
+    size -= static_cast<std::size_t>(count);
+  }
+  return true;
+} // LockedFile::read
+
+void LockedFile::write(std::uint64_t offset, const void* data,
+                       std::size_t size)
+{
+  const auto* bytes{static_cast<const char*>(data)};
+  while (size > 0) {
+    ssize_t count{::pwrite(m_fd, bytes, size, static_cast<off_t>(offset))};
+    if (count < 0 && errno == EINTR) { continue; }
+    if (count < 0) { fail("write"); }
+    bytes += count;
+    offset += static_cast<std::uint64_t>(count);
+    size -= static_cast<std::size_t>(count);
+  }
+} // LockedFile::write
+
+void LockedFile::truncate(std::uint64_t size)
+{
+  if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0) { fail("resize"); }
+} // LockedFile::truncate
+
+void LockedFile::replace(const FileHeader& header)
+{
+  // Write the new file beside the old one and rename it into place, holding
+  // the lock on both until the swap is done. Processes waiting on the old
+  // file's lock notice it was replaced and move on to the new one.
+  std::filesystem::path next{m_path};
+  next += ".new";
+  int fd{::open(next.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+  if (fd < 0) { fail("replace"); }
+  std::swap(fd, m_fd);
+  if (::flock(m_fd, LOCK_EX) != 0) {
+    std::swap(fd, m_fd);
+    ::close(fd);
+    fail("lock");
+  }
+  try {
+    write(0, &header, sizeof(header));
+  } catch (...) {
+    std::swap(fd, m_fd);
+    ::close(fd);
+    throw;
+  }
+  if (::rename(next.c_str(), m_path.c_str()) != 0) {
+    std::swap(fd, m_fd);
+    ::close(fd);
+    fail("replace");
+  }
+  ::close(fd);
+} // LockedFile::replace
+
+#endif
+
+// Whether the block at offset, of which the header has been read, is complete
+// and matches its checksum.
+bool validBlock(const LockedFile& file, std::uint64_t size,
+                std::uint64_t offset, const BlockHeader& block)
+{
+  if (block.magic != kBlockMagic ||
+      block.count > (size - offset - sizeof(block)) / sizeof(Record)) {
+    return false;
+  }
+  std::vector<Record> records(block.count);
+  return file.read(offset + sizeof(block), records.data(),
+                   records.size() * sizeof(Record)) &&
+         checksum(records.data(), records.size() * sizeof(Record)) ==
+             block.checksum;
+} // validBlock
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+ResultCache::ResultCache(std::filesystem::path path) : m_path{std::move(path)}
+{
+  load(0);
+} // ResultCache::ResultCache
+
+std::optional<Date> ResultCache::find(OptionKey key, Year year) const
+{
+  std::shared_lock lock{m_mutex};
+  // The block of these options starting latest at or before the year
+  auto it{m_blocks.upper_bound({key, year})};
+  if (it == m_blocks.begin()) { return std::nullopt; }
+  --it;
+  const auto& [start, block] = *it;
+  if (start.first != key) { return std::nullopt; }
+
+  // Subtract unsigned: the span between two years may not fit in a Year.
+  auto index{static_cast<std::uint64_t>(year) -
+             static_cast<std::uint64_t>(start.second)};
+  if (index >= block.count) { return std::nullopt; }
+
+  Record record{};
+  std::memcpy(&record, block.records + index * sizeof(Record), sizeof(Record));
+  return Date{record.year, record.month, record.day};
+} // ResultCache::find
+
+std::size_t ResultCache::blockCount() const
+{
+  std::shared_lock lock{m_mutex};
+  return m_block_count;
+} // ResultCache::blockCount
+
+void ResultCache::store(OptionKey key, Year first, std::span<const Date> dates)
+{
+  if (dates.empty()) { return; }
+  std::unique_lock lock{m_mutex};
+
+  std::vector<Record> records(dates.size());
+  for (std::size_t i = 0; i < dates.size(); ++i) {
+    records[i] = Record{dates[i].year, dates[i].month, dates[i].day, 0};
+  }
+  std::size_t records_size{records.size() * sizeof(Record)};
+  BlockHeader block{kBlockMagic, key, first, records.size(),
+                    checksum(records.data(), records_size)};
+
+  // Release the mapping before modifying the file underneath it.
+  std::size_t known_end{m_valid_end};
+  m_file = MappedFile{};
+  m_blocks.clear();
+  m_block_count = 0;
+  m_valid_end = 0;
+
+  std::size_t block_offset{0};
+  {
+    LockedFile file{m_path, true};
+    std::uint64_t size{file.size()};
+
+    // Other processes may have appended to, or replaced, the file since it
+    // was loaded, so find its valid end again under the lock. Blocks up to
+    // what was loaded were validated then and are never removed; only those
+    // appended since need checking.
+    FileHeader header{};
+    FileHeader expected{currentHeader()};
+    std::uint64_t offset{sizeof(header)};
+    if (size < sizeof(header) || !file.read(0, &header, sizeof(header)) ||
+        std::memcmp(&header, &expected, sizeof(header)) != 0) {
+      // Missing or invalid (e.g. outdated) cache: start over.
+      file.replace(expected);
+      size = sizeof(header);
+    } else {
+      if (known_end > offset && known_end <= size) { offset = known_end; }
+      while (size - offset >= sizeof(BlockHeader)) {
+        BlockHeader existing{};
+        if (!file.read(offset, &existing, sizeof(existing)) ||
+            !validBlock(file, size, offset, existing)) {
+          break;
+        }
+        offset += sizeof(existing) + existing.count * sizeof(Record);
+      }
+      // Drop any torn block left at the end by an interrupted store.
+      if (offset != size) { file.truncate(offset); }
+    }
+
+    block_offset = static_cast<std::size_t>(offset);
+    file.write(offset, &block, sizeof(block));
+    file.write(offset + sizeof(block), records.data(), records_size);
+  }
+
+  // Everything before the new block was validated above.
+  load(block_offset);
+} // ResultCache::store
+
+void ResultCache::load(std::size_t verified_end)
+{
+  m_file = MappedFile{};
+  m_blocks.clear();
+  m_block_count = 0;
+  m_valid_end = 0;
+
+  // Hold the shared lock while reading, so no torn block being checked is
+  // truncated underneath the mapping.
+  std::optional<LockedFile> lock{};
+  try {
+    lock.emplace(m_path, false);
+    m_file = MappedFile{m_path};
+  } catch (const std::runtime_error&) {
+    return;
+  }
+
+  const std::byte* data{m_file.data()};
+  std::size_t size{m_file.size()};
+
+  FileHeader header{};
+  if (size < sizeof(header)) { return; }
+  std::memcpy(&header, data, sizeof(header));
+  FileHeader expected{currentHeader()};
+  if (std::memcmp(&header, &expected, sizeof(header)) != 0) { return; }
+
+  std::size_t offset{sizeof(header)};
+  while (size - offset >= sizeof(BlockHeader)) {
+    BlockHeader block{};
+    std::memcpy(&block, data + offset, sizeof(block));
+    if (block.magic != kBlockMagic ||
+        block.count > (size - offset - sizeof(block)) / sizeof(Record)) {
+      break;
+    }
+
+    const std::byte* records{data + offset + sizeof(block)};
+    std::size_t records_size{block.count * sizeof(Record)};
+    if (offset >= verified_end &&
+        checksum(records, records_size) != block.checksum) {
+      break;
+    }
+
+    // Later blocks take precedence over earlier ones.
+    m_blocks.insert_or_assign({block.key, block.first},
+                              Block{block.count, records});
+    ++m_block_count;
+    offset += sizeof(block) + records_size;
+  }
+  m_valid_end = offset;
+} // ResultCache::load
+
+} // namespace pascha
@@ -0,0 +1,213 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/statistics.h"
+
+#include "pascha/divergence.h"
+#include "pascha/method_factory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+// Chunks per worker queued at once. Enough to even out chunks of different
+// cost without building a task for every chunk of a wide range up front.
+constexpr std::uint64_t kChunksPerWorker{8};
+
+// The options for the distribution, which must calculate a date.
+CalculationOptions distributionOptions(CalculationOptions options)
+{
+  if (options.target_outputs.empty() ||
+      options.target_outputs.front() == e_target_output::daysUntil ||
+      options.target_outputs.front() == e_target_output::weeksBetween) {
+    options.target_outputs = {e_target_output::pascha};
+  }
+  return options;
+} // distributionOptions
+
+void accumulate(const ICalculationMethod& method, Year first, Year last,
+                PaschaStatistics& statistics)
+{
+  for (Year year = first;; ++year) {
+    try {
+      Date date{method.calculate(year)};
+      if (date.month >= 1 && date.month <= 12 && date.day >= 1 &&
+          date.day <= 31) {
+        ++statistics.by_day[date.month - 1][date.day - 1];
+        ++statistics.by_month[date.month - 1];
+      }
+      ++statistics.years;
+    } catch (const std::overflow_error&) {
+      ++statistics.skipped;
+    }
+    if (year == last) { break; }
+  }
+
+  try {
+    DivergenceSummary divergence{analyseDivergence(first, last)};
+    statistics.compared += divergence.years;
+    statistics.coincident += divergence.coincident;
+    statistics.total_weeks_between += divergence.total_weeks;
+    return;
+  } catch (const std::overflow_error&) {
+    // Compare the years which can be, one at a time.
+  }
+
+  for (Year year = first;; ++year) {
+    try {
+      DivergenceSummary divergence{analyseDivergence(year, year)};
+      statistics.coincident += divergence.coincident;
+      statistics.total_weeks_between += divergence.total_weeks;
+      ++statistics.compared;
+    } catch (const std::overflow_error&) {
+      // Not compared.
+    }
+    if (year == last) { break; }
+  }
+} // accumulate
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+void PaschaStatistics::merge(const PaschaStatistics& other)
+{
+  years += other.years;
+  skipped += other.skipped;
+  for (std::size_t month = 0; month < by_day.size(); ++month) {
+    for (std::size_t day = 0; day < by_day[month].size(); ++day) {
+      by_day[month][day] += other.by_day[month][day];
+    }
+    by_month[month] += other.by_month[month];
+  }
+  compared += other.compared;
+  coincident += other.coincident;
+  total_weeks_between += other.total_weeks_between;
+} // PaschaStatistics::merge
+
+PaschaStatistics calculateStatistics(const CalculationOptions& options,
+                                     Year first, Year last,
+                                     WorkStealingPool& pool,
+                                     const RangeControl& control)
+{
+  if (last < first) { throw std::invalid_argument{"Invalid year range"}; }
+
+  std::unique_ptr<ICalculationMethod> method{
+      makeCalculationMethod(distributionOptions(options))};
+
+  PaschaStatistics total{};
+  std::mutex total_mutex{};
+
+  // Work in unsigned offsets from first, as in calculateRange, so that ranges
+  // spanning most of the Year type cannot overflow.
+  const auto last_offset{static_cast<std::uint64_t>(last) -
+                         static_cast<std::uint64_t>(first)};
+  const auto chunk{static_cast<std::uint64_t>(kStatisticsChunkYears)};
+  const std::uint64_t wave{chunk * kChunksPerWorker * pool.threadCount()};
+
+  const CancellationToken* cancellation{control.cancellation};
+  constexpr auto kMaxOffset{std::numeric_limits<std::uint64_t>::max()};
+  ProgressReporter progress{last_offset + (last_offset < kMaxOffset ? 1 : 0),
+                            control.progress, control.progress_interval};
+
+  std::uint64_t offset{0};
+  while (true) {
+    const std::uint64_t count{std::min(wave - 1, last_offset - offset) + 1};
+    const auto wave_first{static_cast<std::uint64_t>(first) + offset};
+
+    std::vector<WorkStealingPool::Task> tasks{};
+    for (std::uint64_t begin = 0; begin < count; begin += chunk) {
+      const std::uint64_t end{std::min(begin + chunk, count)};
+      const auto chunk_first{static_cast<Year>(wave_first + begin)};
+      const auto chunk_last{static_cast<Year>(wave_first + end - 1)};
+      tasks.push_back([&, chunk_first, chunk_last] {
+        if (cancellation && cancellation->cancelled()) { return; }
+        PaschaStatistics partial{};
+        accumulate(*method, chunk_first, chunk_last, partial);
+        std::lock_guard lock{total_mutex};
+        total.merge(partial);
+      });
+    }
+    pool.run(std::move(tasks));
+
+    // Some chunks may have been skipped, so the counts are incomplete.
+    if (cancellation && cancellation->cancelled()) {
+      throw OperationCancelled{};
+    }
+    progress.advance(count);
+
+    if (last_offset - offset < wave) { break; }
+    offset += wave;
+  }
+  progress.finish();
+
+  total.first = first;
+  total.last = last;
+  return total;
+} // calculateStatistics
+
+std::shared_ptr<const PaschaStatistics>
+    StatisticsCalculator::calculate(const CalculationOptions& options,
+                                    Year first, Year last,
+                                    const RangeControl& control)
+{
+  Key key{packOptions(distributionOptions(options)), first, last};
+  if (auto cached = find(key)) { return cached; }
+
+  // The pool runs one range at a time. Whoever ran before may have
+  // calculated the same statistics.
+  std::lock_guard run_lock{m_run_mutex};
+  if (auto cached = find(key)) { return cached; }
+
+  auto statistics{std::make_shared<const PaschaStatistics>(
+      calculateStatistics(options, first, last, m_pool, control))};
+  std::lock_guard lock{m_mutex};
+  if (m_order.size() == kCachedResults) {
+    m_results.erase(m_order.front());
+    m_order.pop_front();
+  }
+  m_results.emplace(key, statistics);
+  m_order.push_back(key);
+  return statistics;
+} // StatisticsCalculator::calculate
+
+std::shared_ptr<const PaschaStatistics>
+    StatisticsCalculator::find(const Key& key) const
+{
+  std::lock_guard lock{m_mutex};
+  auto found{m_results.find(key)};
+  return found != m_results.end() ? found->second : nullptr;
+} // StatisticsCalculator::find
+
+std::size_t StatisticsCalculator::cachedCount() const
+{
+  std::lock_guard lock{m_mutex};
+  return m_results.size();
+} // StatisticsCalculator::cachedCount
+
+} // namespace pascha
@@ -0,0 +1,177 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/thread_pool.h"
+
+namespace pascha
+{
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+  if (threads == 0) { threads = std::thread::hardware_concurrency(); }
+  if (threads == 0) { threads = 1; }
+
+  for (std::size_t i = 0; i < threads; ++i) {
+    m_workers.push_back(std::make_unique<Worker>());
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+  }
+} // WorkStealingPool::WorkStealingPool
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto& thread : m_threads) { thread.join(); }
+} // WorkStealingPool::~WorkStealingPool
+
+void WorkStealingPool::run(std::vector<Task> tasks)
+{
+  auto start{std::chrono::steady_clock::now()};
+
+  // A worker still finishing the previous run may pick up tasks as soon as
+  // they are queued, so they must already be counted.
+  {
+    std::lock_guard lock{m_mutex};
+    m_pending = tasks.size();
+    m_error = nullptr;
+  }
+
+  // Deal the tasks out round-robin, before any worker is woken.
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    Worker& worker{*m_workers[i % m_workers.size()]};
+    std::lock_guard lock{worker.mutex};
+    worker.tasks.push_back(std::move(tasks[i]));
+  }
+
+  std::exception_ptr error{};
+  {
+    std::unique_lock lock{m_mutex};
+    ++m_generation;
+    m_wake.notify_all();
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    error = std::exchange(m_error, nullptr);
+  }
+
+  auto wall{std::chrono::steady_clock::now() - start};
+  for (auto& worker : m_workers) {
+    std::lock_guard lock{worker->mutex};
+    worker->stats.wall +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall);
+  }
+
+  if (error) { std::rethrow_exception(error); }
+} // WorkStealingPool::run
+
+std::vector<WorkerStats> WorkStealingPool::stats() const
+{
+  std::vector<WorkerStats> stats{};
+  for (const auto& worker : m_workers) {
+    std::lock_guard lock{worker->mutex};
+    stats.push_back(worker->stats);
+  }
+  return stats;
+} // WorkStealingPool::stats
+
+void WorkStealingPool::resetStats()
+{
+  for (auto& worker : m_workers) {
+    std::lock_guard lock{worker->mutex};
+    worker->stats = WorkerStats{};
+  }
+} // WorkStealingPool::resetStats
+
+void WorkStealingPool::workerLoop(std::size_t index)
+{
+  std::uint64_t seen_generation{0};
+  Worker& self{*m_workers[index]};
+
+  while (true) {
+    {
+      std::unique_lock lock{m_mutex};
+      m_wake.wait(lock, [&] {
+        return m_stop || m_generation != seen_generation;
+      });
+      if (m_stop) { return; }
+      seen_generation = m_generation;
+    }
+
+    // All tasks of a run are queued before the workers are woken, so once
+    // every queue is empty this worker is done with the run.
+    Task task{};
+    bool stolen{false};
+    while (takeTask(index, task, stolen)) {
+      auto start{std::chrono::steady_clock::now()};
+      std::exception_ptr error{};
+      try {
+        task();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      auto busy{std::chrono::steady_clock::now() - start};
+      task = nullptr;
+
+      {
+        std::lock_guard lock{self.mutex};
+        ++self.stats.tasks;
+        if (stolen) { ++self.stats.stolen; }
+        self.stats.busy +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(busy);
+      }
+
+      std::lock_guard lock{m_mutex};
+      if (error && !m_error) { m_error = error; }
+      if (--m_pending == 0) { m_done.notify_all(); }
+    }
+  }
+} // WorkStealingPool::workerLoop
+
+bool WorkStealingPool::takeTask(std::size_t index, Task& task, bool& stolen)
+{
+  {
+    Worker& self{*m_workers[index]};
+    std::lock_guard lock{self.mutex};
+    if (!self.tasks.empty()) {
+      task = std::move(self.tasks.back());
+      self.tasks.pop_back();
+      stolen = false;
+      return true;
+    }
+  }
+
+  for (std::size_t i = 1; i < m_workers.size(); ++i) {
+    Worker& victim{*m_workers[(index + i) % m_workers.size()]};
+    std::lock_guard lock{victim.mutex};
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      stolen = true;
+      return true;
+    }
+  }
+
+  return false;
+} // WorkStealingPool::takeTask
+
+} // namespace pascha
@@ -0,0 +1,271 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/batch.h"
+#include "pascha/feasts.h"
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Append a binary record, as described in batch.h.
+void appendRecord(std::string& file, Year year, int method,
+                  int target, int calendar, int byzantine)
+{
+  auto bits{static_cast<std::uint64_t>(year)};
+  for (int i = 0; i < 8; ++i) {
+    file += static_cast<char>(bits & 0xff);
+    bits >>= 8;
+  }
+  file += static_cast<char>(method);
+  file += static_cast<char>(target);
+  file += static_cast<char>(calendar);
+  file += static_cast<char>(byzantine);
+  file.append(4, '\0');
+} // appendRecord
+
+std::string binaryHeader()
+{
+  std::string header{pascha::kBatchMagic.data(), pascha::kBatchMagic.size()};
+  header += std::string{"\x01\0\0\0\x10\0\0\0", 8};
+  return header;
+} // binaryHeader
+
+void writeFile(const std::filesystem::path& path, const std::string& text)
+{
+  std::ofstream file{path, std::ios::binary};
+  file << text;
+} // writeFile
+
+} // anonymous namespace
+
+TEST_CASE("Batch")
+{
+  using namespace pascha;
+
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "pascha_batch_test.txt"};
+
+  SECTION("Text queries are parsed a line at a time")
+  {
+    TextQueryParser parser{};
+    BatchQueries queries{};
+    const std::string_view text{"# year,method,target,calendar,byzantine\n"
+                                "2024,julian,pascha,gregorian,0\r\n"
+                                "\n"
+                                "-5,gregorian,ash-wednesday,revised-julian,1\n"
+                                "2025,julian,pentecost,julian,0"};
+    REQUIRE(parser.parse(text, queries, 10, false) == text.rfind('\n') + 1);
+    REQUIRE(queries.size() == 2);
+    REQUIRE(queries.years[1] == -5);
+    REQUIRE(queries.keys[1] ==
+            packOptions({e_calculation_method::gregorian,
+                         {e_target_output::ashWednesday},
+                         e_output_calendar::rev_julian,
+                         {e_output_option::byzantine},
+                         0}));
+
+    queries.clear();
+    TextQueryParser limited{};
+    REQUIRE(limited.parse(text, queries, 1, true) == text.find("\r\n") + 2);
+    REQUIRE(queries.size() == 1);
+    REQUIRE(parser.parse(text.substr(text.rfind('\n') + 1), queries, 10,
+                         true) == text.size() - text.rfind('\n') - 1);
+    REQUIRE(queries.size() == 2);
+    REQUIRE(parser.lines() == 5);
+  } // Text queries are parsed a line at a time
+
+  SECTION("Invalid text queries are rejected")
+  {
+    for (std::string_view text :
+         {"2024,julian,pascha,gregorian\n",
+          "2024,julian,pascha,gregorian,0,1\n", "x,julian,pascha,gregorian,0\n",
+          "2024,julian,easter,gregorian,0\n",
+          "2024,julian,days-until,gregorian,0\n",
+          "2024, julian,pascha,gregorian,0\n"}) {
+      TextQueryParser parser{};
+      BatchQueries queries{};
+      REQUIRE_THROWS_AS(parser.parse(text, queries, 10, true),
+                        std::runtime_error);
+    }
+  } // Invalid text queries are rejected
+
+  SECTION("Binary queries are parsed a record at a time")
+  {
+    std::string records{};
+    appendRecord(records, 2024, e_calculation_method::julian,
+                 e_target_output::pentecost, e_output_calendar::julian, 0);
+    appendRecord(records, std::numeric_limits<Year>::min(),
+                 e_calculation_method::gregorian, e_target_output::pascha,
+                 e_output_calendar::gregorian, 1);
+    const std::span<const std::byte> bytes{
+        reinterpret_cast<const std::byte*>(records.data()), records.size()};
+    BatchQueries queries{};
+    REQUIRE(parseBinaryQueries(bytes, queries, 10) == records.size());
+    REQUIRE(queries.years[0] == 2024);
+    REQUIRE(queries.years[1] == std::numeric_limits<Year>::min());
+    REQUIRE(queries.keys[1] == packOptions({e_calculation_method::gregorian,
+                                            {e_target_output::pascha},
+                                            e_output_calendar::gregorian,
+                                            {e_output_option::byzantine},
+                                            0}));
+
+    queries.clear();
+    REQUIRE_THROWS_AS(parseBinaryQueries(bytes.first(20), queries, 10),
+                      std::runtime_error);
+    std::string bad{};
+    appendRecord(bad, 2024, e_calculation_method::julian,
+                 e_target_output::weeksBetween, e_output_calendar::julian, 0);
+    REQUIRE_THROWS_AS(
+        parseBinaryQueries({reinterpret_cast<const std::byte*>(bad.data()),
+                            bad.size()},
+                           queries, 10),
+        std::runtime_error);
+  } // Binary queries are parsed a record at a time
+
+  SECTION("Results are written in the order of the queries")
+  {
+    BatchQueries queries{};
+    const OptionKey pascha{packOptions({e_calculation_method::julian,
+                                        {e_target_output::pascha},
+                                        e_output_calendar::gregorian,
+                                        {},
+                                        0})};
+    const OptionKey pentecost{packOptions({e_calculation_method::julian,
+                                           {e_target_output::pentecost},
+                                           e_output_calendar::gregorian,
+                                           {},
+                                           0})};
+    for (auto [year, key] : {std::pair{2024, pascha}, {2024, pentecost},
+                             {2025, pascha}, {2025, pentecost}}) {
+      queries.years.push_back(year);
+      queries.keys.push_back(key);
+    }
+    queries.years.push_back(std::numeric_limits<Year>::max());
+    queries.keys.push_back(pentecost);
+
+    BatchEvaluator evaluator{};
+    std::string text(queries.size() * evaluator.maxResultSize(), '\0');
+    text.resize(evaluator.write(queries, text.data()) - text.data());
+    REQUIRE(text == "2024-5-5\n2024-6-23\n2025-4-20\n2025-6-8\nerror\n");
+
+    // Years in the cache's window are looked up, the rest calculated.
+    const QueryCache cache{2025, 2030};
+    BatchEvaluator cached{DateFormat::YMD, "-", &cache};
+    std::string cached_text(text.size(), '\0');
+    cached_text.resize(cached.write(queries, cached_text.data()) -
+                       cached_text.data());
+    REQUIRE(cached_text == text);
+    REQUIRE(cache.dates(pascha)[0].day == 20);
+    REQUIRE(cache.dates(packOptions({e_calculation_method::julian,
+                                     {e_target_output::daysUntil},
+                                     e_output_calendar::gregorian,
+                                     {},
+                                     0})) == nullptr);
+    REQUIRE_THROWS_AS((QueryCache{2030, 2025}), std::invalid_argument);
+  } // Results are written in the order of the queries
+
+  SECTION("Results can be written as binary records")
+  {
+    BatchQueries queries{};
+    queries.years = {2024, std::numeric_limits<Year>::max()};
+    queries.keys.assign(2, packOptions({e_calculation_method::julian,
+                                        {e_target_output::pentecost},
+                                        e_output_calendar::gregorian,
+                                        {},
+                                        0}));
+    BatchEvaluator evaluator{};
+    std::vector<std::byte> results(queries.size() * kBatchResultSize);
+    REQUIRE(evaluator.writeResults(queries, results.data()) ==
+            results.data() + results.size());
+    // Results are laid out as records are, with the status for the method.
+    std::string expected{};
+    appendRecord(expected, 2024, 6, 23, kBatchResultDate, 0);
+    appendRecord(expected, 0, 0, 0, kBatchResultOverflow, 0);
+    const bool same{std::memcmp(results.data(), expected.data(),
+                                expected.size()) == 0};
+    REQUIRE(same);
+  } // Results can be written as binary records
+
+  SECTION("Files are evaluated across chunks in either format")
+  {
+    std::string text{};
+    std::string binary{binaryHeader()};
+    std::string expected{};
+    const Year count{static_cast<Year>(kBatchChunkQueries) * 2 + 100};
+    std::vector<std::unique_ptr<ICalculationMethod>> methods{};
+    for (const Feast& feast : kFeasts) {
+      methods.push_back(makeCalculationMethod({e_calculation_method::julian,
+                                               {feast.target},
+                                               e_output_calendar::julian,
+                                               {},
+                                               0}));
+    }
+    BulkDateFormatter formatter{DateFormat::DMY, "."};
+    for (Year i = 0; i < count; ++i) {
+      const std::size_t feast{static_cast<std::size_t>(i) % kFeasts.size()};
+      const Year year{i % 5000};
+      text += std::to_string(year) + ",julian," +
+              feastSlug(kFeasts[feast]) + ",julian,0\n";
+      appendRecord(binary, year, e_calculation_method::julian,
+                   kFeasts[feast].target, e_output_calendar::julian, 0);
+      expected += formatter.format(methods[feast]->calculate(year)) + '\n';
+    }
+
+    BatchOptions options{DateFormat::DMY, "."};
+    for (const std::string& input : {text, binary}) {
+      writeFile(path, input);
+      std::ostringstream out{};
+      evaluateBatchFile(path, out, options);
+      REQUIRE(out.str() == expected);
+    }
+
+    writeFile(path, "");
+    std::ostringstream out{};
+    evaluateBatchFile(path, out);
+    REQUIRE(out.str().empty());
+  } // Files are evaluated across chunks in either format
+
+  SECTION("Invalid files are rejected")
+  {
+    std::ostringstream out{};
+    writeFile(path, "2024,julian,pascha,gregorian,0\n2024,julian\n");
+    REQUIRE_THROWS_AS(evaluateBatchFile(path, out), std::runtime_error);
+
+    std::string binary{binaryHeader()};
+    binary[8] = '\x02';
+    writeFile(path, binary);
+    REQUIRE_THROWS_AS(evaluateBatchFile(path, out), std::runtime_error);
+  } // Invalid files are rejected
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/bulk_date_formatter.h"
+#include "pascha/calculation_methods.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST_CASE("Bulk date formatter")
+{
+  using namespace pascha;
+
+  SECTION("Field orders and separators")
+  {
+    Date date{2024, 5, 5};
+    REQUIRE(BulkDateFormatter(DateFormat::YMD, "-").format(date) ==
+            "2024-5-5");
+    REQUIRE(BulkDateFormatter(DateFormat::MDY, "/").format(date) ==
+            "5/5/2024");
+    REQUIRE(BulkDateFormatter(DateFormat::DMY, ". ").format(date) ==
+            "5. 5. 2024");
+    REQUIRE(BulkDateFormatter(DateFormat::YMD, "").format(Date{2024, 12, 31}) ==
+            "20241231");
+  } // Field orders and separators
+
+  SECTION("Years of any size")
+  {
+    BulkDateFormatter formatter{DateFormat::YMD, "-"};
+    REQUIRE(formatter.format(Date{0, 1, 1}) == "0-1-1");
+    REQUIRE(formatter.format(Date{7, 4, 10}) == "7-4-10");
+    REQUIRE(formatter.format(Date{999, 4, 10}) == "999-4-10");
+    REQUIRE(formatter.format(Date{1000, 4, 10}) == "1000-4-10");
+    REQUIRE(formatter.format(Date{9999, 4, 10}) == "9999-4-10");
+    REQUIRE(formatter.format(Date{10000, 4, 10}) == "10000-4-10");
+    REQUIRE(formatter.format(Date{-5508, 3, 25}) == "-5508-3-25");
+    REQUIRE(formatter.format(Date{-1, 3, 25}) == "-1-3-25");
+
+    const Year largest{std::numeric_limits<Year>::max()};
+    const Year smallest{std::numeric_limits<Year>::min()};
+    REQUIRE(formatter.format(Date{largest, 1, 1}) ==
+            std::to_string(largest) + "-1-1");
+    REQUIRE(formatter.format(Date{smallest, 1, 1}) ==
+            std::to_string(smallest) + "-1-1");
+    std::string widest{BulkDateFormatter{DateFormat::DMY, "--"}.format(
+        Date{smallest, -32768, -32768})};
+    REQUIRE(widest == "-32768---32768--" + std::to_string(smallest));
+  } // Years of any size
+
+  SECTION("Batches match formatting one at a time")
+  {
+    GregorianCalculationMethod method{};
+    std::vector<Date> dates{};
+    for (Year year = -2000; year <= 12000; ++year) {
+      dates.push_back(method.calculate(year));
+    }
+
+    BulkDateFormatter formatter{DateFormat::DMY, "/"};
+    std::string text{"header\n"};
+    formatter.append(dates, text);
+
+    std::string expected{"header\n"};
+    for (const Date& date : dates) {
+      expected += std::to_string(date.day) + "/" + std::to_string(date.month) +
+                  "/" + std::to_string(date.year) + "\n";
+    }
+    REQUIRE(text == expected);
+  } // Batches match formatting one at a time
+}
@@ -0,0 +1,152 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/clock.h"
+#include "pascha/countdown.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <ctime>
+#include <ranges>
+
+TEST_CASE("Clocks")
+{
+  using namespace pascha;
+
+  SECTION("The system clock gives today's date")
+  {
+    SystemClock clock{};
+    std::time_t time{std::time(nullptr)};
+    std::tm local{*std::localtime(&time)};
+    Date today{clock.today()};
+    // Allow for the test running over midnight.
+    if (today.day == local.tm_mday) {
+      REQUIRE(today.year == local.tm_year + 1900);
+      REQUIRE(today.month == local.tm_mon + 1);
+    }
+    REQUIRE(clock.todayJdn() == gregorianToJdn(clock.today()));
+    Today snapshot{clock.snapshot()};
+    REQUIRE(snapshot.jdn == gregorianToJdn(snapshot.date));
+  } // The system clock gives today's date
+
+  SECTION("A fixed clock pins the date")
+  {
+    FixedClock clock{Date{2024, 5, 5}};
+    REQUIRE(clock.today().year == 2024);
+    REQUIRE(clock.todayJdn() == 2460436);
+    REQUIRE(clock.snapshot().date.day == 5);
+    REQUIRE(clock.snapshot().jdn == 2460436);
+  } // A fixed clock pins the date
+}
+
+TEST_CASE("Days until the next dates")
+{
+  using namespace pascha;
+
+  JulianCalculationMethod method{};
+
+  SECTION("This year's date is counted until it has passed")
+  {
+    // Pascha was on 2024-05-05 and is on 2025-04-20.
+    auto countdowns{daysUntilNext(method, 3, FixedClock{Date{2024, 5, 4}})};
+    REQUIRE(countdowns.size() == 3);
+    REQUIRE(countdowns[0].year == 2024);
+    REQUIRE(countdowns[0].days.value == 1);
+    REQUIRE(countdowns[1].year == 2025);
+    REQUIRE(countdowns[1].days.value == 351);
+    REQUIRE(countdowns[2].year == 2026);
+
+    auto on_the_day{daysUntilNext(method, 1, FixedClock{Date{2024, 5, 5}})};
+    REQUIRE(on_the_day.front().days.value == 0);
+
+    auto after{daysUntilNext(method, 1, FixedClock{Date{2024, 5, 6}})};
+    REQUIRE(after.front().year == 2025);
+    REQUIRE(after.front().days.value == 349);
+  } // This year's date is counted until it has passed
+}
+
+TEST_CASE("Upcoming feasts")
+{
+  using namespace pascha;
+
+  JulianCalculationMethod method{};
+
+  SECTION("Feasts are merged in date order")
+  {
+    // Pascha was on 2024-05-05 and is on 2025-04-20.
+    const std::array<Feast, 3> feasts{kFeasts[0], kFeasts[6], kFeasts[7]};
+    FixedClock clock{Date{2024, 5, 4}};
+    std::vector<FeastCountdown> upcoming{};
+    for (const auto& next :
+         upcomingFeasts(method, clock, feasts) | std::views::take(6)) {
+      upcoming.push_back(next);
+    }
+    REQUIRE(upcoming.size() == 6);
+    REQUIRE(upcoming[0].feast->name == "Pascha");
+    REQUIRE(upcoming[0].days.value == 1);
+    REQUIRE(upcoming[1].feast->name == "Ascension");
+    REQUIRE(upcoming[1].date.month == 6);
+    REQUIRE(upcoming[1].date.day == 13);
+    REQUIRE(upcoming[1].days.value == 40);
+    REQUIRE(upcoming[2].feast->name == "Pentecost");
+    REQUIRE(upcoming[2].days.value == 50);
+    REQUIRE(upcoming[3].feast->name == "Pascha");
+    REQUIRE(upcoming[3].year == 2025);
+    REQUIRE(upcoming[3].days.value == 351);
+    REQUIRE(upcoming[5].feast->name == "Pentecost");
+    REQUIRE(upcoming[5].date.month == 6);
+    REQUIRE(upcoming[5].date.day == 8);
+  } // Feasts are merged in date order
+
+  SECTION("Passed feasts are skipped")
+  {
+    FixedClock clock{Date{2024, 6, 13}};
+    auto upcoming{upcomingFeasts(method, clock)};
+    auto next{upcoming.begin()};
+    REQUIRE(next->feast->target == e_target_output::ascension);
+    REQUIRE(next->days.value == 0);
+    ++next;
+    REQUIRE(next->feast->target == e_target_output::pentecost);
+    ++next;
+    REQUIRE(next->feast->target == e_target_output::meatfare);
+    REQUIRE(next->year == 2025);
+  } // Passed feasts are skipped
+
+  SECTION("Every feast keeps its own yearly order")
+  {
+    FixedClock clock{Date{2024, 1, 1}};
+    std::array<Year, kFeasts.size()> last_years{};
+    CalcInt last_days{0};
+    for (const auto& next : upcomingFeasts(method, clock) |
+                                std::views::take(kFeasts.size() * 100)) {
+      REQUIRE(next.days.value >= last_days);
+      last_days = next.days.value;
+      auto feast{static_cast<std::size_t>(next.feast - kFeasts.data())};
+      if (last_years[feast] != 0) {
+        REQUIRE(next.year == last_years[feast] + 1);
+      }
+      last_years[feast] = next.year;
+    }
+    for (Year year : last_years) { REQUIRE(year == 2123); }
+  } // Every feast keeps its own yearly order
+}
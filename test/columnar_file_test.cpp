@@ -0,0 +1,206 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/columnar_file.h"
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// 64-bit FNV-1a, continuing from the given hash, as the file's checksum.
+std::uint64_t checksum(const char* data, std::size_t size,
+                       std::uint64_t hash = 0xcbf29ce484222325)
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+} // checksum
+
+} // anonymous namespace
+
+TEST_CASE("Columnar file")
+{
+  using namespace pascha;
+
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "pascha_columnar_test.bin"};
+
+  SECTION("Dates are packed relative to their year")
+  {
+    for (Date date : {Date{2024, 5, 5}, Date{7532, 4, 22}, Date{2023, 12, 31},
+                      Date{-5508, 1, 1}}) {
+      Date unpacked{unpackDate(2024, packDate(2024, date))};
+      REQUIRE(unpacked.year == date.year);
+      REQUIRE(unpacked.month == date.month);
+      REQUIRE(unpacked.day == date.day);
+    }
+    REQUIRE_THROWS_AS(packDate(0, Date{10'000'000, 1, 1}),
+                      std::overflow_error);
+  } // Dates are packed relative to their year
+
+  SECTION("Exported ranges can be read back by year")
+  {
+    std::vector<CalculationOptions> columns{
+        {e_calculation_method::julian,
+         {e_target_output::pascha},
+         e_output_calendar::gregorian,
+         {},
+         0},
+        {e_calculation_method::gregorian,
+         {e_target_output::pentecost},
+         e_output_calendar::julian,
+         {e_output_option::byzantine},
+         0},
+    };
+    constexpr Year first{-1000};
+    constexpr Year last{kColumnarBlockRows * 2 + 100};
+    exportColumnar(path, columns, first, last);
+
+    ColumnarReader reader{path};
+    REQUIRE(reader.columns().size() == 2);
+    REQUIRE(reader.columns()[1] == packOptions(columns[1]));
+    REQUIRE(reader.blockCount() == 3);
+    REQUIRE(reader.rowCount() == static_cast<std::uint64_t>(last - first + 1));
+    REQUIRE(reader.firstYear() == first);
+    REQUIRE(reader.lastYear() == last);
+
+    auto julian{makeCalculationMethod(columns[0])};
+    auto gregorian{makeCalculationMethod(columns[1])};
+    for (Year year : {first, Year{0}, Year{2024}, Year{kColumnarBlockRows},
+                      last}) {
+      Date expected{gregorian->calculate(year)};
+      std::optional<Date> found{reader.find(year, 1)};
+      REQUIRE(found);
+      REQUIRE(found->year == expected.year);
+      REQUIRE(found->month == expected.month);
+      REQUIRE(found->day == expected.day);
+    }
+    REQUIRE_FALSE(reader.find(first - 1, 0));
+    REQUIRE_FALSE(reader.find(last + 1, 0));
+    REQUIRE_THROWS_AS(reader.find(2024, 2), std::out_of_range);
+
+    // A full scan of one block.
+    ColumnarBlock block{reader.block(1)};
+    REQUIRE(block.rows() == kColumnarBlockRows);
+    for (std::size_t row = 0; row < block.rows(); ++row) {
+      Date expected{julian->calculate(block.year(row))};
+      Date date{block.date(row, 0)};
+      REQUIRE(date.year == expected.year);
+      REQUIRE(date.month == expected.month);
+      REQUIRE(date.day == expected.day);
+    }
+  } // Exported ranges can be read back by year
+
+  SECTION("Years need not be consecutive")
+  {
+    {
+      ColumnarWriter writer{path, {OptionKey{0}}, 4};
+      for (Year year : {Year{-300}, Year{-299}, Year{5}, Year{1000000},
+                        Year{1000001}, Year{2000000000000}}) {
+        writer.append(year, std::vector<Date>{Date{year, 4, 1}});
+      }
+      REQUIRE_THROWS_AS(writer.append(5, std::vector<Date>{Date{5, 4, 1}}),
+                        std::invalid_argument);
+      writer.finish();
+    }
+
+    ColumnarReader reader{path};
+    REQUIRE(reader.blockCount() == 2);
+    REQUIRE(reader.find(1000000, 0)->year == 1000000);
+    REQUIRE(reader.find(2000000000000, 0)->day == 1);
+    REQUIRE_FALSE(reader.find(6, 0));
+    ColumnarBlock block{reader.block(0)};
+    REQUIRE(block.year(2) == 5);
+    REQUIRE(block.findRow(-299) == 1);
+    REQUIRE_FALSE(block.findRow(-298));
+  } // Years need not be consecutive
+
+  SECTION("Unfinished and damaged files are rejected")
+  {
+    {
+      ColumnarWriter writer{path, {OptionKey{0}}};
+      writer.append(1, std::vector<Date>{Date{1, 4, 1}});
+    }
+    REQUIRE_THROWS_AS(ColumnarReader{path}, std::runtime_error);
+
+    {
+      ColumnarWriter writer{path, {OptionKey{0}}};
+      writer.append(1, std::vector<Date>{Date{1, 4, 1}});
+      writer.finish();
+    }
+    {
+      std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(16);
+      file.put('\x7f');
+    }
+    REQUIRE_THROWS_AS(ColumnarReader{path}, std::runtime_error);
+  } // Unfinished and damaged files are rejected
+
+  SECTION("Blocks out of file order are rejected")
+  {
+    {
+      ColumnarWriter writer{path, {OptionKey{0}}, 1};
+      writer.append(1, std::vector<Date>{Date{1, 4, 1}});
+      writer.append(2, std::vector<Date>{Date{2, 4, 1}});
+      writer.finish();
+    }
+    REQUIRE(ColumnarReader{path}.blockCount() == 2);
+
+    std::string file{};
+    {
+      std::ifstream in{path, std::ios::binary};
+      file.assign(std::istreambuf_iterator<char>{in}, {});
+    }
+    // Point the second block at the first, with a valid checksum. The index
+    // offset is at byte 40 of the header, followed by the checksum, and the
+    // columns follow the 56-byte header.
+    std::uint64_t index_offset{};
+    std::memcpy(&index_offset, file.data() + 40, sizeof(index_offset));
+    const std::size_t entry_size{sizeof(ColumnarIndexEntry)};
+    const std::size_t offset_field{offsetof(ColumnarIndexEntry, offset)};
+    std::memcpy(file.data() + index_offset + entry_size + offset_field,
+                file.data() + index_offset + offset_field,
+                sizeof(std::uint64_t));
+    std::uint64_t hash{checksum(file.data(), 48)};
+    hash = checksum(file.data() + 56, sizeof(OptionKey), hash);
+    hash = checksum(file.data() + index_offset, 2 * entry_size, hash);
+    std::memcpy(file.data() + 48, &hash, sizeof(hash));
+    {
+      std::ofstream out{path, std::ios::binary | std::ios::trunc};
+      out.write(file.data(), static_cast<std::streamsize>(file.size()));
+    }
+    REQUIRE_THROWS_AS(ColumnarReader{path}, std::runtime_error);
+  } // Blocks out of file order are rejected
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/date_pipeline.h"
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+template <typename Calculate>
+std::optional<pascha::Date> dateOrOverflow(const Calculate& calculate,
+                                           Year year)
+{
+  try {
+    return calculate(year);
+  } catch (const std::overflow_error&) {
+    return std::nullopt;
+  }
+} // dateOrOverflow
+
+} // anonymous namespace
+
+TEST_CASE("Date pipeline")
+{
+  using namespace pascha;
+
+  SECTION("Dates match the method built for the same options")
+  {
+    std::vector<Year> years{std::numeric_limits<Year>::min(),
+                            std::numeric_limits<Year>::max()};
+    for (Year year = -1000; year <= 4000; year += 7) { years.push_back(year); }
+
+    for (ECalculationMethod method = 0; method < e_calculation_method::last;
+         ++method) {
+      for (ETargetOutput target = 0; target < e_target_output::last;
+           ++target) {
+        if (target == e_target_output::weeksBetween) { continue; }
+        for (EOutputCalendar calendar = 0;
+             calendar < e_output_calendar::last; ++calendar) {
+          for (bool byzantine : {false, true}) {
+            CalculationOptions options{method, {target}, calendar, {}, 0};
+            if (byzantine) { options.options = {e_output_option::byzantine}; }
+            const DatePipeline pipeline{packOptions(options)};
+            const auto decorated{makeCalculationMethod(options)};
+            for (Year year : years) {
+              auto expected{dateOrOverflow(
+                  [&](Year y) { return decorated->calculate(y); }, year)};
+              auto actual{dateOrOverflow(pipeline, year)};
+              REQUIRE(actual.has_value() == expected.has_value());
+              if (!expected) { continue; }
+              REQUIRE(actual->year == expected->year);
+              REQUIRE(actual->month == expected->month);
+              REQUIRE(actual->day == expected->day);
+            }
+          }
+        }
+      }
+    }
+  } // Dates match the method built for the same options
+
+  SECTION("Weeks between is not a date")
+  {
+    CalculationOptions options{e_calculation_method::julian,
+                               {e_target_output::weeksBetween},
+                               e_output_calendar::gregorian,
+                               {},
+                               0};
+    REQUIRE_THROWS_AS(DatePipeline{options}, std::invalid_argument);
+  } // Weeks between is not a date
+}
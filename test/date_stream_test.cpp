@@ -0,0 +1,86 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/date_stream.h"
+#include "pascha/output_calendars.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Date stream")
+{
+  using namespace pascha;
+
+  GregorianCalculationMethod method{};
+
+  SECTION("Yields every year in order across batches")
+  {
+    Year expected{1990};
+    for (const auto& [year, date] : streamDates(method, 1990, 2030, 7)) {
+      REQUIRE(year == expected);
+      Date serial{method.calculate(year)};
+      REQUIRE(date.month == serial.month);
+      REQUIRE(date.day == serial.day);
+      ++expected;
+    }
+    REQUIRE(expected == 2031);
+  } // Yields every year in order across batches
+
+  SECTION("Empty range")
+  {
+    auto stream{streamDates(method, 2, 1)};
+    REQUIRE(stream.begin() == stream.end());
+  } // Empty range
+
+  SECTION("Composes with ranges")
+  {
+    // Western Easter on April 1st
+    auto april_fools{streamDates(method, 1900, 1000000) |
+                     std::views::filter([](const YearResult& result) {
+                       return result.date.month == 4 && result.date.day == 1;
+                     }) |
+                     std::views::transform(
+                         [](const YearResult& result) { return result.year; }) |
+                     std::views::take(3)};
+    std::vector<Year> years{};
+    for (Year year : april_fools) { years.push_back(year); }
+    REQUIRE(years == std::vector<Year>{1923, 1934, 1945});
+
+    auto before_may{streamDates(method, 2019, 2100) |
+                    std::views::take_while([](const YearResult& result) {
+                      return result.date.month < 5;
+                    })};
+    REQUIRE(std::ranges::distance(before_may) == 2100 - 2019 + 1);
+  } // Composes with ranges
+
+  SECTION("Errors are rethrown")
+  {
+    auto calendar{std::make_shared<GregorianCalculationMethod>()};
+    JulianOutputCalendar julian{calendar};
+    auto stream{streamDates(julian, -5510, -5500, 4)};
+    REQUIRE_THROWS_AS(stream.begin(), std::overflow_error);
+  } // Errors are rethrown
+} // Date stream
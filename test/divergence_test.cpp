@@ -0,0 +1,99 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/divergence.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+std::int64_t weeksBetween(Year year)
+{
+  JulianCalculationMethod julian{};
+  GregorianCalculationMethod gregorian{};
+  return (gregorianToJdn(julian.calculate(year)) -
+          gregorianToJdn(gregorian.calculate(year))) /
+         7;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Divergence analysis")
+{
+  using namespace pascha;
+
+  SECTION("Weeks between match the calculation methods")
+  {
+    constexpr Year first{-5508};
+    constexpr Year last{20'000};
+    std::vector<std::int64_t> weeks(last - first + 1);
+    std::vector<Year> coincident{};
+    DivergenceSummary summary{analyseDivergence(first, last, weeks,
+                                                &coincident)};
+
+    std::int64_t total{0};
+    std::uint64_t coincident_count{0};
+    for (Year year = first; year <= last; ++year) {
+      std::int64_t expected{weeksBetween(year)};
+      REQUIRE(weeks[year - first] == expected);
+      total += expected;
+    }
+    for (Year year : coincident) {
+      REQUIRE(weeksBetween(year) == 0);
+      ++coincident_count;
+    }
+    REQUIRE(summary.years == weeks.size());
+    REQUIRE(summary.total_weeks == total);
+    REQUIRE(summary.coincident == coincident_count);
+    REQUIRE(summary.max_weeks == weeks[summary.max_year - first]);
+  } // Weeks between match the calculation methods
+
+  SECTION("Recent coincidences")
+  {
+    std::vector<Year> coincident{};
+    analyseDivergence(2000, 2030, {}, &coincident);
+    REQUIRE(coincident == std::vector<Year>{2001, 2004, 2007, 2010, 2011,
+                                            2014, 2017, 2025, 2028});
+  } // Recent coincidences
+
+  SECTION("Distant years")
+  {
+    for (Year year : {Year{1'000'000'007}, Year{123'456'789'012'345}}) {
+      DivergenceSummary summary{analyseDivergence(year, year)};
+      REQUIRE(summary.total_weeks == weeksBetween(year));
+    }
+  } // Distant years
+
+  SECTION("Invalid input")
+  {
+    REQUIRE_THROWS_AS(analyseDivergence(2, 1), std::invalid_argument);
+    std::vector<std::int64_t> weeks(2);
+    REQUIRE_THROWS_AS(analyseDivergence(1, 3, weeks), std::invalid_argument);
+    REQUIRE_THROWS_AS(analyseDivergence(-6000, 1), std::overflow_error);
+  } // Invalid input
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/bulk_date_formatter.h"
+#include "pascha/export.h"
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Export")
+{
+  using namespace pascha;
+
+  ExportOptions options{};
+  options.calculation.target_outputs = {e_target_output::pascha,
+                                        e_target_output::ascension,
+                                        e_target_output::pentecost};
+
+  SECTION("CSV has a header and a row per year")
+  {
+    std::ostringstream out{};
+    exportRange(options, 2024, 2025, out);
+    REQUIRE(out.str() == "year,Pascha,Ascension,Pentecost\n"
+                         "2024,2024-5-5,2024-6-13,2024-6-23\n"
+                         "2025,2025-4-20,2025-5-29,2025-6-8\n");
+  } // CSV has a header and a row per year
+
+  SECTION("JSON Lines has an object per year")
+  {
+    options.format = ExportFormat::jsonLines;
+    options.date_format = DateFormat::DMY;
+    options.date_separator = ".";
+    options.calculation.target_outputs = {e_target_output::pascha};
+    std::ostringstream out{};
+    exportRange(options, 2024, 2024, out);
+    REQUIRE(out.str() == "{\"year\":2024,\"Pascha\":\"5.5.2024\"}\n");
+  } // JSON Lines has an object per year
+
+  SECTION("Dates match the calculation methods in every buffer size")
+  {
+    options.calculation.output_calendar = e_output_calendar::rev_julian;
+    options.calculation.options = {e_output_option::byzantine};
+    options.calculation.target_outputs.push_back(e_target_output::meatfare);
+
+    BulkDateFormatter formatter{options.date_format, options.date_separator};
+    std::vector<std::unique_ptr<ICalculationMethod>> methods{};
+    for (ETargetOutput target : options.calculation.target_outputs) {
+      CalculationOptions column{options.calculation};
+      column.target_outputs = {target};
+      methods.push_back(makeCalculationMethod(column));
+    }
+    std::string expected{"year,Pascha,Ascension,Pentecost,Meatfare\n"};
+    for (Year year = -100; year <= 3000; ++year) {
+      expected += std::to_string(year);
+      for (const auto& method : methods) {
+        expected += ',' + formatter.format(method->calculate(year));
+      }
+      expected += '\n';
+    }
+
+    for (std::size_t flush_bytes : {std::size_t{1}, std::size_t{1000},
+                                    kDefaultFlushBytes}) {
+      options.flush_bytes = flush_bytes;
+      std::ostringstream out{};
+      exportRange(options, -100, 3000, out);
+      REQUIRE(out.str() == expected);
+    }
+  } // Dates match the calculation methods in every buffer size
+
+  SECTION("Progress and cancellation")
+  {
+    std::uint64_t years_done{0};
+    RangeControl control{};
+    control.progress = [&](const Progress& progress) {
+      years_done = progress.years_done;
+    };
+    std::ostringstream out{};
+    exportRange(options, 1, 10000, out, control);
+    REQUIRE(years_done == 10000);
+
+    CancellationToken cancellation{};
+    cancellation.cancel();
+    control.cancellation = &cancellation;
+    REQUIRE_THROWS_AS(exportRange(options, 1, 10000, out, control),
+                      OperationCancelled);
+  } // Progress and cancellation
+
+  SECTION("Errors")
+  {
+    std::ostringstream out{};
+    REQUIRE_THROWS_AS(exportRange(options, 2, 1, out), std::invalid_argument);
+
+    options.calculation.target_outputs = {e_target_output::daysUntil};
+    REQUIRE_THROWS_AS(exportRange(options, 1, 2, out), std::invalid_argument);
+
+    options.calculation.target_outputs = {e_target_output::pascha};
+    options.date_separator = ",";
+    REQUIRE_THROWS_AS(exportRange(options, 1, 2, out), std::invalid_argument);
+
+    options.date_separator = "-";
+    REQUIRE_THROWS_AS(exportRange(options, -6000, 2, out),
+                      std::overflow_error);
+
+    std::ostringstream failed{};
+    failed.setstate(std::ios::badbit);
+    REQUIRE_THROWS_AS(exportRange(options, 1, 2, failed), std::runtime_error);
+  } // Errors
+}
@@ -0,0 +1,151 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/feasts.h"
+#include "pascha/icalendar.h"
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+std::size_t countOf(const std::string& text, const std::string& part)
+{
+  std::size_t count{0};
+  for (auto at{text.find(part)}; at != std::string::npos;
+       at = text.find(part, at + 1)) {
+    ++count;
+  }
+  return count;
+} // countOf
+
+} // anonymous namespace
+
+TEST_CASE("iCalendar")
+{
+  using namespace pascha;
+
+  ICalendarOptions options{};
+  options.timestamp = "20240101T000000Z";
+
+  SECTION("Events are placed on Gregorian dates")
+  {
+    options.calculation.target_outputs = {e_target_output::pentecost,
+                                          e_target_output::pascha};
+    std::ostringstream out{};
+    writeICalendar(options, 2024, 2024, out);
+    REQUIRE(out.str() == "BEGIN:VCALENDAR\r\n"
+                         "VERSION:2.0\r\n"
+                         "PRODID:-//pascha//pascha-lib//EN\r\n"
+                         "CALSCALE:GREGORIAN\r\n"
+                         "METHOD:PUBLISH\r\n"
+                         "BEGIN:VEVENT\r\n"
+                         "UID:2024-pascha-julian@pascha-lib\r\n"
+                         "DTSTAMP:20240101T000000Z\r\n"
+                         "DTSTART;VALUE=DATE:20240505\r\n"
+                         "SUMMARY:Pascha\r\n"
+                         "TRANSP:TRANSPARENT\r\n"
+                         "END:VEVENT\r\n"
+                         "BEGIN:VEVENT\r\n"
+                         "UID:2024-pentecost-julian@pascha-lib\r\n"
+                         "DTSTAMP:20240101T000000Z\r\n"
+                         "DTSTART;VALUE=DATE:20240623\r\n"
+                         "SUMMARY:Pentecost\r\n"
+                         "TRANSP:TRANSPARENT\r\n"
+                         "END:VEVENT\r\n"
+                         "END:VCALENDAR\r\n");
+  } // Events are placed on Gregorian dates
+
+  SECTION("Other calendars are given in the description")
+  {
+    options.calculation.target_outputs = {e_target_output::pascha};
+    options.calculation.output_calendar = e_output_calendar::julian;
+    std::ostringstream out{};
+    writeICalendar(options, 2024, 2024, out);
+    REQUIRE(out.str().find("DTSTART;VALUE=DATE:20240505\r\n"
+                           "SUMMARY:Pascha\r\n"
+                           "DESCRIPTION:Julian calendar: 2024-4-22\r\n"
+                           "TRANSP:TRANSPARENT\r\n") != std::string::npos);
+
+    options.calculation.options = {e_output_option::byzantine};
+    out.str("");
+    writeICalendar(options, 2024, 2024, out);
+    REQUIRE(out.str().find("DESCRIPTION:Julian calendar (Byzantine era): "
+                           "7532-4-22\r\n") != std::string::npos);
+  } // Other calendars are given in the description
+
+  SECTION("Every feast by default, for every year")
+  {
+    options.calculation.calculation_method = e_calculation_method::gregorian;
+    std::ostringstream out{};
+    writeICalendar(options, 1, 9999, out);
+    const std::string text{out.str()};
+    REQUIRE(countOf(text, "BEGIN:VEVENT\r\n") == 9999 * kFeasts.size());
+    REQUIRE(countOf(text, "END:VEVENT\r\n") == 9999 * kFeasts.size());
+    REQUIRE(text.find("UID:9999-ascension-gregorian@pascha-lib\r\n") !=
+            std::string::npos);
+    REQUIRE(text.ends_with("END:VEVENT\r\nEND:VCALENDAR\r\n"));
+
+    // Each start date is the Gregorian date the method gives.
+    CalculationOptions calculation{options.calculation};
+    calculation.target_outputs = {e_target_output::meatfare};
+    const auto method{makeCalculationMethod(calculation)};
+    const Date meatfare{method->calculate(1583)};
+    std::ostringstream date{};
+    date << "UID:1583-meatfare-gregorian@pascha-lib\r\n"
+         << "DTSTAMP:20240101T000000Z\r\n"
+         << "DTSTART;VALUE=DATE:1583" << (meatfare.month < 10 ? "0" : "")
+         << meatfare.month << (meatfare.day < 10 ? "0" : "") << meatfare.day
+         << "\r\n";
+    REQUIRE(text.find(date.str()) != std::string::npos);
+  } // Every feast by default, for every year
+
+  SECTION("Invalid options throw")
+  {
+    std::ostringstream out{};
+    REQUIRE_THROWS_AS(writeICalendar(options, 2025, 2024, out),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(writeICalendar(options, 0, 2024, out),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(writeICalendar(options, 2024, 10000, out),
+                      std::out_of_range);
+    options.calculation.target_outputs = {e_target_output::daysUntil};
+    REQUIRE_THROWS_AS(writeICalendar(options, 2024, 2024, out),
+                      std::invalid_argument);
+    options.calculation.target_outputs = {};
+    options.timestamp = "20240101T000000Z\r\nX-EVIL:1";
+    REQUIRE_THROWS_AS(writeICalendar(options, 2024, 2024, out),
+                      std::invalid_argument);
+    for (const char* timestamp :
+         {"2024-01-01T00:00:00Z", "20240101T000000", "20240101T000000z",
+          "2024010XT000000Z", "20241301T000000Z", "20240100T000000Z",
+          "20240101T240000Z", "20240101T006000Z", "20240101T000000Z "}) {
+      options.timestamp = timestamp;
+      REQUIRE_THROWS_AS(writeICalendar(options, 2024, 2024, out),
+                        std::invalid_argument);
+    }
+  } // Invalid options throw
+}
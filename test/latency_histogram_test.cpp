@@ -0,0 +1,84 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/latency_histogram.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+TEST_CASE("Latency histogram")
+{
+  using namespace std::chrono_literals;
+  using pascha::LatencyHistogram;
+
+  LatencyHistogram histogram{};
+
+  SECTION("An empty histogram reports zero")
+  {
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.mean() == 0ns);
+    REQUIRE(histogram.percentile(0.5) == 0ns);
+  }
+
+  SECTION("Small latencies are exact")
+  {
+    for (int i = 1; i <= 10; ++i) {
+      histogram.record(std::chrono::nanoseconds{i});
+    }
+    REQUIRE(histogram.count() == 10);
+    REQUIRE(histogram.percentile(0.5) == 5ns);
+    REQUIRE(histogram.percentile(1.0) == 10ns);
+    REQUIRE(histogram.max() == 10ns);
+  }
+
+  SECTION("Percentiles are accurate to a bucket")
+  {
+    for (int i = 1; i <= 1000; ++i) {
+      histogram.record(std::chrono::microseconds{i});
+    }
+    auto p50{histogram.percentile(0.5)};
+    auto p99{histogram.percentile(0.99)};
+    REQUIRE(p50 >= 500us);
+    REQUIRE(p50 <= 500us * 17 / 16);
+    REQUIRE(p99 >= 990us);
+    REQUIRE(p99 <= 1000us);
+    REQUIRE(histogram.mean() == 500'500ns);
+  }
+
+  SECTION("A latency can be recorded many times at once")
+  {
+    histogram.record(2ns, 3);
+    histogram.record(8ns, 1);
+    histogram.record(100ns, 0);
+    REQUIRE(histogram.count() == 4);
+    REQUIRE(histogram.percentile(0.75) == 2ns);
+    REQUIRE(histogram.mean() == 3ns);
+    REQUIRE(histogram.max() == 8ns);
+  }
+
+  SECTION("Reset discards everything")
+  {
+    histogram.record(1s);
+    histogram.reset();
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.max() == 0ns);
+  }
+}
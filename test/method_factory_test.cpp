@@ -0,0 +1,76 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/method_factory.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+
+TEST_CASE("Method factory")
+{
+  using namespace pascha;
+
+  CalculationOptions options{e_calculation_method::julian,
+                             {e_target_output::pascha},
+                             e_output_calendar::gregorian,
+                             {},
+                             2019};
+
+  SECTION("Pascha")
+  {
+    Date date{makeCalculationMethod(options)->calculate(2019)};
+    REQUIRE(date.month == 4);
+    REQUIRE(date.day == 28);
+  } // Pascha
+
+  SECTION("Output calendar")
+  {
+    options.output_calendar = e_output_calendar::julian;
+    Date date{makeCalculationMethod(options)->calculate(2019)};
+    REQUIRE(date.month == 4);
+    REQUIRE(date.day == 15);
+  } // Output calendar
+
+  SECTION("Target date and option")
+  {
+    options.target_outputs = {e_target_output::pentecost};
+    options.options = {e_output_option::byzantine};
+    Date date{makeCalculationMethod(options)->calculate(2019)};
+    REQUIRE(date.year == 2019 + 5508);
+    REQUIRE(date.month == 6);
+    REQUIRE(date.day == 16);
+  } // Target date and option
+
+  SECTION("Days until uses the undecorated method")
+  {
+    options.target_outputs = {e_target_output::daysUntil};
+    options.output_calendar = e_output_calendar::julian;
+    Date date{makeCalculationMethod(options)->calculate(2019)};
+    REQUIRE(date.month == 4);
+    REQUIRE(date.day == 28);
+  } // Days until uses the undecorated method
+
+  SECTION("Weeks between is not a date")
+  {
+    options.target_outputs = {e_target_output::weeksBetween};
+    REQUIRE_THROWS_AS(makeCalculationMethod(options), std::invalid_argument);
+  } // Weeks between is not a date
+}
@@ -0,0 +1,136 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/observer_list.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+// Counts the dates it is notified of, from any thread.
+class CountingObserver : public IObserver
+{
+ public:
+  std::atomic<int> dates{0};
+
+  void update(const Date&) override { ++dates; }
+  void update(Weeks) override {}
+  void update(Days) override {}
+  void update(std::string_view) override {}
+}; // class CountingObserver
+
+// Removes itself from the list when first notified.
+class RemovingObserver : public CountingObserver
+{
+ public:
+  explicit RemovingObserver(ObserverList& list) : m_list{&list} {}
+
+  void update(const Date& date) override
+  {
+    CountingObserver::update(date);
+    m_list->remove(*this);
+  }
+
+ private:
+  ObserverList* m_list{};
+}; // class RemovingObserver
+
+void notifyDate(const ObserverList& list)
+{
+  list.forEach([](IObserver& observer) { observer.update(Date{2024, 5, 5}); });
+}
+
+} // anonymous namespace
+
+TEST_CASE("Observer list")
+{
+  ObserverList list{};
+  CountingObserver first{};
+  CountingObserver second{};
+
+  SECTION("Observers are notified until removed")
+  {
+    list.add(first);
+    list.add(second);
+    notifyDate(list);
+    list.remove(first);
+    notifyDate(list);
+    REQUIRE(first.dates == 1);
+    REQUIRE(second.dates == 2);
+    REQUIRE(list.size() == 1);
+  }
+
+  SECTION("Removing an unknown observer changes nothing")
+  {
+    list.add(first);
+    auto before{list.snapshot()};
+    list.remove(second);
+    REQUIRE(list.snapshot() == before);
+  }
+
+  SECTION("Snapshots are unaffected by later changes")
+  {
+    list.add(first);
+    auto snapshot{list.snapshot()};
+    list.add(second);
+    REQUIRE(snapshot->size() == 1);
+    REQUIRE(list.size() == 2);
+  }
+
+  SECTION("An observer can remove itself while being notified")
+  {
+    RemovingObserver removing{list};
+    list.add(removing);
+    list.add(first);
+    notifyDate(list);
+    notifyDate(list);
+    REQUIRE(removing.dates == 1);
+    REQUIRE(first.dates == 2);
+  }
+
+  SECTION("Registration may race with notification")
+  {
+    constexpr int kNotifications{20'000};
+    list.add(first);
+
+    std::vector<std::thread> notifiers{};
+    for (int thread = 0; thread < 3; ++thread) {
+      notifiers.emplace_back([&list] {
+        for (int i = 0; i < kNotifications; ++i) { notifyDate(list); }
+      });
+    }
+    std::vector<CountingObserver> transient(50);
+    for (int round = 0; round < 20; ++round) {
+      for (auto& observer : transient) { list.add(observer); }
+      for (auto& observer : transient) { list.remove(observer); }
+    }
+    for (auto& notifier : notifiers) { notifier.join(); }
+
+    REQUIRE(first.dates == 3 * kNotifications);
+    REQUIRE(list.size() == 1);
+  }
+}
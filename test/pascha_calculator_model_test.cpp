@@ -0,0 +1,285 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/pascha_calculator_model.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace pascha;
+
+// Records everything it is notified of.
+class RecordingObserver : public IObserver
+{
+ public:
+  std::vector<Date> dates{};
+  std::vector<std::string> messages{};
+
+  void update(const Date& date) override { dates.push_back(date); }
+  void update(Weeks) override {}
+  void update(Days) override {}
+  void update(std::string_view message) override
+  {
+    messages.emplace_back(message);
+  }
+}; // class RecordingObserver
+
+// Also records the size of each batch it is notified of.
+class BatchObserver : public RecordingObserver
+{
+ public:
+  using RecordingObserver::update;
+  std::vector<Year> years{};
+  std::vector<std::size_t> batches{};
+
+  void update(std::span<const YearResult> results) override
+  {
+    batches.push_back(results.size());
+    for (const YearResult& result : results) {
+      years.push_back(result.year);
+      dates.push_back(result.date);
+    }
+  }
+}; // class BatchObserver
+
+} // anonymous namespace
+
+TEST_CASE("Pascha calculator model")
+{
+  using namespace pascha;
+
+  PaschaCalculatorModel model{};
+  RecordingObserver scalar{};
+  BatchObserver batch{};
+  model.addObserver(scalar);
+  model.addObserver(batch);
+
+  SECTION("No calculation method")
+  {
+    model.calculate(2019);
+    REQUIRE(scalar.messages.size() == 1);
+    REQUIRE(batch.messages.size() == 1);
+  } // No calculation method
+
+  model.setCalculationMethod(std::make_unique<GregorianCalculationMethod>());
+
+  SECTION("Single year")
+  {
+    model.calculate(2019);
+    REQUIRE(scalar.dates.size() == 1);
+    REQUIRE(scalar.dates.front().month == 4);
+    REQUIRE(scalar.dates.front().day == 21);
+  } // Single year
+
+  SECTION("Range is notified in batches")
+  {
+    const Year count{PaschaCalculatorModel::kNotifyBatchYears * 2 + 10};
+    model.calculateRange(1, count);
+
+    REQUIRE(batch.batches ==
+            std::vector<std::size_t>{PaschaCalculatorModel::kNotifyBatchYears,
+                                     PaschaCalculatorModel::kNotifyBatchYears,
+                                     10});
+    REQUIRE(batch.years.size() == static_cast<std::size_t>(count));
+    for (Year i = 0; i < count; ++i) { REQUIRE(batch.years[i] == i + 1); }
+
+    // Observers without batch support receive each date separately.
+    REQUIRE(scalar.dates.size() == static_cast<std::size_t>(count));
+    REQUIRE(scalar.dates.back().year == count);
+  } // Range is notified in batches
+
+  SECTION("Asynchronous calculation is marshalled through the dispatcher")
+  {
+    std::mutex mutex{};
+    std::vector<std::function<void()>> queue{};
+    model.setDispatcher([&](std::function<void()> function) {
+      std::lock_guard lock{mutex};
+      queue.push_back(std::move(function));
+    });
+
+    bool completed{false};
+    auto calculator_thread{std::this_thread::get_id()};
+    model.calculateAsync(2019);
+    model.calculateRangeAsync(2020, 2021);
+    JobHandle last{model.calculateAsync(2022, [&] {
+      REQUIRE(std::this_thread::get_id() == calculator_thread);
+      completed = true;
+    })};
+    last.wait();
+
+    // Nothing is delivered until the dispatched functions run.
+    REQUIRE(scalar.dates.empty());
+
+    std::vector<std::function<void()>> pending{};
+    {
+      std::lock_guard lock{mutex};
+      pending.swap(queue);
+    }
+    for (auto& function : pending) { function(); }
+
+    REQUIRE(completed);
+    REQUIRE(scalar.dates.size() == 4);
+    for (std::size_t i = 0; i < scalar.dates.size(); ++i) {
+      REQUIRE(scalar.dates[i].year == 2019 + static_cast<Year>(i));
+    }
+    REQUIRE(batch.batches == std::vector<std::size_t>{2});
+  } // Asynchronous calculation is marshalled through the dispatcher
+
+  SECTION("Undelivered batches are merged")
+  {
+    std::mutex mutex{};
+    std::vector<std::function<void()>> queue{};
+    model.setDispatcher([&](std::function<void()> function) {
+      std::lock_guard lock{mutex};
+      queue.push_back(std::move(function));
+    });
+
+    bool completed{false};
+    model.calculateRangeAsync(1, 100'000, [&] { completed = true; }).wait();
+
+    // One delivery, then the completion.
+    std::vector<std::function<void()>> pending{};
+    {
+      std::lock_guard lock{mutex};
+      pending.swap(queue);
+    }
+    REQUIRE(pending.size() == 2);
+    for (auto& function : pending) { function(); }
+
+    REQUIRE(completed);
+    REQUIRE(batch.batches == std::vector<std::size_t>{100'000});
+    REQUIRE(scalar.dates.size() == 100'000);
+    REQUIRE(scalar.dates.back().year == 100'000);
+  } // Undelivered batches are merged
+
+  SECTION("Asynchronous jobs use the method set when submitted")
+  {
+    model.setCalculationMethod(nullptr);
+    JobHandle job{model.calculateAsync(2019)};
+    model.setCalculationMethod(std::make_unique<GregorianCalculationMethod>());
+    job.wait();
+    REQUIRE(scalar.messages.size() == 1);
+    REQUIRE(scalar.dates.empty());
+  } // Asynchronous jobs use the method set when submitted
+
+  SECTION("Cancelled jobs notify nothing")
+  {
+    std::vector<std::function<void()>> queue{};
+    std::mutex mutex{};
+    model.setDispatcher([&](std::function<void()> function) {
+      std::lock_guard lock{mutex};
+      queue.push_back(std::move(function));
+    });
+
+    bool completed{false};
+    JobHandle job{
+        model.calculateRangeAsync(1, 100'000, [&] { completed = true; })};
+    job.wait();
+    job.cancel();
+    std::vector<std::function<void()>> pending{};
+    {
+      std::lock_guard lock{mutex};
+      pending.swap(queue);
+    }
+    for (auto& function : pending) { function(); }
+
+    REQUIRE(completed);
+    REQUIRE(batch.batches.empty());
+    REQUIRE(scalar.dates.empty());
+  } // Cancelled jobs notify nothing
+
+  SECTION("Failing jobs are still completed")
+  {
+    class FailingCalculationMethod : public ICalculationMethod
+    {
+     public:
+      Date calculate(Year) const override { throw 0; }
+    }; // class FailingCalculationMethod
+
+    model.setCalculationMethod(std::make_unique<FailingCalculationMethod>());
+    int completed{0};
+    model.calculateAsync(2019, [&] { ++completed; });
+    model.calculateRangeAsync(1, 100, [&] { ++completed; }).wait();
+
+    REQUIRE(completed == 2);
+    REQUIRE(scalar.dates.empty());
+    REQUIRE(scalar.messages.size() == 2);
+  } // Failing jobs are still completed
+
+  SECTION("Invalid range")
+  {
+    model.calculateRange(2, 1);
+    REQUIRE(batch.batches.empty());
+    REQUIRE(batch.messages.size() == 1);
+  } // Invalid range
+
+  SECTION("Calculations are counted")
+  {
+    model.calculate(2019);
+    model.daysUntil(2019);
+    model.weeksBetween(2019, std::make_unique<JulianCalculationMethod>(),
+                       std::make_unique<GregorianCalculationMethod>());
+    model.calculateRange(1, 100);
+    model.calculateAsync(2019).wait();
+    REQUIRE(model.calculationCount() == 1 + 1 + 2 + 100 + 1);
+  } // Calculations are counted
+
+  model.removeObserver(batch);
+  model.removeObserver(scalar);
+} // Pascha calculator model
+
+TEST_CASE("Days until are counted from the model's clock")
+{
+  using namespace pascha;
+
+  class DaysObserver : public RecordingObserver
+  {
+   public:
+    using RecordingObserver::update;
+    std::vector<std::int64_t> days{};
+
+    void update(Days count) override { days.push_back(count.value); }
+  }; // class DaysObserver
+
+  PaschaCalculatorModel model{
+      std::make_shared<FixedClock>(Date{2024, 4, 28})};
+  DaysObserver observer{};
+  model.addObserver(observer);
+  model.setCalculationMethod(std::make_unique<JulianCalculationMethod>());
+
+  model.daysUntil(2024);
+  model.daysUntilAsync(2025).wait();
+  REQUIRE(observer.days == std::vector<std::int64_t>{7, 357});
+  // Shared with the controller, for days until served from its own cache.
+  REQUIRE(model.clock().todayJdn() == gregorianToJdn(Date{2024, 4, 28}));
+
+  model.removeObserver(observer);
+} // Days until are counted from the model's clock
@@ -0,0 +1,95 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/method_factory.h"
+#include "pascha/paschalion_table.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Paschalion table")
+{
+  using namespace pascha;
+
+  std::vector<CalculationOptions> columns{};
+  for (ETargetOutput target :
+       {e_target_output::pascha, e_target_output::ascension,
+        e_target_output::pentecost}) {
+    columns.push_back(CalculationOptions{e_calculation_method::julian,
+                                         {target},
+                                         e_output_calendar::gregorian,
+                                         {},
+                                         0});
+  }
+
+  SECTION("Dates match the calculation methods")
+  {
+    PaschalionTable table{columns, 1900, 2100};
+    REQUIRE(table.rowCount() == 201);
+    REQUIRE(table.columnCount() == 3);
+
+    for (std::size_t column = 0; column < columns.size(); ++column) {
+      auto method{makeCalculationMethod(columns[column])};
+      for (std::uint64_t row = 0; row < table.rowCount(); ++row) {
+        Date expected{method->calculate(table.year(row))};
+        auto date{table.date(row, column)};
+        REQUIRE(date);
+        REQUIRE(date->year == expected.year);
+        REQUIRE(date->month == expected.month);
+        REQUIRE(date->day == expected.day);
+      }
+    }
+    REQUIRE(!table.date(table.rowCount(), 0));
+  } // Dates match the calculation methods
+
+  SECTION("Any row of a huge range can be looked up")
+  {
+    PaschalionTable table{columns, 1, 100'000'000};
+    REQUIRE(table.rowCount() == 100'000'000);
+    table.prefetch(50'000'000, 50'000'040);
+
+    auto method{makeCalculationMethod(columns.front())};
+    for (std::uint64_t row : {std::uint64_t{0}, std::uint64_t{50'000'000},
+                              table.rowCount() - 1, std::uint64_t{0}}) {
+      Date expected{method->calculate(table.year(row))};
+      REQUIRE(table.date(row, 0)->day == expected.day);
+    }
+  } // Any row of a huge range can be looked up
+
+  SECTION("The whole range of Year is cut short")
+  {
+    PaschalionTable table{columns, std::numeric_limits<Year>::min(),
+                          std::numeric_limits<Year>::max()};
+    REQUIRE(table.rowCount() == PaschalionTable::kMaxRows);
+    REQUIRE(table.year(0) == std::numeric_limits<Year>::min());
+    REQUIRE(table.year(table.rowCount() - 1) ==
+            std::numeric_limits<Year>::min() +
+                static_cast<Year>(PaschalionTable::kMaxRows - 1));
+  } // The whole range of Year is cut short
+
+  SECTION("Invalid range")
+  {
+    REQUIRE_THROWS_AS((PaschalionTable{columns, 2, 1}),
+                      std::invalid_argument);
+  } // Invalid range
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/pipe_io.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Fill a buffer with text which differs for every write, so that a buffer
+// reused too early shows up in what is read.
+std::size_t fill(char* data, std::size_t capacity, std::size_t round)
+{
+  const std::size_t size{round * 7919 % (capacity + 1)};
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>('a' + (round + i / 64) % 26);
+  }
+  return size;
+} // fill
+
+std::string readAll(int fd, bool slowly)
+{
+  std::string text{};
+  char data[4096];
+  for (std::size_t reads = 0;; ++reads) {
+    const std::size_t count{pascha::readSome(fd, data, sizeof(data))};
+    if (count == 0) { return text; }
+    text.append(data, count);
+    if (slowly && reads % 64 == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds{200});
+    }
+  }
+} // readAll
+
+} // anonymous namespace
+
+TEST_CASE("Pipe writer")
+{
+  using namespace pascha;
+
+  constexpr std::size_t kRounds{600};
+
+  SECTION("Everything written to a pipe is read back in order")
+  {
+    for (bool slowly : {false, true}) {
+      int fds[2];
+      REQUIRE(pipe(fds) == 0);
+      std::string read{};
+      std::thread reader{[&] { read = readAll(fds[0], slowly); }};
+
+      std::string expected{};
+      {
+        PipeWriter writer{fds[1], 1 << 16, true};
+#ifdef __linux__
+        REQUIRE(writer.splicing());
+#endif
+        for (std::size_t round = 0; round < kRounds; ++round) {
+          char* data{writer.buffer()};
+          const std::size_t size{fill(data, writer.capacity(), round)};
+          expected.append(data, size);
+          writer.write(size);
+        }
+      }
+      close(fds[1]);
+      reader.join();
+      close(fds[0]);
+      REQUIRE(read.size() == expected.size());
+      // Compared whole, as the strings are too long to show.
+      const bool same{read == expected};
+      REQUIRE(same);
+    }
+  } // Everything written to a pipe is read back in order
+
+  SECTION("Files are written with copies")
+  {
+    std::FILE* file{std::tmpfile()};
+    REQUIRE(file != nullptr);
+    const int fd{fileno(file)};
+    std::string expected{};
+    {
+      PipeWriter writer{fd, 1000, true};
+      REQUIRE_FALSE(writer.splicing());
+      REQUIRE(writer.capacity() % 1000 != 0);
+      for (std::size_t round = 0; round < 50; ++round) {
+        char* data{writer.buffer()};
+        const std::size_t size{fill(data, writer.capacity(), round)};
+        expected.append(data, size);
+        writer.write(size);
+      }
+    }
+    REQUIRE(lseek(fd, 0, SEEK_SET) == 0);
+    REQUIRE(readAll(fd, false) == expected);
+    std::fclose(file);
+  } // Files are written with copies
+
+  SECTION("Splicing can be turned off")
+  {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    PipeWriter writer{fds[1], 1 << 16, false};
+    REQUIRE_FALSE(writer.splicing());
+    close(fds[0]);
+    close(fds[1]);
+  } // Splicing can be turned off
+
+  SECTION("Splicing is off unless asked for")
+  {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    PipeWriter writer{fds[1]};
+    REQUIRE_FALSE(writer.splicing());
+    close(fds[0]);
+    close(fds[1]);
+  } // Splicing is off unless asked for
+}
+
+#endif // !_WIN32
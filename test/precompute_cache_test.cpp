@@ -0,0 +1,93 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/method_factory.h"
+#include "pascha/precompute_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <vector>
+
+TEST_CASE("Precompute cache")
+{
+  using namespace pascha;
+
+  constexpr Year kRadius{16};
+  PrecomputeCache cache{kRadius};
+
+  std::vector<CalculationOptions> variants{};
+  for (ETargetOutput target :
+       {e_target_output::pascha, e_target_output::pentecost}) {
+    for (EOutputCalendar calendar = 0; calendar < e_output_calendar::last;
+         ++calendar) {
+      variants.push_back(CalculationOptions{
+          e_calculation_method::julian, {target}, calendar, {}, 0});
+    }
+  }
+
+  SECTION("The window around the position is calculated")
+  {
+    cache.recentre(variants, 2000).wait();
+    REQUIRE(cache.size() == variants.size() * (2 * kRadius + 1));
+
+    for (const CalculationOptions& options : variants) {
+      auto method{makeCalculationMethod(options)};
+      for (Year year = 2000 - kRadius; year <= 2000 + kRadius; ++year) {
+        auto date{cache.find(packOptions(options), year)};
+        REQUIRE(date);
+        Date expected{method->calculate(year)};
+        REQUIRE(date->year == expected.year);
+        REQUIRE(date->month == expected.month);
+        REQUIRE(date->day == expected.day);
+      }
+      REQUIRE(!cache.find(packOptions(options), 2000 + kRadius + 1));
+    }
+  } // The window around the position is calculated
+
+  SECTION("Small moves do not restart the speculation")
+  {
+    JobHandle first{cache.recentre(variants, 2000)};
+    JobHandle second{cache.recentre(variants, 2000 + kRadius / 4)};
+    second.wait();
+    REQUIRE(!first.cancelled());
+    REQUIRE(cache.size() == variants.size() * (2 * kRadius + 1));
+  } // Small moves do not restart the speculation
+
+  SECTION("Distant dates are dropped")
+  {
+    cache.recentre(variants, 2000).wait();
+    cache.recentre(variants, 3000).wait();
+    REQUIRE(!cache.find(packOptions(variants.front()), 2000));
+    REQUIRE(cache.find(packOptions(variants.front()), 3000));
+  } // Distant dates are dropped
+
+  SECTION("Moves between the extremes of Year restart the speculation")
+  {
+    JobHandle first{
+        cache.recentre(variants, std::numeric_limits<Year>::max())};
+    first.wait();
+    JobHandle second{
+        cache.recentre(variants, std::numeric_limits<Year>::min())};
+    second.wait();
+    REQUIRE(first.cancelled());
+    REQUIRE(!second.cancelled());
+  } // Moves between the extremes of Year restart the speculation
+}
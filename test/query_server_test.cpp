@@ -0,0 +1,213 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/query_server.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+
+sockaddr_un addressOf(const std::filesystem::path& path)
+{
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  path.string().copy(address.sun_path, sizeof(address.sun_path) - 1);
+  return address;
+} // addressOf
+
+int connectTo(const std::filesystem::path& path)
+{
+  const int fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+  const sockaddr_un address{addressOf(path)};
+  REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                    sizeof(address)) == 0);
+  return fd;
+} // connectTo
+
+// Send the requests while reading the answers, until the server closes the
+// connection.
+std::string askServer(const std::filesystem::path& path,
+                     const std::string& requests)
+{
+  const int fd{connectTo(path)};
+  std::thread sender{[&] {
+    for (std::size_t sent = 0; sent < requests.size();) {
+      const ssize_t count{
+          ::send(fd, requests.data() + sent, requests.size() - sent, 0)};
+      if (count <= 0) { break; }
+      sent += static_cast<std::size_t>(count);
+    }
+    ::shutdown(fd, SHUT_WR);
+  }};
+  std::string answers{};
+  char data[4096];
+  for (;;) {
+    const ssize_t count{::recv(fd, data, sizeof(data), 0)};
+    if (count <= 0) { break; }
+    answers.append(data, static_cast<std::size_t>(count));
+  }
+  sender.join();
+  ::close(fd);
+  return answers;
+} // askServer
+
+void appendRecord(std::string& requests, Year year, int target)
+{
+  auto bits{static_cast<std::uint64_t>(year)};
+  for (int i = 0; i < 8; ++i, bits >>= 8) {
+    requests += static_cast<char>(bits & 0xff);
+  }
+  requests += std::string{"\0", 1} + static_cast<char>(target) + '\x01';
+  requests.append(5, '\0');
+} // appendRecord
+
+// Runs a server on another thread for as long as it lives.
+class RunningServer
+{
+ public:
+  explicit RunningServer(const pascha::QueryServerOptions& options)
+    : m_server{options}, m_thread{[this] { m_server.run(); }}
+  {
+  }
+  ~RunningServer()
+  {
+    m_server.stop();
+    m_thread.join();
+  }
+
+  const pascha::QueryServer& server() const { return m_server; }
+
+ private:
+  pascha::QueryServer m_server;
+  std::thread m_thread;
+}; // class RunningServer
+
+} // anonymous namespace
+
+TEST_CASE("Query server")
+{
+  using namespace pascha;
+
+  QueryServerOptions options{};
+  options.socket_path =
+      std::filesystem::temp_directory_path() / "pascha_query_server_test.sock";
+  options.workers = 3;
+  options.cache_first = 2000;
+  options.cache_last = 2024;
+  std::optional<RunningServer> running{std::in_place, options};
+  const QueryServer& server{running->server()};
+
+  SECTION("Text requests are answered in order")
+  {
+    const std::string answers{
+        askServer(options.socket_path, "2024,julian,pascha,gregorian,0\n"
+                                      "# comment\n"
+                                      "2025,julian,pentecost,gregorian,0\r\n"
+                                      "2025,julian,easter,gregorian,0\n"
+                                      "stats\n"
+                                      "2024,julian,pascha,julian,1")};
+    REQUIRE(answers == "2024-5-5\n"
+                       "2025-6-8\n"
+                       "error: Line 4: Unknown method, feast, calendar or "
+                       "Byzantine flag\n"
+                       "stats queries=0 p50_ns=0 p99_ns=0 max_ns=0 "
+                       "mean_ns=0\n"
+                       "7532-4-22\n");
+    REQUIRE(server.latency().count() == 3);
+    REQUIRE(server.stats().starts_with("stats queries=3 p50_ns="));
+  }
+
+  SECTION("Binary requests are answered with binary results")
+  {
+    std::string requests{kBatchMagic.data(), kBatchMagic.size()};
+    requests += std::string{"\x01\0\0\0\x10\0\0\0", 8};
+    appendRecord(requests, 2025, e_target_output::pascha);
+    appendRecord(requests, 2025, e_target_output::weeksBetween);
+    appendRecord(requests, 2024, e_target_output::pentecost);
+    const std::string answers{askServer(options.socket_path, requests)};
+    REQUIRE(answers.size() == 3 * kBatchResultSize);
+    REQUIRE(answers.substr(0, 11) ==
+            std::string{"\xe9\x07\0\0\0\0\0\0\x04\x14\0", 11});
+    REQUIRE(answers[kBatchResultSize + 10] == kBatchResultInvalid);
+    REQUIRE(answers.substr(2 * kBatchResultSize, 11) ==
+            std::string{"\xe8\x07\0\0\0\0\0\0\x06\x17\0", 11});
+  }
+
+  SECTION("Connections are answered side by side")
+  {
+    std::string requests{};
+    std::string expected{};
+    BatchEvaluator evaluator{};
+    BatchQueries queries{};
+    TextQueryParser parser{};
+    for (Year year = 1900; year < 1900 + 20000; ++year) {
+      requests += std::to_string(year) + ",gregorian,ascension,julian,0\n";
+    }
+    parser.parse(requests, queries, queries.years.max_size(), true);
+    expected.resize(queries.size() * evaluator.maxResultSize());
+    expected.resize(static_cast<std::size_t>(
+        evaluator.write(queries, expected.data()) - expected.data()));
+
+    std::vector<std::string> answers(4);
+    std::vector<std::thread> clients{};
+    for (std::string& answer : answers) {
+      clients.emplace_back(
+          [&] { answer = askServer(options.socket_path, requests); });
+    }
+    for (std::thread& client : clients) { client.join(); }
+    for (const std::string& answer : answers) {
+      const bool same{answer == expected};
+      REQUIRE(same);
+    }
+  }
+
+  SECTION("Only a socket nothing is listening on is replaced")
+  {
+    REQUIRE_THROWS_AS(QueryServer{options}, std::runtime_error);
+    running.reset();
+    REQUIRE_FALSE(std::filesystem::exists(options.socket_path));
+
+    // A socket left behind by a server which has gone is replaced.
+    const int stale{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    const sockaddr_un address{addressOf(options.socket_path)};
+    REQUIRE(::bind(stale, reinterpret_cast<const sockaddr*>(&address),
+                   sizeof(address)) == 0);
+    ::close(stale);
+    REQUIRE(std::filesystem::exists(options.socket_path));
+    running.emplace(options);
+    REQUIRE(askServer(options.socket_path, "2024,julian,pascha,julian,0\n") ==
+            "2024-4-22\n");
+  }
+}
+#endif // __linux__
@@ -0,0 +1,140 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/output_calendars.h"
+#include "pascha/range_calculation.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+TEST_CASE("Parallel range calculation")
+{
+  using namespace pascha;
+
+  auto method{std::make_shared<JulianCalculationMethod>()};
+  RevisedJulianOutputCalendar calendar{method};
+
+  SECTION("Matches the serial calculation in year order")
+  {
+    for (std::size_t threads : {1, 2, 3, 8}) {
+      WorkStealingPool pool{threads};
+      auto dates{calculateRange(calendar, -1000, 3000, pool, 97)};
+      REQUIRE(dates.size() == 4001);
+      for (Year year = -1000; year <= 3000; ++year) {
+        Date expected{calendar.calculate(year)};
+        const Date& actual{dates[year + 1000]};
+        REQUIRE(actual.year == expected.year);
+        REQUIRE(actual.month == expected.month);
+        REQUIRE(actual.day == expected.day);
+      }
+    }
+  } // Matches the serial calculation in year order
+
+  SECTION("Streams consecutive windows")
+  {
+    // Gregorian Pascha always falls in the year it is calculated for.
+    GregorianCalculationMethod gregorian{};
+    WorkStealingPool pool{2};
+    Year next{1};
+    calculateRange(
+        gregorian, 1, 100'000, pool,
+        [&next](Year first, std::span<const Date> dates) {
+          REQUIRE(first == next);
+          REQUIRE(dates.front().year == first);
+          next += static_cast<Year>(dates.size());
+        },
+        1000);
+    REQUIRE(next == 100'001);
+  } // Streams consecutive windows
+
+  SECTION("Single year range")
+  {
+    auto result{calculateRange(*method, 2019, 2019, RangeOptions{2, 10})};
+    REQUIRE(result.dates.size() == 1);
+    REQUIRE(result.dates.front().month == 4);
+    REQUIRE(result.dates.front().day == 28);
+    REQUIRE(result.workers.size() == 2);
+  } // Single year range
+
+  SECTION("Reports worker statistics")
+  {
+    auto result{calculateRange(*method, 1, 10'000, RangeOptions{4, 100})};
+    std::uint64_t tasks{0};
+    for (const auto& worker : result.workers) {
+      tasks += worker.tasks;
+      REQUIRE(worker.utilization() >= 0.0);
+      REQUIRE(worker.utilization() <= 1.0);
+    }
+    REQUIRE(tasks == 100);
+  } // Reports worker statistics
+
+  SECTION("Cancellation stops at the next window")
+  {
+    WorkStealingPool pool{2};
+    CancellationToken cancellation{};
+    RangeControl control{};
+    control.cancellation = &cancellation;
+
+    std::size_t windows{0};
+    REQUIRE_THROWS_AS(calculateRange(
+                          *method, 1, 1'000'000, pool,
+                          [&](Year, std::span<const Date>) {
+                            ++windows;
+                            cancellation.cancel();
+                          },
+                          control, 100),
+                      OperationCancelled);
+    REQUIRE(windows == 1);
+  } // Cancellation stops at the next window
+
+  SECTION("Progress is reported when finished")
+  {
+    WorkStealingPool pool{2};
+    std::vector<Progress> reports{};
+    RangeControl control{};
+    control.progress = [&reports](const Progress& progress) {
+      reports.push_back(progress);
+    };
+    control.progress_interval = std::chrono::hours{1};
+
+    calculateRange(
+        *method, 1, 10'000, pool, [](Year, std::span<const Date>) {}, control,
+        100);
+    REQUIRE(reports.size() == 1);
+    REQUIRE(reports.back().years_done == 10'000);
+    REQUIRE(reports.back().years_total == 10'000);
+    REQUIRE(reports.back().fraction() == 1.0);
+  } // Progress is reported when finished
+
+  SECTION("Invalid range")
+  {
+    REQUIRE_THROWS_AS(calculateRange(*method, 2, 1), std::invalid_argument);
+  } // Invalid range
+
+  SECTION("Errors are rethrown")
+  {
+    // Years before the start of the Byzantine era are out of range.
+    REQUIRE_THROWS_AS(calculateRange(calendar, -10'000, 0, RangeOptions{2, 64}),
+                      std::overflow_error);
+  } // Errors are rethrown
+} // Parallel range calculation
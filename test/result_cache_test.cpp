@@ -0,0 +1,210 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/cached_calculation_method.h"
+#include "pascha/calculation_methods.h"
+#include "pascha/result_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::filesystem::path tempCachePath()
+{
+  auto path{std::filesystem::temp_directory_path() /
+            "pascha-result-cache-test.cache"};
+  std::filesystem::remove(path);
+  return path;
+} // tempCachePath
+
+} // anonymous namespace
+
+TEST_CASE("Result cache")
+{
+  using namespace pascha;
+
+  auto path{tempCachePath()};
+  std::vector<Date> dates{{2019, 4, 28}, {2020, 4, 19}, {2021, 5, 2}};
+
+  SECTION("Missing file is an empty cache")
+  {
+    ResultCache cache{path};
+    REQUIRE(cache.blockCount() == 0);
+    REQUIRE_FALSE(cache.find(0, 2019));
+  } // Missing file is an empty cache
+
+  SECTION("Stored ranges are found after reopening")
+  {
+    {
+      ResultCache cache{path};
+      cache.store(1, 2019, dates);
+      REQUIRE(cache.blockCount() == 1);
+    }
+
+    ResultCache cache{path};
+    REQUIRE(cache.blockCount() == 1);
+    auto date{cache.find(1, 2020)};
+    REQUIRE(date);
+    REQUIRE(date->year == 2020);
+    REQUIRE(date->month == 4);
+    REQUIRE(date->day == 19);
+    REQUIRE_FALSE(cache.find(1, 2018));
+    REQUIRE_FALSE(cache.find(1, 2022));
+    REQUIRE_FALSE(cache.find(2, 2020));
+  } // Stored ranges are found after reopening
+
+  SECTION("Lookup picks the block starting at or before the year")
+  {
+    ResultCache cache{path};
+    for (Year first = 0; first < 64 * 256; first += 256) {
+      cache.store(1, first, dates);
+    }
+    cache.store(1, 2019, dates);
+    std::vector<Date> later{{2019, 1, 1}};
+    cache.store(1, 2019, later);
+    REQUIRE(cache.blockCount() == 66);
+
+    auto date{cache.find(1, 2019)};
+    REQUIRE(date);
+    REQUIRE(date->month == 1);
+    REQUIRE_FALSE(cache.find(1, 2020));
+    REQUIRE(cache.find(1, 256 * 10 + 2));
+    REQUIRE_FALSE(cache.find(1, 256 * 10 + 3));
+    REQUIRE_FALSE(cache.find(1, -1));
+
+    // The span between the extreme years does not fit in a Year
+    cache.store(2, std::numeric_limits<Year>::min(), dates);
+    REQUIRE(cache.find(2, std::numeric_limits<Year>::min() + 2));
+    REQUIRE_FALSE(cache.find(2, std::numeric_limits<Year>::max()));
+  } // Lookup picks the block starting at or before the year
+
+  SECTION("Torn block is discarded and overwritten")
+  {
+    {
+      ResultCache cache{path};
+      cache.store(1, 2019, dates);
+    }
+    {
+      std::ofstream file{path, std::ios::binary | std::ios::app};
+      file << "torn";
+    }
+
+    ResultCache cache{path};
+    REQUIRE(cache.blockCount() == 1);
+    cache.store(2, 2019, dates);
+    REQUIRE(cache.blockCount() == 2);
+    REQUIRE(cache.find(2, 2021));
+  } // Torn block is discarded and overwritten
+
+  SECTION("Stores through another instance are kept")
+  {
+    // Both start from a missing file
+    ResultCache first{path};
+    ResultCache second{path};
+    first.store(1, 2019, dates);
+    second.store(2, 2019, dates);
+    REQUIRE(second.blockCount() == 2);
+    first.store(3, 2019, dates);
+    REQUIRE(first.blockCount() == 3);
+    second.store(4, 2019, dates);
+    REQUIRE(second.blockCount() == 4);
+
+    ResultCache cache{path};
+    REQUIRE(cache.blockCount() == 4);
+    for (OptionKey key = 1; key <= 4; ++key) {
+      REQUIRE(cache.find(key, 2021));
+    }
+  } // Stores through another instance are kept
+
+  SECTION("Outdated header invalidates the cache")
+  {
+    {
+      ResultCache cache{path};
+      cache.store(1, 2019, dates);
+    }
+    {
+      // Overwrite the algorithm version
+      std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(12);
+      std::uint32_t version{kCacheAlgorithmVersion + 1};
+      file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    ResultCache cache{path};
+    REQUIRE(cache.blockCount() == 0);
+    cache.store(1, 2019, dates);
+    REQUIRE(cache.blockCount() == 1);
+  } // Outdated header invalidates the cache
+
+  SECTION("Cached calculation method")
+  {
+    ResultCache cache{path};
+    auto method{std::make_shared<JulianCalculationMethod>()};
+    CachedCalculationMethod cached{method, cache, 0};
+
+    Date date{cached.calculate(2019)};
+    REQUIRE(date.year == 2019);
+    REQUIRE(date.month == 4);
+    REQUIRE(date.day == 28);
+    REQUIRE(cache.blockCount() == 1);
+
+    // Neighbouring years are now served from the cache
+    Date neighbour{cached.calculate(2020)};
+    REQUIRE(neighbour.month == 4);
+    REQUIRE(neighbour.day == 19);
+    REQUIRE(cache.blockCount() == 1);
+  } // Cached calculation method
+
+  SECTION("Concurrent finds and stores")
+  {
+    ResultCache cache{path};
+    auto method{std::make_shared<JulianCalculationMethod>()};
+    CachedCalculationMethod cached{method, cache, 0};
+
+    // Each thread misses its own block, storing it while the others look up
+    std::vector<std::thread> threads{};
+    for (Year block = 0; block < 4; ++block) {
+      threads.emplace_back([&cached, block] {
+        for (Year year = 1280 + block * 256; year < 1344 + block * 256;
+             ++year) {
+          cached.calculate(year);
+        }
+      });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    REQUIRE(cache.blockCount() == 4);
+    auto date{cache.find(0, 2019)};
+    REQUIRE(date);
+    REQUIRE(date->month == 4);
+    REQUIRE(date->day == 28);
+  } // Concurrent finds and stores
+
+  std::filesystem::remove(path);
+} // Result cache
@@ -0,0 +1,157 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/statistics.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+TEST_CASE("Pascha statistics")
+{
+  using namespace pascha;
+
+  WorkStealingPool pool{2};
+  CalculationOptions options{e_calculation_method::julian,
+                             {e_target_output::pascha},
+                             e_output_calendar::julian,
+                             {},
+                             0};
+
+  SECTION("Statistics match a serial count")
+  {
+    constexpr Year first{-1000};
+    constexpr Year last{kStatisticsChunkYears * 2 + 500};
+    options.output_calendar = e_output_calendar::gregorian;
+    PaschaStatistics statistics{
+        calculateStatistics(options, first, last, pool)};
+
+    JulianCalculationMethod julian{};
+    GregorianCalculationMethod gregorian{};
+    PaschaStatistics expected{};
+    for (Year year = first; year <= last; ++year) {
+      Date date{julian.calculate(year)};
+      ++expected.by_day[date.month - 1][date.day - 1];
+      ++expected.by_month[date.month - 1];
+      CalcInt difference{gregorianToJdn(date) -
+                         gregorianToJdn(gregorian.calculate(year))};
+      if (difference == 0) { ++expected.coincident; }
+      expected.total_weeks_between += difference / 7;
+    }
+
+    REQUIRE(statistics.years == static_cast<std::uint64_t>(last - first + 1));
+    REQUIRE(statistics.compared == statistics.years);
+    REQUIRE(statistics.skipped == 0);
+    REQUIRE(statistics.by_day == expected.by_day);
+    REQUIRE(statistics.by_month == expected.by_month);
+    REQUIRE(statistics.coincident == expected.coincident);
+    REQUIRE(statistics.total_weeks_between == expected.total_weeks_between);
+  } // Statistics match a serial count
+
+  SECTION("The Julian Paschalion repeats every 532 years")
+  {
+    PaschaStatistics statistics{calculateStatistics(options, 1, 532, pool)};
+    PaschaStatistics repeated{
+        calculateStatistics(options, 1, 532 * 3, pool)};
+    for (std::size_t month = 0; month < 12; ++month) {
+      REQUIRE(repeated.by_month[month] == 3 * statistics.by_month[month]);
+    }
+    // Julian Pascha falls between March 22nd and April 25th.
+    REQUIRE(statistics.by_month[2] + statistics.by_month[3] == 532);
+    REQUIRE(statistics.by_day[2][20] == 0);
+    REQUIRE(statistics.by_day[2][21] > 0);
+    REQUIRE(statistics.by_day[3][24] > 0);
+    REQUIRE(statistics.by_day[3][25] == 0);
+  } // The Julian Paschalion repeats every 532 years
+
+  SECTION("Years which cannot be compared are skipped")
+  {
+    PaschaStatistics statistics{calculateStatistics(options, -5600, -5500,
+                                                    pool)};
+    REQUIRE(statistics.compared == 9);
+  } // Years which cannot be compared are skipped
+
+  SECTION("Results are cached per range and options")
+  {
+    StatisticsCalculator calculator{1};
+    auto first{calculator.calculate(options, 1, 1000)};
+    auto again{calculator.calculate(options, 1, 1000)};
+    REQUIRE(first == again);
+    options.output_calendar = e_output_calendar::gregorian;
+    auto other{calculator.calculate(options, 1, 1000)};
+    REQUIRE(other != first);
+    REQUIRE(calculator.cachedCount() == 2);
+  } // Results are cached per range and options
+
+  SECTION("Cached results are served during a calculation")
+  {
+    StatisticsCalculator calculator{1};
+    auto cached{calculator.calculate(options, 1, 1000)};
+    std::shared_ptr<const PaschaStatistics> during{};
+    RangeControl control{};
+    // Reports come from the calculating thread, which would otherwise hold
+    // the lock on the results.
+    control.progress = [&](const Progress&) {
+      during = calculator.calculate(options, 1, 1000);
+    };
+    calculator.calculate(options, 1001, 2000, control);
+    REQUIRE(during == cached);
+    REQUIRE(calculator.cachedCount() == 2);
+  } // Cached results are served during a calculation
+
+  SECTION("Cancellation stops a calculation over the whole range of Year")
+  {
+    CancellationToken cancellation{};
+    cancellation.cancel();
+    RangeControl control{};
+    control.cancellation = &cancellation;
+    REQUIRE_THROWS_AS(calculateStatistics(
+                          options, std::numeric_limits<Year>::min(),
+                          std::numeric_limits<Year>::max(), pool, control),
+                      OperationCancelled);
+
+    StatisticsCalculator calculator{1};
+    REQUIRE_THROWS_AS(calculator.calculate(options, 1, 1000, control),
+                      OperationCancelled);
+    REQUIRE(calculator.cachedCount() == 0);
+  } // Cancellation stops a calculation over the whole range of Year
+
+  SECTION("Progress is reported")
+  {
+    std::uint64_t done{0};
+    RangeControl control{};
+    control.progress = [&done](const Progress& progress) {
+      done = progress.years_done;
+    };
+    calculateStatistics(options, 1, kStatisticsChunkYears * 20, pool,
+                        control);
+    REQUIRE(done == static_cast<std::uint64_t>(kStatisticsChunkYears * 20));
+  } // Progress is reported
+
+  SECTION("Invalid range")
+  {
+    REQUIRE_THROWS_AS(calculateStatistics(options, 2, 1, pool),
+                      std::invalid_argument);
+  } // Invalid range
+}
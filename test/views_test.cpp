@@ -0,0 +1,88 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/calculation_methods.h"
+#include "pascha/output_calendars.h"
+#include "pascha/output_options.h"
+#include "pascha/target_dates.h"
+#include "pascha/views.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <ranges>
+
+namespace
+{
+
+using namespace pascha;
+
+void requireSameDates(auto&& view, const ICalculationMethod& method, Year first)
+{
+  Year year{first};
+  for (const Date& date : view) {
+    Date expected{method.calculate(year)};
+    REQUIRE(date.year == expected.year);
+    REQUIRE(date.month == expected.month);
+    REQUIRE(date.day == expected.day);
+    ++year;
+  }
+} // requireSameDates
+
+} // anonymous namespace
+
+TEST_CASE("Range views")
+{
+  using namespace pascha;
+
+  auto years{std::views::iota(Year{-500}, Year{2500})};
+
+  SECTION("Pascha")
+  {
+    requireSameDates(years | views::pascha(julian_computus),
+                     JulianCalculationMethod{}, -500);
+    requireSameDates(years | views::pascha(gregorian_computus),
+                     GregorianCalculationMethod{}, -500);
+  } // Pascha
+
+  SECTION("Feast in output calendar")
+  {
+    auto method{std::make_shared<JulianCalculationMethod>()};
+    auto feast{std::make_shared<Pentecost>(method)};
+    RevisedJulianOutputCalendar calendar{feast};
+
+    requireSameDates(years | views::pascha(julian_computus) | views::feast(49) |
+                         views::to_calendar(rev_julian_calendar),
+                     calendar, -500);
+  } // Feast in output calendar
+
+  SECTION("Byzantine year")
+  {
+    auto method{std::make_shared<GregorianCalculationMethod>()};
+    auto feast{std::make_shared<Meatfare>(method)};
+    auto calendar{std::make_shared<JulianOutputCalendar>(feast)};
+    ByzantineDate byzantine{calendar};
+
+    requireSameDates(years | views::pascha(gregorian_computus) |
+                         views::feast(-56) |
+                         views::to_calendar(julian_calendar) | views::byzantine,
+                     byzantine, -500);
+  } // Byzantine year
+} // Range views